@@ -0,0 +1,1028 @@
+/**
+ * @file benchmain.cpp
+ * @brief Micro-benchmarks for the greenhouse simulation subsystems.
+ *
+ * Run with `make bench`, optionally passing `BENCH_FILTER=<name>` to run only
+ * benchmarks whose name contains the filter string.
+ */
+#include "../headers/arrivals.h"
+#include "../headers/batchRunner.h"
+#include "../headers/binaryIO.h"
+#include "../headers/checkpoint.h"
+#include "../headers/demand.h"
+#include "../headers/eventEngine.h"
+#include "../headers/eventLog.h"
+#include "../headers/garden.h"
+#include "../headers/greenhouseManager.h"
+#include "../headers/inventory.h"
+#include "../headers/inventoryJournal.h"
+#include "../headers/plant.h"
+#include "../headers/plantDatabase.h"
+#include "../headers/plantSearch.h"
+#include "../headers/randomStream.h"
+#include "../headers/restockQueue.h"
+#include "../headers/runTrace.h"
+#include "../headers/simulator.h"
+#include "../headers/snapshot.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+/**
+ * @brief Milliseconds elapsed since a starting time point.
+ */
+double millisecondsSince(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+/**
+ * @brief Recursively frees a composite tree built by a benchmark.
+ */
+void destroyTree(GardenComponent* component) {
+    if (!component->isLeaf()) {
+        for (GardenComponent* child : component->getChildren()) {
+            destroyTree(child);
+        }
+    }
+    delete component;
+}
+
+/**
+ * @brief Saves and restores a one-million-plant greenhouse snapshot.
+ */
+void benchSnapshot() {
+    const std::size_t plantCount = 1000000;
+    const std::string path = "bench_snapshot.bin";
+    const auto& database = PlantDatabase::getAllPlants();
+
+    auto* root = new GardenSection();
+    GreenHouseManager greenhouse(root, "root");
+    std::vector<std::pair<std::string, PlantInfo>> species(database.begin(), database.end());
+    for (std::size_t i = 0; i < plantCount; ++i) {
+        const auto& entry = species[i % species.size()];
+        auto* plant = new Plant(entry.first, 15.0, createWaterLossStrategy(entry.second.water),
+                                createSunlightStrategy(entry.second.sunlight),
+                                createPlantState(i % 3 == 0 ? PlantLifecycle::SEEDLING : PlantLifecycle::MATURE));
+        plant->restoreCondition(0.25 + static_cast<double>(i % 50) / 100.0, static_cast<int>(i % 40),
+                                PlantLocation::GREENHOUSE);
+        greenhouse.addPlant(plant);
+    }
+    SimulationRandom rng(42);
+
+    Clock::time_point start = Clock::now();
+    const SnapshotStats saved = GreenhouseSnapshot::save(path, greenhouse, nullptr, &rng);
+    const double saveMs = millisecondsSince(start);
+
+    auto* restoredRoot = new GardenSection();
+    GreenHouseManager restored(restoredRoot, "root");
+    SimulationRandom restoredRng;
+    start = Clock::now();
+    const SnapshotStats loaded = GreenhouseSnapshot::restore(path, restored, nullptr, &restoredRng);
+    const double loadMs = millisecondsSince(start);
+
+    std::cout << "snapshot: " << saved.plants << " plants, " << saved.bytes / (1024 * 1024) << " MiB, save "
+              << saveMs << " ms, restore " << loadMs << " ms (" << loaded.sections << " sections)\n";
+
+    std::remove(path.c_str());
+    destroyTree(root);
+    destroyTree(restoredRoot);
+}
+
+/** @brief Hot supply lines hammered by the contention benchmark. */
+const char* const kHotSupplies[] = {"Basic Soil", "Basic Container", "Bouquet Container", "With love"};
+const InventoryCategory kHotCategories[] = {InventoryCategory::SOIL, InventoryCategory::CONTAINER,
+                                            InventoryCategory::CONTAINER, InventoryCategory::CARD};
+const int kHotSupplyCount = 4;
+
+/**
+ * @brief Baseline store: one mutex around a map, mirroring the original find-check-subtract.
+ */
+class LockedStock {
+  public:
+    void add(const std::string& item, int quantity) {
+        std::lock_guard<std::mutex> lock(mutex);
+        stock[item] += quantity;
+    }
+    bool use(const std::string& item, int quantity) {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = stock.find(item);
+        if (it == stock.end() || it->second < quantity) {
+            return false;
+        }
+        it->second -= quantity;
+        return true;
+    }
+
+  private:
+    std::mutex mutex;
+    std::map<std::string, int> stock;
+};
+
+/**
+ * @brief Runs @p work on @p threads threads and returns wall time in milliseconds.
+ */
+template <typename Work>
+double timeThreads(int threads, Work work) {
+    std::vector<std::thread> pool;
+    Clock::time_point start = Clock::now();
+    for (int t = 0; t < threads; ++t) {
+        pool.emplace_back(work, t);
+    }
+    for (std::thread& thread : pool) {
+        thread.join();
+    }
+    return millisecondsSince(start);
+}
+
+/**
+ * @brief Compares lock-free SKU counters with a mutex-guarded map under 1-32 threads.
+ */
+void benchInventoryContention() {
+    const int operationsPerThread = 200000;
+    const int threadCounts[] = {1, 2, 4, 8, 16, 32};
+    std::cout << "inventory contention: " << operationsPerThread << " deductions per thread over "
+              << kHotSupplyCount << " hot SKUs (" << std::thread::hardware_concurrency() << " hardware threads)\n";
+
+    for (int threads : threadCounts) {
+        const int stock = threads * operationsPerThread;
+
+        LockedStock locked;
+        for (int i = 0; i < kHotSupplyCount; ++i) {
+            locked.add(kHotSupplies[i], stock);
+        }
+        const double lockedMs = timeThreads(threads, [&locked, operationsPerThread](int t) {
+            for (int i = 0; i < operationsPerThread; ++i) {
+                locked.use(kHotSupplies[(i + t) % kHotSupplyCount], 1);
+            }
+        });
+
+        Inventory inventory(nullptr);
+        for (int i = 0; i < kHotSupplyCount; ++i) {
+            inventory.addStock(kHotCategories[i], kHotSupplies[i], stock);
+        }
+        inventory.setConcurrent(true);
+        const double byNameMs = timeThreads(threads, [&inventory, operationsPerThread](int t) {
+            for (int i = 0; i < operationsPerThread; ++i) {
+                const int hot = (i + t) % kHotSupplyCount;
+                inventory.useItem(kHotCategories[hot], kHotSupplies[hot], 1);
+            }
+        });
+
+        SkuId skus[kHotSupplyCount];
+        for (int i = 0; i < kHotSupplyCount; ++i) {
+            skus[i] = inventory.findSku(kHotCategories[i], kHotSupplies[i]);
+            inventory.addStock(skus[i], stock);
+        }
+        const double byIdMs = timeThreads(threads, [&inventory, &skus, operationsPerThread](int t) {
+            for (int i = 0; i < operationsPerThread; ++i) {
+                inventory.useItem(skus[(i + t) % kHotSupplyCount], 1);
+            }
+        });
+
+        const double operations = static_cast<double>(threads) * operationsPerThread;
+        std::cout << "  " << threads << " threads: mutex map " << operations / lockedMs / 1000.0
+                  << " Mops/s, atomic by name " << operations / byNameMs / 1000.0 << " Mops/s, atomic by id "
+                  << operations / byIdMs / 1000.0 << " Mops/s\n";
+    }
+}
+
+/**
+ * @brief Measures journaled useItem/addStock throughput for several group-commit sizes.
+ */
+void benchInventoryJournal() {
+    const std::string base = "bench_inventory_journal";
+    const std::size_t batchSizes[] = {1, 8, 64, 512, 4096};
+    std::cout << "inventory journal: mutations per second by group-commit size\n";
+    for (std::size_t batch : batchSizes) {
+        std::remove((base + ".journal").c_str());
+        std::remove((base + ".checkpoint").c_str());
+        const int mutations = static_cast<int>(batch < 64 ? 2000 * batch : 200000);
+
+        Inventory inventory(nullptr);
+        InventoryJournal journal(inventory, base, batch);
+        journal.setCheckpointInterval(0);
+        SkuId skus[kHotSupplyCount];
+        for (int i = 0; i < kHotSupplyCount; ++i) {
+            skus[i] = inventory.registerSku(kHotCategories[i], kHotSupplies[i]);
+            inventory.addStock(skus[i], mutations);
+        }
+        journal.flush();
+
+        Clock::time_point start = Clock::now();
+        for (int i = 0; i < mutations; ++i) {
+            inventory.useItem(skus[i % kHotSupplyCount], 1);
+        }
+        journal.flush();
+        const double elapsedMs = millisecondsSince(start);
+        std::cout << "  batch " << batch << ": " << mutations / elapsedMs * 1000.0 << " mutations/s ("
+                  << journal.getStats().commits << " syncs)\n";
+    }
+    std::remove((base + ".journal").c_str());
+    std::remove((base + ".checkpoint").c_str());
+}
+
+/**
+ * @brief Compares low-water-mark notifications with polling every SKU after each deduction.
+ */
+void benchRestockAlerts() {
+    const int skuCounts[] = {16, 256, 4096};
+    const int deductions = 200000;
+    const int threshold = 10;
+    std::cout << "restock alerts: " << deductions << " deductions, low-water mark " << threshold << "\n";
+    for (int skuCount : skuCounts) {
+        Inventory inventory(nullptr);
+        RestockQueue queue(static_cast<std::size_t>(skuCount));
+        inventory.setRestockQueue(&queue);
+        for (int i = 0; i < skuCount; ++i) {
+            // Both passes together drain every SKU, so the second pass crosses each mark once.
+            const SkuId sku = inventory.registerSku(InventoryCategory::SOIL, "Soil " + std::to_string(i));
+            inventory.addStock(sku, 2 * (deductions / skuCount));
+        }
+
+        long long polledLow = 0;
+        Clock::time_point start = Clock::now();
+        for (int i = 0; i < deductions; ++i) {
+            inventory.useItem(static_cast<SkuId>(i % skuCount), 1);
+            for (int sku = 0; sku < skuCount; ++sku) {
+                polledLow += inventory.getQuantity(sku) <= threshold ? 1 : 0;
+            }
+        }
+        const double pollMs = millisecondsSince(start);
+
+        for (int i = 0; i < skuCount; ++i) {
+            inventory.setLowWaterMark(i, threshold);
+        }
+        std::size_t alerts = 0;
+        RestockEvent event;
+        start = Clock::now();
+        for (int i = 0; i < deductions; ++i) {
+            inventory.useItem(static_cast<SkuId>(i % skuCount), 1);
+            while (queue.tryPop(event)) {
+                ++alerts;
+            }
+        }
+        const double alertMs = millisecondsSince(start);
+        std::cout << "  " << skuCount << " SKUs: polling " << deductions / pollMs / 1000.0 << " Mops/s, alerts "
+                  << deductions / alertMs / 1000.0 << " Mops/s (" << alerts << " events, " << polledLow
+                  << " low reads)\n";
+    }
+}
+
+/**
+ * @brief Times loading a generated 100k-row CSV plant catalog.
+ */
+void benchCatalogLoad() {
+    const std::string path = "bench_plant_catalog.csv";
+    const int rows = 100000;
+    const char* const sections[] = {"succulent", "tropical", "herb", "flowering"};
+    const char* const levels[] = {"low", "medium", "high"};
+    {
+        std::FILE* file = std::fopen(path.c_str(), "wb");
+        std::fputs("name,section,sunlight,water\n", file);
+        for (int i = 0; i < rows; ++i) {
+            std::fprintf(file, "cultivar %06d,%s,%s,%s\n", i, sections[i % 4], levels[i % 3], levels[(i / 3) % 3]);
+        }
+        std::fclose(file);
+    }
+    std::cout << "plant catalog: loading " << rows << " rows\n";
+    for (int run = 0; run < 3; ++run) {
+        Clock::time_point start = Clock::now();
+        const std::size_t loaded = PlantDatabase::loadCatalog(path);
+        std::cout << "  run " << run + 1 << ": " << loaded << " species in " << millisecondsSince(start) << " ms\n";
+    }
+
+    const int queries = 1000;
+    std::size_t scanned = 0;
+    Clock::time_point start = Clock::now();
+    for (int q = 0; q < queries; ++q) {
+        for (const auto& entry : PlantDatabase::getAllPlants()) {
+            scanned += entry.second.sunlight == SunlightPreference::HIGH && entry.second.water == WaterPreference::LOW;
+        }
+    }
+    const double scanMs = millisecondsSince(start);
+    std::size_t indexed = 0;
+    start = Clock::now();
+    for (int q = 0; q < queries; ++q) {
+        indexed += PlantDatabase::findByCare(SunlightPreference::HIGH, WaterPreference::LOW).size();
+    }
+    const double indexMs = millisecondsSince(start);
+    std::cout << "  advice: scan " << scanMs * 1000.0 / queries << " us/query, index " << indexMs * 1000.0 / queries
+              << " us/query (" << scanned / queries << " vs " << indexed / queries << " matches)\n";
+    PlantDatabase::useBuiltinCatalog();
+    std::remove(path.c_str());
+
+    // Built-in catalog: perfect-hash lookups against a std::map of the same species.
+    const BuiltinPlantCatalog builtin;
+    std::vector<std::string> names;
+    for (std::size_t i = 0; i < builtin.size(); ++i) {
+        names.push_back(builtin.record(i).name);
+    }
+    names.push_back("unlisted cultivar");
+    const auto& map = builtin.asMap();
+    const int lookups = 2000000;
+    std::size_t found = 0;
+    start = Clock::now();
+    for (int i = 0; i < lookups; ++i) {
+        found += map.find(names[static_cast<std::size_t>(i) % names.size()]) != map.end();
+    }
+    const double mapMs = millisecondsSince(start);
+    start = Clock::now();
+    for (int i = 0; i < lookups; ++i) {
+        found += builtin.find(names[static_cast<std::size_t>(i) % names.size()]) != nullptr;
+    }
+    const double hashMs = millisecondsSince(start);
+    std::cout << "  built-in lookup: map " << mapMs * 1e6 / lookups << " ns, perfect hash " << hashMs * 1e6 / lookups
+              << " ns (" << found << " hits)\n";
+}
+
+/**
+ * @brief Edit distance between two strings, the baseline a linear fuzzy scan pays per name.
+ */
+std::size_t levenshtein(const std::string& a, const std::string& b) {
+    std::vector<std::size_t> row(b.size() + 1);
+    for (std::size_t j = 0; j <= b.size(); ++j) {
+        row[j] = j;
+    }
+    for (std::size_t i = 1; i <= a.size(); ++i) {
+        std::size_t diagonal = row[0];
+        row[0] = i;
+        for (std::size_t j = 1; j <= b.size(); ++j) {
+            const std::size_t above = row[j];
+            row[j] = std::min(std::min(row[j] + 1, row[j - 1] + 1), diagonal + (a[i - 1] == b[j - 1] ? 0 : 1));
+            diagonal = above;
+        }
+    }
+    return row[b.size()];
+}
+
+/**
+ * @brief Compares trigram-index fuzzy lookup with a Levenshtein scan over a 100k-species catalog.
+ */
+void benchFuzzySearch() {
+    // Consonant-vowel(-consonant) syllables give cultivar-like names with a realistic spread of trigrams.
+    const std::string consonants = "bcdfghklmnprstvz";
+    const std::string vowels = "aeiou";
+    const std::size_t speciesCount = 100000;
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<std::size_t> pickConsonant(0, consonants.size() - 1);
+    std::uniform_int_distribution<std::size_t> pickVowel(0, vowels.size() - 1);
+    std::uniform_int_distribution<int> pickLength(2, 4);
+    std::bernoulli_distribution closed(0.3);
+    auto word = [&]() {
+        std::string text;
+        for (int s = pickLength(rng); s > 0; --s) {
+            text += consonants[pickConsonant(rng)];
+            text += vowels[pickVowel(rng)];
+            if (closed(rng)) {
+                text += consonants[pickConsonant(rng)];
+            }
+        }
+        return text;
+    };
+    std::map<std::string, PlantInfo> species;
+    while (species.size() < speciesCount) {
+        species.emplace(word() + " " + word(),
+                        PlantInfo{"tropical", SunlightPreference::MEDIUM, WaterPreference::MEDIUM, ""});
+    }
+    const RuntimePlantCatalog catalog(species);
+
+    Clock::time_point start = Clock::now();
+    const PlantNameIndex index(catalog);
+    std::cout << "fuzzy search: " << speciesCount << " species, index built in " << millisecondsSince(start)
+              << " ms\n";
+
+    // Queries drop one letter from a listed name, as a hurried customer would.
+    std::vector<std::string> queries;
+    std::vector<std::string> expected;
+    std::uniform_int_distribution<std::size_t> pickSpecies(0, catalog.size() - 1);
+    for (int q = 0; q < 1000; ++q) {
+        const std::string name = catalog.record(pickSpecies(rng)).name;
+        std::string typo = name;
+        typo.erase(typo.size() / 2, 1);
+        queries.push_back(typo);
+        expected.push_back(name);
+    }
+
+    std::size_t hits = 0;
+    start = Clock::now();
+    for (std::size_t q = 0; q < queries.size(); ++q) {
+        const std::vector<PlantMatch> matches = index.search(queries[q], 1);
+        hits += !matches.empty() && expected[q] == matches.front().plant->name;
+    }
+    const double indexUs = millisecondsSince(start) * 1000.0 / queries.size();
+
+    const std::size_t scanQueries = 20;
+    std::size_t scanHits = 0;
+    start = Clock::now();
+    for (std::size_t q = 0; q < scanQueries; ++q) {
+        std::size_t best = 0;
+        std::size_t bestDistance = static_cast<std::size_t>(-1);
+        for (std::size_t i = 0; i < catalog.size(); ++i) {
+            const std::size_t distance = levenshtein(queries[q], catalog.record(i).name);
+            if (distance < bestDistance) {
+                bestDistance = distance;
+                best = i;
+            }
+        }
+        scanHits += expected[q] == catalog.record(best).name;
+    }
+    const double scanUs = millisecondsSince(start) * 1000.0 / scanQueries;
+    std::cout << "  trigram index: " << indexUs << " us/query, top-1 " << hits << "/" << queries.size() << "\n"
+              << "  levenshtein scan: " << scanUs << " us/query, top-1 " << scanHits << "/" << scanQueries << "\n";
+}
+
+/**
+ * @brief Runs one seeded Monte Carlo batch at 1-32 worker threads and checks the results never change.
+ */
+void benchMonteCarlo() {
+    BatchConfig scenario;
+    scenario.days = 30;
+    scenario.seeded = true;
+    scenario.seed = 1000;
+    scenario.employees = 6;
+    scenario.plants = {{"basil", 40}, {"cactus", 40}, {"monstera", 40}, {"rose", 40}};
+    scenario.runs = 256;
+    const int threadCounts[] = {1, 2, 4, 8, 16, 32};
+    std::cout << "monte carlo: " << scenario.runs << " runs x " << scenario.days << " days ("
+              << std::thread::hardware_concurrency() << " hardware threads)\n";
+
+    double baselineMs = 0.0;
+    std::vector<std::vector<DaySummary>> baselineRuns;
+    for (int threads : threadCounts) {
+        scenario.threads = threads;
+        const MonteCarloResult result = MonteCarloRunner(scenario).run();
+        if (baselineRuns.empty()) {
+            baselineMs = result.wallMs;
+            baselineRuns = result.runs;
+        }
+        bool identical = result.runs.size() == baselineRuns.size();
+        for (std::size_t r = 0; identical && r < result.runs.size(); ++r) {
+            for (std::size_t d = 0; d < result.runs[r].size(); ++d) {
+                identical = identical && result.runs[r][d].customersServed == baselineRuns[r][d].customersServed &&
+                            result.runs[r][d].ordersCompleted == baselineRuns[r][d].ordersCompleted;
+            }
+        }
+        std::cout << "  " << threads << " threads: " << result.wallMs << " ms, "
+                  << scenario.runs * 1000.0 / result.wallMs << " runs/s, speedup " << baselineMs / result.wallMs
+                  << (identical ? ", results identical" : ", RESULTS DIFFER") << "\n";
+    }
+}
+
+/**
+ * @brief Classic hold model: each handled event schedules one successor, keeping the queue size fixed.
+ */
+void benchEventEngine() {
+    const std::uint64_t events = 10000000;
+    const std::size_t queueSizes[] = {16, 1024, 65536};
+    std::cout << "event engine: " << events << " events, hold model with exponential delays\n";
+    for (std::size_t queueSize : queueSizes) {
+        EventEngine engine;
+        std::mt19937 rng(11);
+        std::exponential_distribution<double> delay(1.0);
+        engine.reserve(queueSize);
+        std::uint64_t remaining = events;
+        engine.on(0, [&](const SimEvent& event) {
+            if (--remaining >= queueSize) {
+                engine.scheduleAfter(delay(rng), 0, event.payload);
+            }
+        });
+        for (std::size_t i = 0; i < queueSize; ++i) {
+            engine.schedule(delay(rng), 0, static_cast<std::uint32_t>(i));
+        }
+        const Clock::time_point start = Clock::now();
+        engine.run();
+        const double ms = millisecondsSince(start);
+        std::cout << "  " << queueSize << " pending: " << engine.processed() / ms / 1000.0 << " M events/s\n";
+    }
+}
+
+/**
+ * @brief Stream buffer that discards everything, for timing chatty simulation code.
+ */
+class DiscardBuffer : public std::streambuf {
+  protected:
+    int_type overflow(int_type c) override { return traits_type::not_eof(c); }
+    std::streamsize xsputn(const char*, std::streamsize count) override { return count; }
+};
+
+/**
+ * @brief Generates and serves a one-million-customer day drawn from a typical arrival profile.
+ */
+void benchArrivals() {
+    const double customers = 1000000.0;
+    const ArrivalProfile profile = ArrivalProfile::typicalDay(customers);
+    SimulationRandom rng(3);
+
+    Clock::time_point start = Clock::now();
+    ArrivalSampler sampler(profile, 0.0);
+    double minute = 0.0;
+    double checksum = 0.0;
+    std::size_t drawn = 0;
+    while (sampler.next(rng, minute)) {
+        checksum += minute;
+        ++drawn;
+    }
+    const double sampleMs = millisecondsSince(start);
+    start = Clock::now();
+    const long long counted = ArrivalSampler::countDay(profile, rng);
+    const double countUs = millisecondsSince(start) * 1000.0;
+    std::cout << "arrivals: typical day with " << customers << " expected customers\n"
+              << "  sampled " << drawn << " arrival times in " << sampleMs << " ms (" << drawn / sampleMs / 1000.0
+              << " M arrivals/s, mean minute " << checksum / drawn << ")\n"
+              << "  drew a day count of " << counted << " in " << countUs << " us\n";
+
+    DiscardBuffer discard;
+    for (int eventDriven = 0; eventDriven < 2; ++eventDriven) {
+        Simulation simulation(1);
+        simulation.setRandomSeed(3);
+        simulation.configurePlantSelection({{"rose", 50}, {"basil", 50}});
+        simulation.configureBusinessLevels({BusinessLevel::MEDIUM});
+        simulation.setArrivalProfile(BusinessLevel::MEDIUM, profile);
+        if (eventDriven) {
+            EventTiming timing;
+            timing.servers = 8000;
+            simulation.useEventEngine(timing);
+        }
+        std::streambuf* saved = std::cout.rdbuf(&discard);
+        start = Clock::now();
+        simulation.startSimulation();
+        const double serveMs = millisecondsSince(start);
+        std::cout.rdbuf(saved);
+        const DaySummary& day = simulation.getDailySummaries().front();
+        std::cout << "  served " << day.customersServed << " customers with the "
+                  << (eventDriven ? "event engine (8000 desks, 4 min service)" : "day loop") << " in " << serveMs
+                  << " ms (" << day.customersServed / serveMs << " k customers/s";
+        if (eventDriven) {
+            std::cout << ", mean wait " << day.meanWaitMinutes << " min, peak queue " << day.peakQueueLength;
+        }
+        std::cout << ")\n";
+    }
+}
+
+/**
+ * @brief Compares structured log records with the formatted strings they replace, then reads a
+ * one-million-customer day's log back as text.
+ */
+void benchEventLog() {
+    const std::size_t entries = 1000000;
+    std::vector<std::string> names;
+    for (std::size_t i = 1; i <= 1000; ++i) {
+        names.push_back("Morgan #" + std::to_string(i));
+    }
+
+    Clock::time_point start = Clock::now();
+    std::vector<std::string> strings;
+    for (std::size_t i = 0; i < entries; ++i) {
+        strings.push_back("Advice request logged for " + names[i % names.size()]);
+    }
+    const double stringMs = millisecondsSince(start);
+
+    EventLog ring(entries);
+    start = Clock::now();
+    for (std::size_t i = 0; i < entries; ++i) {
+        LogRecord record;
+        record.type = LogEvent::AdviceRequested;
+        record.day = 1;
+        record.subject = static_cast<std::uint32_t>(i + 1);
+        ring.append(record);
+    }
+    const double recordMs = millisecondsSince(start);
+    std::cout << "eventlog: " << entries << " advice entries\n"
+              << "  formatted strings: " << stringMs << " ms (" << entries / stringMs / 1000.0 << " M entries/s)\n"
+              << "  structured records: " << recordMs << " ms (" << entries / recordMs / 1000.0 << " M entries/s)\n";
+
+    DiscardBuffer discard;
+    Simulation simulation(1);
+    simulation.setRandomSeed(3);
+    simulation.configurePlantSelection({{"rose", 50}, {"basil", 50}});
+    simulation.configureBusinessLevels({BusinessLevel::MEDIUM});
+    simulation.setArrivalProfile(BusinessLevel::MEDIUM, ArrivalProfile::typicalDay(1000000.0));
+    simulation.setEventLogCapacity(1100000);
+    std::streambuf* saved = std::cout.rdbuf(&discard);
+    start = Clock::now();
+    simulation.startSimulation();
+    const double serveMs = millisecondsSince(start);
+    start = Clock::now();
+    const std::size_t lines = simulation.getEventLog().size();
+    const double formatMs = millisecondsSince(start);
+    std::cout.rdbuf(saved);
+    std::cout << "  served " << simulation.getDailySummaries().front().customersServed << " customers in " << serveMs
+              << " ms; formatting " << lines << " entries on read took " << formatMs << " ms\n";
+}
+
+/**
+ * @brief Records a 30-day run of busy days, then replays it with and without the event log.
+ */
+void benchReplay() {
+    const std::string path = "bench_replay.trace";
+    DiscardBuffer discard;
+    std::streambuf* saved = std::cout.rdbuf(&discard);
+    Simulation original(30);
+    original.configurePlantSelection({{"rose", 50}, {"basil", 50}});
+    original.setArrivalProfile(BusinessLevel::LOW, ArrivalProfile::typicalDay(20000.0));
+    original.setArrivalProfile(BusinessLevel::MEDIUM, ArrivalProfile::typicalDay(50000.0));
+    original.setArrivalProfile(BusinessLevel::HIGH, ArrivalProfile::typicalDay(80000.0));
+    original.recordTrace(path);
+    Clock::time_point start = Clock::now();
+    original.startSimulation();
+    const double recordMs = millisecondsSince(start);
+
+    double replayMs[2] = {0.0, 0.0};
+    for (int fastForward = 0; fastForward < 2; ++fastForward) {
+        Simulation replay;
+        replay.replayTrace(path, fastForward == 1);
+        start = Clock::now();
+        replay.startSimulation();
+        replay.getEventLog();
+        replayMs[fastForward] = millisecondsSince(start);
+    }
+    std::cout.rdbuf(saved);
+
+    long long customers = 0;
+    for (const DaySummary& day : original.getDailySummaries()) {
+        customers += day.customersServed;
+    }
+    const std::vector<char> bytes = readFileBytes(path);
+    std::remove(path.c_str());
+    std::cout << "replay: 30 days, " << customers << " customers, trace of " << bytes.size() << " bytes\n"
+              << "  recorded run: " << recordMs << " ms\n"
+              << "  replay with event log (formatted on read): " << replayMs[0] << " ms\n"
+              << "  fast-forward replay: " << replayMs[1] << " ms\n";
+}
+
+/**
+ * @brief Checkpoints a 200,000-plant greenhouse daily against snapshotting it daily, then resumes a run.
+ *
+ * Each simulated day touches every section, as maintenance does, and really
+ * changes one plant in each of five sections.
+ */
+void benchCheckpoint() {
+    const std::string path = "bench_checkpoint.bin";
+    const std::string snapshotPath = "bench_checkpoint_snapshot.bin";
+    const int sectionCount = 100;
+    const int plantsPerSection = 2000;
+    const int days = 10;
+
+    auto* root = new GardenSection();
+    GreenHouseManager greenhouse(root, "root");
+    Inventory inventory(root);
+    inventory.addStock(InventoryCategory::SOIL, "Basic Soil", 500);
+    std::vector<GardenSection*> beds;
+    for (int s = 0; s < sectionCount; ++s) {
+        beds.push_back(greenhouse.addSection("bed-" + std::to_string(s)));
+        for (int i = 0; i < plantsPerSection; ++i) {
+            auto* plant = new Plant("rose", 15.0, createWaterLossStrategy(WaterPreference::MEDIUM),
+                                    createSunlightStrategy(SunlightPreference::HIGH),
+                                    createPlantState(PlantLifecycle::MATURE));
+            plant->restoreCondition(0.5, i % 40, PlantLocation::GREENHOUSE);
+            beds.back()->add(plant);
+        }
+    }
+
+    SimulationCheckpoint writer(path);
+    CheckpointState state;
+    std::vector<DaySummary> summaries;
+    double fullMs = 0.0;
+    double checkpointMs = 0.0;
+    double snapshotMs = 0.0;
+    std::size_t snapshotBytes = 0;
+    for (int day = 1; day <= days; ++day) {
+        for (int s = 0; s < sectionCount; ++s) {
+            beds[s]->markChanged();
+        }
+        for (int s = 0; s < 5; ++s) {
+            auto* plant = dynamic_cast<Plant*>(beds[(day * 7 + s * 13) % sectionCount]->getChild(day));
+            plant->restoreCondition(0.5, plant->getAge() + 1, PlantLocation::GREENHOUSE);
+        }
+        DaySummary summary;
+        summary.dayIndex = day;
+        summaries.push_back(summary);
+        state.day = day;
+
+        Clock::time_point start = Clock::now();
+        writer.write(greenhouse, inventory, state, summaries);
+        (day == 1 ? fullMs : checkpointMs) += millisecondsSince(start);
+        start = Clock::now();
+        snapshotBytes += GreenhouseSnapshot::save(snapshotPath, greenhouse, &inventory, &state.rng).bytes;
+        snapshotMs += millisecondsSince(start);
+    }
+    const CheckpointStats stats = writer.getStats();
+
+    auto* restoredRoot = new GardenSection();
+    GreenHouseManager restored(restoredRoot, "root");
+    Inventory restoredInventory(restoredRoot);
+    Clock::time_point start = Clock::now();
+    SimulationCheckpoint::restore(path, restored, restoredInventory);
+    const double restoreMs = millisecondsSince(start);
+
+    std::cout << "checkpoint: " << sectionCount * plantsPerSection << " plants in " << sectionCount
+              << " sections, " << days << " daily checkpoints\n"
+              << "  incremental: " << stats.fullFrames << " full + " << stats.deltaFrames << " delta frames, "
+              << stats.bytes / 1024 << " KiB; full frame " << fullMs << " ms, deltas " << checkpointMs / (days - 1)
+              << " ms each (" << stats.sectionsWritten << " sections written, " << stats.sectionsSkipped
+              << " skipped; last delta " << stats.lastFrameBytes << " bytes)\n"
+              << "  full snapshot each day: " << snapshotBytes / 1024 << " KiB, " << snapshotMs / days << " ms each\n"
+              << "  restore of full frame + deltas: " << restoreMs << " ms\n";
+    std::remove(path.c_str());
+    std::remove(snapshotPath.c_str());
+    destroyTree(root);
+    destroyTree(restoredRoot);
+
+    DiscardBuffer discard;
+    std::streambuf* saved = std::cout.rdbuf(&discard);
+    double runMs[2] = {0.0, 0.0};
+    for (int checkpointed = 0; checkpointed < 2; ++checkpointed) {
+        Simulation simulation(30);
+        simulation.setRandomSeed(7);
+        simulation.configurePlantSelection({{"rose", 500}, {"basil", 500}});
+        if (checkpointed == 1) {
+            simulation.checkpointEvery(path);
+        }
+        start = Clock::now();
+        simulation.startSimulation();
+        runMs[checkpointed] = millisecondsSince(start);
+    }
+    Simulation resumed(30);
+    resumed.setRandomSeed(7);
+    resumed.configurePlantSelection({{"rose", 500}, {"basil", 500}});
+    start = Clock::now();
+    const int resumedDay = resumed.resumeFromCheckpoint(path);
+    const double resumeMs = millisecondsSince(start);
+    std::cout.rdbuf(saved);
+    std::remove(path.c_str());
+    std::cout << "  30-day simulation: " << runMs[0] << " ms plain, " << runMs[1]
+              << " ms checkpointing daily (synced); resume at day " << resumedDay << " in " << resumeMs << " ms\n";
+}
+
+/**
+ * @brief Runs the same busy 30-day scenario with and without phase profiling and reports the overhead.
+ *
+ * Runs alternate and the fastest of each kind is compared, so machine noise
+ * does not masquerade as profiling cost.
+ */
+void benchPhaseProfile() {
+    const int repeats = 7;
+    DiscardBuffer discard;
+    std::streambuf* saved = std::cout.rdbuf(&discard);
+    double bestMs[2] = {0.0, 0.0};
+    DaySummary totals;
+    for (int repeat = 0; repeat < repeats; ++repeat) {
+        for (int profiled = 0; profiled < 2; ++profiled) {
+            Simulation simulation(30);
+            simulation.setRandomSeed(11);
+            simulation.configurePlantSelection({{"rose", 2000}, {"basil", 2000}});
+            simulation.setArrivalProfile(BusinessLevel::LOW, ArrivalProfile::typicalDay(2000.0));
+            simulation.setArrivalProfile(BusinessLevel::MEDIUM, ArrivalProfile::typicalDay(5000.0));
+            simulation.setArrivalProfile(BusinessLevel::HIGH, ArrivalProfile::typicalDay(8000.0));
+            simulation.profilePhases(profiled == 1);
+            const Clock::time_point start = Clock::now();
+            simulation.startSimulation();
+            const double ms = millisecondsSince(start);
+            if (repeat == 0 || ms < bestMs[profiled]) {
+                bestMs[profiled] = ms;
+            }
+            if (profiled == 1 && repeat == 0) {
+                for (const DaySummary& day : simulation.getDailySummaries()) {
+                    for (int i = 0; i < kDayPhaseCount; ++i) {
+                        totals.phases[i].elapsedMs += day.phases[i].elapsedMs;
+                        totals.phases[i].counters.plantsVisited += day.phases[i].counters.plantsVisited;
+                        totals.phases[i].counters.allocations += day.phases[i].counters.allocations;
+                        totals.phases[i].counters.commandsExecuted += day.phases[i].counters.commandsExecuted;
+                    }
+                }
+            }
+        }
+    }
+    std::cout.rdbuf(saved);
+
+    std::cout << "phases: 30 busy days, 4000 plants, best of " << repeats << "\n"
+              << "  unprofiled " << bestMs[0] << " ms, profiled " << bestMs[1] << " ms ("
+              << (bestMs[1] / bestMs[0] - 1.0) * 100.0 << "% overhead)\n";
+    for (int i = 0; i < kDayPhaseCount; ++i) {
+        const PhaseStats& phase = totals.phases[i];
+        std::cout << "  " << dayPhaseName(static_cast<DayPhase>(i)) << ": " << phase.elapsedMs << " ms, "
+                  << phase.counters.plantsVisited << " plants, " << phase.counters.allocations << " allocations, "
+                  << phase.counters.commandsExecuted << " commands\n";
+    }
+}
+
+/**
+ * @brief Draws weighted species the way customers used to and through an alias table.
+ *
+ * The old path copied every selected name into a fresh vector per customer
+ * and drew uniformly; std::discrete_distribution draws by binary search over
+ * cumulative weights.
+ */
+void benchAliasSampling() {
+    const int draws = 1000000;
+    for (int species : {20, 10000}) {
+        std::map<std::string, int> selection;
+        std::vector<double> weights;
+        for (int i = 0; i < species; ++i) {
+            selection["species-" + std::to_string(i)] = 2;
+            weights.push_back(1.0 + (i % 7));
+        }
+        SimulationRandom rng(5);
+        std::size_t checksum = 0;
+        // The rebuild copies every name, so it gets proportionally fewer draws.
+        const int rebuiltDraws = draws / (species / 20);
+        PhaseStats rebuilt;
+        {
+            PhaseTimer timer(&rebuilt);
+            for (int i = 0; i < rebuiltDraws; ++i) {
+                std::vector<std::string> names;
+                names.reserve(selection.size());
+                for (const auto& entry : selection) {
+                    names.push_back(entry.first);
+                }
+                std::uniform_int_distribution<int> pick(0, static_cast<int>(names.size()) - 1);
+                checksum += names[pick(rng)].size();
+            }
+        }
+        PhaseStats discrete;
+        {
+            std::discrete_distribution<int> pick(weights.begin(), weights.end());
+            PhaseTimer timer(&discrete);
+            for (int i = 0; i < draws; ++i) {
+                checksum += pick(rng);
+            }
+        }
+        PhaseStats alias;
+        {
+            const AliasTable table(weights);
+            PhaseTimer timer(&alias);
+            for (int i = 0; i < draws; ++i) {
+                checksum += table.sample(rng);
+            }
+        }
+        std::cout << "alias: " << species << " species, " << draws << " draws (checksum " << checksum % 1000 << ")\n"
+                  << "  rebuild names + uniform: " << rebuilt.elapsedMs * 1e6 / rebuiltDraws << " ns/draw, "
+                  << rebuilt.counters.allocations / rebuiltDraws << " allocations/draw\n"
+                  << "  std::discrete_distribution: " << discrete.elapsedMs * 1e6 / draws << " ns/draw, "
+                  << discrete.counters.allocations << " allocations in total\n"
+                  << "  alias table: " << alias.elapsedMs * 1e6 / draws << " ns/draw, " << alias.counters.allocations
+                  << " allocations in total\n";
+    }
+}
+
+/**
+ * @brief Times raw draws, uniform doubles, and reseeding for one generator type.
+ */
+template <typename Generator> void benchGenerator(const char* name) {
+    const int draws = 50000000;
+    const int seeds = 100000;
+    Generator rng(1);
+    std::uint64_t checksum = 0;
+    Clock::time_point start = Clock::now();
+    for (int i = 0; i < draws; ++i) {
+        checksum += randomBits32(rng);
+    }
+    const double bitsMs = millisecondsSince(start);
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+    double sum = 0.0;
+    start = Clock::now();
+    for (int i = 0; i < draws; ++i) {
+        sum += unit(rng);
+    }
+    const double unitMs = millisecondsSince(start);
+    start = Clock::now();
+    for (int i = 0; i < seeds; ++i) {
+        rng.seed(static_cast<typename Generator::result_type>(i));
+        checksum += rng();
+    }
+    const double seedMs = millisecondsSince(start);
+    std::cout << "  " << name << ": " << sizeof(Generator) << " bytes of state, " << draws / bitsMs / 1000.0
+              << " M 32-bit draws/s, " << draws / unitMs / 1000.0 << " M doubles/s, "
+              << seedMs * 1000.0 / seeds << " us per reseed (checksum " << (checksum ^ static_cast<std::uint64_t>(sum))
+              << ")\n";
+}
+
+/**
+ * @brief Compares the Mersenne Twister with xoshiro256** and times stream setup for a Monte Carlo batch.
+ */
+void benchRandomGenerators() {
+    std::cout << "random generators:\n";
+    benchGenerator<std::mt19937>("mt19937");
+    benchGenerator<Xoshiro256StarStar>("xoshiro256**");
+    const std::size_t runs = 10000;
+    Clock::time_point start = Clock::now();
+    const std::vector<SimulationRandom> streams = randomStreams(1, 0, runs);
+    const double streamMs = millisecondsSince(start);
+    std::cout << "  " << runs << " independent streams in " << streamMs << " ms ("
+              << streamMs * 1000.0 / runs << " us per stream)\n";
+}
+
+/**
+ * @brief Builds a scenario file that varies with @p index, using every section type.
+ */
+std::string scenarioText(int index) {
+    const char* const levels[] = {"low", "medium", "high"};
+    std::ostringstream text;
+    text << "# generated scenario " << index << "\n"
+         << "days = 7\nseed = " << index << "\nschedule = " << levels[index % 3] << "," << levels[(index + 1) % 3]
+         << "\n\n[employees]\ncashiers = " << 1 + index % 2 << "\nmanagers = 1\ncaretakers = " << 2 + index % 4
+         << "\n\n[plants]\nrose = " << 4 + index % 9 << "\nbasil = " << 3 + index % 5 << "\nsunflower = 2\n"
+         << "\n[popularity]\nrose = " << 1 + index % 3 << "\n"
+         << "\n[arrivals]\nlow = typical " << 5 + index % 10 << "\nhigh = uniform 2 9 17\n"
+         << "\n[sections]\nGlasshouse = root\nflowering = Glasshouse\n";
+    return text.str();
+}
+
+/**
+ * @brief Parses scenario text in memory, then sweeps scenario files through the batch runner.
+ */
+void benchScenarioSweep() {
+    const int parsed = 20000;
+    std::vector<std::string> texts;
+    for (int i = 0; i < parsed; ++i) {
+        texts.push_back(scenarioText(i));
+    }
+    Clock::time_point start = Clock::now();
+    long long checksum = 0;
+    for (const std::string& text : texts) {
+        std::istringstream in(text);
+        BatchConfig config;
+        config.load(in, "scenario");
+        checksum += config.employees + static_cast<long long>(config.plants.size());
+    }
+    const double parseMs = millisecondsSince(start);
+
+    const int files = 1000;
+    std::vector<std::string> paths;
+    for (int i = 0; i < files; ++i) {
+        paths.push_back("bench_scenario_" + std::to_string(i) + ".ini");
+        std::ofstream(paths.back()) << texts[i];
+    }
+    BatchConfig base;
+    base.threads = 1;
+    const SweepResult sweep = ScenarioSweep(base, paths).run();
+    double sweepParseMs = 0.0;
+    double runMs = 0.0;
+    for (const SweepEntry& entry : sweep.scenarios) {
+        sweepParseMs += entry.parseMs;
+        runMs += entry.result.runMs;
+    }
+    for (const std::string& path : paths) {
+        std::remove(path.c_str());
+    }
+    std::cout << "scenarios: " << parsed << " parsed from memory in " << parseMs << " ms ("
+              << parseMs * 1000.0 / parsed << " us each, checksum " << checksum << ")\n"
+              << "  swept " << files << " 7-day scenario files on 1 thread in " << sweep.wallMs << " ms ("
+              << files / (sweep.wallMs / 60000.0) << " scenarios/min, " << sweep.failed << " failed)\n"
+              << "  per file: " << sweepParseMs * 1000.0 / files << " us reading and parsing, "
+              << runMs * 1000.0 / files << " us simulating\n";
+}
+
+/** @brief Named benchmark entry. */
+struct Benchmark {
+    const char* name;
+    void (*run)();
+};
+
+const Benchmark kBenchmarks[] = {
+    {"snapshot", benchSnapshot},
+    {"inventory", benchInventoryContention},
+    {"journal", benchInventoryJournal},
+    {"restock", benchRestockAlerts},
+    {"catalog", benchCatalogLoad},
+    {"fuzzy", benchFuzzySearch},
+    {"montecarlo", benchMonteCarlo},
+    {"events", benchEventEngine},
+    {"arrivals", benchArrivals},
+    {"eventlog", benchEventLog},
+    {"replay", benchReplay},
+    {"checkpoint", benchCheckpoint},
+    {"phases", benchPhaseProfile},
+    {"alias", benchAliasSampling},
+    {"rng", benchRandomGenerators},
+    {"scenarios", benchScenarioSweep},
+};
+
+} // namespace
+
+/**
+ * @brief Runs every benchmark whose name contains the optional filter argument.
+ */
+int main(int argc, char** argv) {
+    const std::string filter = argc > 1 ? argv[1] : "";
+    for (const Benchmark& benchmark : kBenchmarks) {
+        if (filter.empty() || std::string(benchmark.name).find(filter) != std::string::npos) {
+            benchmark.run();
+        }
+    }
+    return 0;
+}
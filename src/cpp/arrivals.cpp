@@ -0,0 +1,110 @@
+/**
+ * @file arrivals.cpp
+ * @brief Implements arrival-rate profiles and the piecewise Poisson arrival sampler.
+ */
+#include "../headers/arrivals.h"
+
+#include <stdexcept>
+
+namespace {
+
+constexpr double kMinutesPerHour = 60.0;
+
+/** Relative customer weight of each opening hour, 09:00-16:59, of a typical day. */
+constexpr double kTypicalShape[] = {0.6, 1.0, 1.4, 1.1, 1.2, 1.5, 1.3, 0.9};
+constexpr int kTypicalOpenHour = 9;
+
+} // namespace
+
+// -------------------- ArrivalProfile --------------------
+double ArrivalProfile::expectedCustomers() const {
+    double total = 0.0;
+    for (double rate : customersPerHour) {
+        total += rate;
+    }
+    return total;
+}
+
+ArrivalProfile& ArrivalProfile::scale(double factor) {
+    if (factor < 0.0) {
+        throw std::invalid_argument("Arrival profile scale cannot be negative");
+    }
+    for (double& rate : customersPerHour) {
+        rate *= factor;
+    }
+    return *this;
+}
+
+ArrivalProfile ArrivalProfile::uniform(double rate, int openHour, int closeHour) {
+    if (openHour < 0 || closeHour > kHours || openHour >= closeHour) {
+        throw std::invalid_argument("Opening hours must satisfy 0 <= open < close <= 24");
+    }
+    if (rate < 0.0) {
+        throw std::invalid_argument("Arrival rate cannot be negative");
+    }
+    ArrivalProfile profile;
+    for (int hour = openHour; hour < closeHour; ++hour) {
+        profile.customersPerHour[hour] = rate;
+    }
+    return profile;
+}
+
+/**
+ * @brief Spreads the expected customers over opening hours in proportion to the typical shape.
+ */
+ArrivalProfile ArrivalProfile::typicalDay(double expected) {
+    if (expected < 0.0) {
+        throw std::invalid_argument("Expected customers cannot be negative");
+    }
+    double weight = 0.0;
+    for (double share : kTypicalShape) {
+        weight += share;
+    }
+    ArrivalProfile profile;
+    int hour = kTypicalOpenHour;
+    for (double share : kTypicalShape) {
+        profile.customersPerHour[hour++] = expected * share / weight;
+    }
+    return profile;
+}
+
+// -------------------- ArrivalSampler --------------------
+ArrivalSampler::ArrivalSampler(const ArrivalProfile& rates, double dayStartMinute)
+    : profile(rates), dayStart(dayStartMinute), current(dayStartMinute) {}
+
+/**
+ * @brief Adds exponential gaps within the current hour; a gap crossing the hour's end restarts
+ * at the next hour, which is exact because the process is memoryless.
+ */
+bool ArrivalSampler::next(SimulationRandom& rng, double& minute) {
+    while (hour < ArrivalProfile::kHours) {
+        const double rate = profile.customersPerHour[hour];
+        const double hourEnd = dayStart + (hour + 1) * kMinutesPerHour;
+        if (rate > 0.0) {
+            std::exponential_distribution<double> gap(rate / kMinutesPerHour);
+            const double candidate = current + gap(rng);
+            if (candidate < hourEnd) {
+                current = candidate;
+                minute = candidate;
+                return true;
+            }
+        }
+        ++hour;
+        current = hourEnd;
+    }
+    return false;
+}
+
+/**
+ * @brief Sums one Poisson draw per hour.
+ */
+long long ArrivalSampler::countDay(const ArrivalProfile& profile, SimulationRandom& rng) {
+    long long total = 0;
+    for (double rate : profile.customersPerHour) {
+        if (rate > 0.0) {
+            std::poisson_distribution<long long> count(rate);
+            total += count(rng);
+        }
+    }
+    return total;
+}
@@ -0,0 +1,1228 @@
+/**
+ * @file batchRunner.cpp
+ * @brief Implements configuration parsing, unattended runs, and reports for `bin/batch`.
+ */
+#include "../headers/batchRunner.h"
+
+#include "../headers/binaryIO.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <chrono>
+#include <cmath>
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+/**
+ * @brief Strips surrounding spaces and tabs.
+ */
+std::string trimmed(const std::string& text) {
+    const std::size_t begin = text.find_first_not_of(" \t\r");
+    if (begin == std::string::npos) {
+        return {};
+    }
+    const std::size_t end = text.find_last_not_of(" \t\r");
+    return text.substr(begin, end - begin + 1);
+}
+
+/**
+ * @brief Splits on a separator, trimming every piece and dropping empty ones.
+ */
+std::vector<std::string> splitList(const std::string& text, char separator) {
+    std::vector<std::string> pieces;
+    std::stringstream stream(text);
+    std::string piece;
+    while (std::getline(stream, piece, separator)) {
+        piece = trimmed(piece);
+        if (!piece.empty()) {
+            pieces.push_back(piece);
+        }
+    }
+    return pieces;
+}
+
+/**
+ * @brief Parses a whole decimal integer.
+ */
+long parseInteger(const std::string& key, const std::string& value) {
+    std::size_t used = 0;
+    long parsed = 0;
+    try {
+        parsed = std::stol(value, &used);
+    } catch (const std::exception&) {
+        used = 0;
+    }
+    if (used == 0 || used != value.size()) {
+        throw std::invalid_argument("Setting '" + key + "' expects an integer, got '" + value + "'");
+    }
+    return parsed;
+}
+
+/**
+ * @brief Parses a decimal integer that must fit in 64 unsigned bits.
+ */
+std::uint64_t parseUnsigned64(const std::string& key, const std::string& value) {
+    if (value.empty() || !std::isdigit(static_cast<unsigned char>(value[0]))) {
+        throw std::invalid_argument("Setting '" + key + "' expects a non-negative integer, got '" + value + "'");
+    }
+    std::size_t used = 0;
+    unsigned long long parsed = 0;
+    try {
+        parsed = std::stoull(value, &used);
+    } catch (const std::out_of_range&) {
+        throw std::invalid_argument("Setting '" + key + "' does not fit in 64 bits: '" + value + "'");
+    } catch (const std::exception&) {
+        used = 0;
+    }
+    if (used == 0 || used != value.size()) {
+        throw std::invalid_argument("Setting '" + key + "' expects a non-negative integer, got '" + value + "'");
+    }
+    return static_cast<std::uint64_t>(parsed);
+}
+
+/**
+ * @brief Parses a non-negative finite decimal weight.
+ */
+double parseWeight(const std::string& key, const std::string& value) {
+    std::size_t used = 0;
+    double parsed = -1.0;
+    try {
+        parsed = std::stod(value, &used);
+    } catch (const std::exception&) {
+        used = 0;
+    }
+    if (used == 0 || used != value.size() || !(parsed >= 0.0) || std::isinf(parsed)) {
+        throw std::invalid_argument("Setting '" + key + "' expects non-negative weights, got '" + value + "'");
+    }
+    return parsed;
+}
+
+/**
+ * @brief Parses a comma-separated weight list.
+ */
+std::vector<double> parseWeights(const std::string& key, const std::string& value) {
+    std::vector<double> weights;
+    for (const std::string& entry : splitList(value, ',')) {
+        weights.push_back(parseWeight(key, entry));
+    }
+    return weights;
+}
+
+/**
+ * @brief Reads a boolean setting; anything but true, 1, or yes is false.
+ */
+bool parseFlag(const std::string& value) {
+    return value == "true" || value == "1" || value == "yes";
+}
+
+/**
+ * @brief Parses a business level name.
+ */
+BusinessLevel parseLevel(const std::string& value) {
+    if (value == "low") {
+        return BusinessLevel::LOW;
+    }
+    if (value == "medium") {
+        return BusinessLevel::MEDIUM;
+    }
+    if (value == "high") {
+        return BusinessLevel::HIGH;
+    }
+    throw std::invalid_argument("Unknown business level '" + value + "'");
+}
+
+/**
+ * @brief Parses `typical N`, `uniform R [open close]`, or 24 comma-separated hourly rates.
+ */
+ArrivalProfile parseArrivalProfile(const std::string& key, const std::string& value) {
+    std::vector<std::string> words = splitList(value, ' ');
+    try {
+        if (!words.empty() && words[0] == "typical" && words.size() == 2) {
+            return ArrivalProfile::typicalDay(parseWeight(key, words[1]));
+        }
+        if (!words.empty() && words[0] == "uniform" && (words.size() == 2 || words.size() == 4)) {
+            const double rate = parseWeight(key, words[1]);
+            if (words.size() == 2) {
+                return ArrivalProfile::uniform(rate);
+            }
+            return ArrivalProfile::uniform(rate, static_cast<int>(parseInteger(key, words[2])),
+                                           static_cast<int>(parseInteger(key, words[3])));
+        }
+    } catch (const std::invalid_argument& error) {
+        throw std::invalid_argument("Setting '" + key + "': " + error.what());
+    }
+    const std::vector<double> rates = parseWeights(key, value);
+    if (rates.size() != ArrivalProfile::kHours) {
+        throw std::invalid_argument("Setting '" + key + "' expects 'typical N', 'uniform R [open close]', or " +
+                                    std::to_string(ArrivalProfile::kHours) + " hourly rates");
+    }
+    ArrivalProfile profile;
+    std::copy(rates.begin(), rates.end(), profile.customersPerHour);
+    return profile;
+}
+
+/**
+ * @brief Whether a scenario file may use a [section] header.
+ */
+bool knownSection(const std::string& section) {
+    for (const char* name : {"scenario", "plants", "popularity", "employees", "arrivals", "sections"}) {
+        if (section == name) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Lowercase name of a business level.
+ */
+const char* levelName(BusinessLevel level) {
+    switch (level) {
+        case BusinessLevel::LOW:
+            return "low";
+        case BusinessLevel::MEDIUM:
+            return "medium";
+        case BusinessLevel::HIGH:
+            return "high";
+    }
+    return "unknown";
+}
+
+/**
+ * @brief Writes a JSON string literal.
+ */
+void writeJsonString(std::ostream& out, const std::string& text) {
+    out << '"';
+    for (char c : text) {
+        switch (c) {
+            case '"':
+                out << "\\\"";
+                break;
+            case '\\':
+                out << "\\\\";
+                break;
+            case '\n':
+                out << "\\n";
+                break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    const char* const hex = "0123456789abcdef";
+                    out << "\\u00" << hex[(c >> 4) & 0xf] << hex[c & 0xf];
+                } else {
+                    out << c;
+                }
+        }
+    }
+    out << '"';
+}
+
+/**
+ * @brief Writes a CSV field, quoting it when it holds a comma, quote, or line break.
+ */
+void writeCsvField(std::ostream& out, const std::string& text) {
+    if (text.find_first_of(",\"\r\n") == std::string::npos) {
+        out << text;
+        return;
+    }
+    out << '"';
+    for (char c : text) {
+        out << (c == '"' ? "\"\"" : std::string(1, c));
+    }
+    out << '"';
+}
+
+/**
+ * @brief Adds the counters of one day to a running total.
+ */
+void accumulate(DaySummary& totals, const DaySummary& day) {
+    totals.customersServed += day.customersServed;
+    totals.ordersCompleted += day.ordersCompleted;
+    totals.queriesAnswered += day.queriesAnswered;
+    totals.maintenanceCommands += day.maintenanceCommands;
+    totals.suppliesConsumed += day.suppliesConsumed;
+    totals.supplyShortages += day.supplyShortages;
+    totals.restocksScheduled += day.restocksScheduled;
+    totals.restocksDelivered += day.restocksDelivered;
+    for (int i = 0; i < kDayPhaseCount; ++i) {
+        PhaseStats& total = totals.phases[i];
+        total.elapsedMs += day.phases[i].elapsedMs;
+        total.counters.plantsVisited += day.phases[i].counters.plantsVisited;
+        total.counters.allocations += day.phases[i].counters.allocations;
+        total.counters.commandsExecuted += day.phases[i].counters.commandsExecuted;
+    }
+}
+
+/**
+ * @brief Milliseconds elapsed since a starting time point.
+ */
+double millisecondsSince(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+/**
+ * @brief Applies the scenario settings of a configuration to a simulation.
+ */
+void configureSimulation(Simulation& simulation, const BatchConfig& config) {
+    if (config.cashiers == 1 && config.managers == 1) {
+        simulation.configureEmployees(config.employees);
+    } else {
+        simulation.configureStaff(config.cashiers, config.managers, config.employees - config.cashiers - config.managers);
+    }
+    simulation.configureSectionLayout(config.sections);
+    for (const auto& entry : config.arrivals) {
+        simulation.setArrivalProfile(entry.first, entry.second);
+    }
+    if (!config.plants.empty()) {
+        simulation.configurePlantSelection(config.plants);
+    }
+    if (!config.schedule.empty()) {
+        simulation.configureBusinessLevels(config.schedule);
+    }
+    if (config.eventDriven) {
+        simulation.useEventEngine(config.timing);
+    }
+    simulation.profilePhases(config.profilePhases);
+    simulation.configureDemand(config.demand);
+}
+
+/**
+ * @brief Writes the phases of a day as a JSON object keyed by phase name.
+ */
+void writeJsonPhases(std::ostream& out, const DaySummary& day) {
+    out << "{";
+    for (int i = 0; i < kDayPhaseCount; ++i) {
+        const PhaseStats& phase = day.phases[i];
+        out << (i == 0 ? "\"" : ", \"") << dayPhaseName(static_cast<DayPhase>(i)) << "\": {\"ms\": "
+            << phase.elapsedMs << ", \"plantsVisited\": " << phase.counters.plantsVisited << ", \"allocations\": ";
+        // Without the allocation hook the count is unknown, not zero.
+        if (allocationCountingLinked) {
+            out << phase.counters.allocations;
+        } else {
+            out << "null";
+        }
+        out << ", \"commandsExecuted\": " << phase.counters.commandsExecuted << "}";
+    }
+    out << "}";
+}
+
+/**
+ * @brief Writes the scenario fields shared by every JSON report, without braces.
+ */
+void writeJsonScenario(std::ostream& out, const BatchConfig& config) {
+    out << "\"days\": " << config.days << ", \"seed\": ";
+    if (config.seeded) {
+        out << config.seed;
+    } else {
+        out << "null";
+    }
+    if (config.stream != 0) {
+        out << ", \"stream\": " << config.stream;
+    }
+    out << ", \"employees\": " << config.employees;
+    if (config.cashiers != 1 || config.managers != 1) {
+        out << ", \"cashiers\": " << config.cashiers << ", \"managers\": " << config.managers;
+    }
+    out << ", \"plants\": {";
+    bool first = true;
+    for (const auto& entry : config.plants) {
+        out << (first ? "" : ", ");
+        writeJsonString(out, entry.first);
+        out << ": " << entry.second;
+        first = false;
+    }
+    out << "}";
+    if (!config.demand.popularity.empty()) {
+        out << ", \"popularity\": {";
+        first = true;
+        for (const auto& entry : config.demand.popularity) {
+            out << (first ? "" : ", ");
+            writeJsonString(out, entry.first);
+            out << ": " << entry.second;
+            first = false;
+        }
+        out << "}";
+    }
+    out << ", \"engine\": \"" << (config.eventDriven ? "events" : "loop") << "\"";
+    if (config.eventDriven) {
+        out << ", \"servers\": " << config.timing.servers << ", \"serviceMinutes\": " << config.timing.meanServiceMinutes;
+    }
+}
+
+/**
+ * @brief Writes a distribution as a JSON object.
+ */
+void writeJsonDistribution(std::ostream& out, const Distribution& d) {
+    out << "{\"mean\": " << d.mean << ", \"stddev\": " << d.stddev << ", \"min\": " << d.min
+        << ", \"p05\": " << d.p05 << ", \"p50\": " << d.p50 << ", \"p95\": " << d.p95 << ", \"max\": " << d.max
+        << "}";
+}
+
+/**
+ * @brief Value at quantile @p q of sorted samples, interpolating between neighbouring ranks.
+ */
+double quantile(const std::vector<double>& sorted, double q) {
+    const double position = q * static_cast<double>(sorted.size() - 1);
+    const std::size_t lower = static_cast<std::size_t>(position);
+    const std::size_t upper = std::min(lower + 1, sorted.size() - 1);
+    return sorted[lower] + (sorted[upper] - sorted[lower]) * (position - static_cast<double>(lower));
+}
+
+/** @brief Daily counter reported in Monte Carlo distributions. */
+struct Metric {
+    const char* name;
+    Distribution DayDistribution::*distribution;
+    double (*read)(const DaySummary&);
+};
+
+const Metric kMetrics[] = {
+    {"customers_served", &DayDistribution::customersServed,
+     [](const DaySummary& day) { return static_cast<double>(day.customersServed); }},
+    {"orders_completed", &DayDistribution::ordersCompleted,
+     [](const DaySummary& day) { return static_cast<double>(day.ordersCompleted); }},
+    {"queries_answered", &DayDistribution::queriesAnswered,
+     [](const DaySummary& day) { return static_cast<double>(day.queriesAnswered); }},
+    {"supplies_consumed", &DayDistribution::suppliesConsumed,
+     [](const DaySummary& day) { return static_cast<double>(day.suppliesConsumed); }},
+    {"supply_shortages", &DayDistribution::supplyShortages,
+     [](const DaySummary& day) { return static_cast<double>(day.supplyShortages); }},
+    {"mean_wait_minutes", &DayDistribution::meanWaitMinutes,
+     [](const DaySummary& day) { return day.meanWaitMinutes; }},
+};
+
+/** JSON key of a metric: its CSV name in camelCase. */
+std::string camelCase(const char* name) {
+    std::string result;
+    bool upper = false;
+    for (const char* p = name; *p != '\0'; ++p) {
+        if (*p == '_') {
+            upper = true;
+        } else {
+            result += upper ? static_cast<char>(*p - 'a' + 'A') : *p;
+            upper = false;
+        }
+    }
+    return result;
+}
+
+} // namespace
+
+// -------------------- BatchConfig --------------------
+/**
+ * @brief Validates and stores one named setting.
+ */
+void BatchConfig::set(const std::string& rawKey, const std::string& rawValue) {
+    const std::string key = trimmed(rawKey);
+    const std::string value = trimmed(rawValue);
+    if (key == "days") {
+        const long parsed = parseInteger(key, value);
+        if (parsed < 1) {
+            throw std::invalid_argument("Setting 'days' must be at least 1");
+        }
+        days = static_cast<int>(parsed);
+    } else if (key == "seed") {
+        seed = parseUnsigned64(key, value);
+        seeded = true;
+    } else if (key == "stream") {
+        stream = parseUnsigned64(key, value);
+    } else if (key == "employees") {
+        employees = static_cast<int>(parseInteger(key, value));
+    } else if (key == "cashiers" || key == "managers" || key == "caretakers") {
+        const long parsed = parseInteger(key, value);
+        if (parsed < 1) {
+            throw std::invalid_argument("Setting '" + key + "' must be at least 1");
+        }
+        // The total tracks the roles, so changing one role keeps the others.
+        const int count = static_cast<int>(parsed);
+        if (key == "cashiers") {
+            employees += count - cashiers;
+            cashiers = count;
+        } else if (key == "managers") {
+            employees += count - managers;
+            managers = count;
+        } else {
+            employees = cashiers + managers + count;
+        }
+    } else if (key == "arrivals_low" || key == "arrivals_medium" || key == "arrivals_high") {
+        arrivals[parseLevel(key.substr(9))] = parseArrivalProfile(key, value);
+    } else if (key == "sections") {
+        std::vector<SectionLayout> layout;
+        for (const std::string& entry : splitList(value, ',')) {
+            const std::size_t equals = entry.find('=');
+            if (equals == std::string::npos) {
+                throw std::invalid_argument("Section entry '" + entry + "' expects name=parent");
+            }
+            layout.push_back({trimmed(entry.substr(0, equals)), trimmed(entry.substr(equals + 1))});
+        }
+        sections = layout;
+    } else if (key == "plants") {
+        std::map<std::string, int> selection;
+        for (const std::string& entry : splitList(value, ',')) {
+            const std::size_t equals = entry.find('=');
+            if (equals == std::string::npos) {
+                throw std::invalid_argument("Plant entry '" + entry + "' expects name=count");
+            }
+            const std::string name = trimmed(entry.substr(0, equals));
+            selection[name] = static_cast<int>(parseInteger("plants", trimmed(entry.substr(equals + 1))));
+        }
+        plants = selection;
+    } else if (key == "schedule") {
+        std::vector<BusinessLevel> levels;
+        for (const std::string& entry : splitList(value, ',')) {
+            levels.push_back(parseLevel(entry));
+        }
+        schedule = levels;
+    } else if (key == "catalog") {
+        catalog = value;
+    } else if (key == "format") {
+        if (value != "json" && value != "csv") {
+            throw std::invalid_argument("Setting 'format' must be json or csv");
+        }
+        format = value;
+    } else if (key == "output") {
+        output = value;
+    } else if (key == "verbose") {
+        verbose = parseFlag(value);
+    } else if (key == "runs") {
+        const long parsed = parseInteger(key, value);
+        if (parsed < 1) {
+            throw std::invalid_argument("Setting 'runs' must be at least 1");
+        }
+        runs = static_cast<int>(parsed);
+    } else if (key == "threads") {
+        const long parsed = parseInteger(key, value);
+        if (parsed < 0) {
+            throw std::invalid_argument("Setting 'threads' must not be negative");
+        }
+        threads = static_cast<int>(parsed);
+    } else if (key == "engine") {
+        if (value != "loop" && value != "events") {
+            throw std::invalid_argument("Setting 'engine' must be loop or events");
+        }
+        eventDriven = value == "events";
+    } else if (key == "servers") {
+        const long parsed = parseInteger(key, value);
+        if (parsed < 1) {
+            throw std::invalid_argument("Setting 'servers' must be at least 1");
+        }
+        timing.servers = static_cast<int>(parsed);
+    } else if (key == "service") {
+        double minutes = -1.0;
+        try {
+            minutes = std::stod(value);
+        } catch (const std::exception&) {
+        }
+        if (!(minutes >= 0.0)) {
+            throw std::invalid_argument("Setting 'service' expects non-negative minutes, got '" + value + "'");
+        }
+        timing.meanServiceMinutes = minutes;
+    } else if (key == "record") {
+        record = value;
+    } else if (key == "replay") {
+        replay = value;
+    } else if (key == "fast_forward") {
+        fastForward = parseFlag(value);
+    } else if (key == "checkpoint") {
+        checkpoint = value;
+    } else if (key == "checkpoint_every") {
+        const long parsed = parseInteger(key, value);
+        if (parsed < 1) {
+            throw std::invalid_argument("Setting 'checkpoint_every' must be at least 1");
+        }
+        checkpointEvery = static_cast<int>(parsed);
+    } else if (key == "resume") {
+        resume = parseFlag(value);
+    } else if (key == "profile_phases") {
+        profilePhases = parseFlag(value);
+    } else if (key == "popularity") {
+        DemandProfile updated = demand;
+        updated.popularity.clear();
+        for (const std::string& entry : splitList(value, ',')) {
+            const std::size_t equals = entry.find('=');
+            if (equals == std::string::npos) {
+                throw std::invalid_argument("Popularity entry '" + entry + "' expects name=weight");
+            }
+            updated.popularity[trimmed(entry.substr(0, equals))] = parseWeight(key, trimmed(entry.substr(equals + 1)));
+        }
+        demand = updated;
+    } else if (key == "products_per_order" || key == "plants_per_product") {
+        DemandProfile updated = demand;
+        (key == "products_per_order" ? updated.productsPerOrder : updated.plantsPerProduct) = parseWeights(key, value);
+        updated.validate();
+        demand = updated;
+    } else {
+        throw std::invalid_argument("Unknown setting '" + key + "'");
+    }
+}
+
+/**
+ * @brief Routes an INI entry to the setting or map its section stands for.
+ */
+void BatchConfig::set(const std::string& section, const std::string& rawKey, const std::string& rawValue) {
+    const std::string key = trimmed(rawKey);
+    const std::string value = trimmed(rawValue);
+    if (section.empty() || section == "scenario") {
+        set(key, value);
+    } else if (section == "plants") {
+        plants[key] = static_cast<int>(parseInteger("plants", value));
+    } else if (section == "popularity") {
+        DemandProfile updated = demand;
+        updated.popularity[key] = parseWeight("popularity", value);
+        demand = updated;
+    } else if (section == "employees") {
+        if (key != "cashiers" && key != "managers" && key != "caretakers") {
+            throw std::invalid_argument("Unknown employee role '" + key + "'");
+        }
+        set(key, value);
+    } else if (section == "arrivals") {
+        arrivals[parseLevel(key)] = parseArrivalProfile("arrivals_" + key, value);
+    } else if (section == "sections") {
+        if (key.empty()) {
+            throw std::invalid_argument("Section entries expect name = parent");
+        }
+        sections.push_back({key, value});
+    } else {
+        throw std::invalid_argument("Unknown section [" + section + "]");
+    }
+}
+
+/**
+ * @brief Opens the file and applies it line by line.
+ */
+void BatchConfig::loadFile(const std::string& path) {
+    std::ifstream in(path);
+    if (!in) {
+        throw std::runtime_error("Cannot read config file " + path);
+    }
+    load(in, path);
+}
+
+/**
+ * @brief Tracks the current [section] and applies each key=value line, prefixing errors with source:line.
+ */
+void BatchConfig::load(std::istream& in, const std::string& source) {
+    std::string section;
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(in, line)) {
+        ++lineNumber;
+        line = trimmed(line);
+        if (line.empty() || line[0] == '#' || line[0] == ';') {
+            continue;
+        }
+        const std::string where = source + ":" + std::to_string(lineNumber) + ": ";
+        if (line[0] == '[') {
+            if (line.back() != ']') {
+                throw std::invalid_argument(where + "expected [section]");
+            }
+            section = trimmed(line.substr(1, line.size() - 2));
+            if (!knownSection(section)) {
+                throw std::invalid_argument(where + "unknown section [" + section + "]");
+            }
+            continue;
+        }
+        const std::size_t equals = line.find('=');
+        if (equals == std::string::npos) {
+            throw std::invalid_argument(where + "expected key=value");
+        }
+        try {
+            set(section, line.substr(0, equals), line.substr(equals + 1));
+        } catch (const std::invalid_argument& error) {
+            throw std::invalid_argument(where + error.what());
+        }
+    }
+}
+
+/**
+ * @brief Applies flags left to right, expanding --config files in place.
+ */
+BatchConfig BatchConfig::fromArguments(int argc, char** argv) {
+    BatchConfig config;
+    for (int i = 1; i < argc; ++i) {
+        std::string argument = argv[i];
+        if (argument == "--help" || argument == "-h") {
+            // Later arguments are not checked, so help is shown even next to a mistyped flag.
+            config.help = true;
+            return config;
+        }
+        if (argument.compare(0, 2, "--") != 0) {
+            config.scenarios.push_back(argument);
+            continue;
+        }
+        argument = argument.substr(2);
+        std::string key = argument;
+        std::string value;
+        const std::size_t equals = argument.find('=');
+        if (equals != std::string::npos) {
+            key = argument.substr(0, equals);
+            value = argument.substr(equals + 1);
+        } else if (key == "verbose" || key == "fast_forward" || key == "resume" || key == "profile_phases") {
+            value = "true";
+        } else if (i + 1 < argc) {
+            value = argv[++i];
+        } else {
+            throw std::invalid_argument("Flag --" + key + " expects a value");
+        }
+        if (key == "config") {
+            config.loadFile(value);
+        } else {
+            config.set(key, value);
+        }
+    }
+    return config;
+}
+
+// -------------------- BatchRunner --------------------
+BatchRunner::BatchRunner(const BatchConfig& settings) : config(settings) {}
+
+/**
+ * @brief Applies the configuration to a fresh simulation and streams its days to @p onDay.
+ */
+void BatchRunner::execute(BatchResult& result, const DayCallback& onDay) const {
+    const Clock::time_point setupStart = Clock::now();
+    if (!config.catalog.empty()) {
+        PlantDatabase::loadCatalog(config.catalog);
+    }
+    // A stream without a buffer is permanently bad, so quiet runs drop staff messages before formatting them.
+    std::ostream discard(nullptr);
+    Simulation simulation(config.days, config.verbose ? std::cout : discard);
+    if (!config.replay.empty()) {
+        simulation.replayTrace(config.replay, config.fastForward);
+        simulation.profilePhases(config.profilePhases);
+    } else {
+        if (config.seeded) {
+            simulation.setRandomStream(config.seed, config.stream);
+        } else if (config.stream != 0) {
+            throw std::invalid_argument("Setting 'stream' needs a seed");
+        }
+        configureSimulation(simulation, config);
+    }
+    simulation.recordTrace(config.record);
+    Clock::time_point runStart;
+    // Only the current day is retained; everything else goes through the callback.
+    simulation.streamDaySummaries(
+        [&](const DaySummary& day) {
+            accumulate(result.totals, day);
+            result.daysRun++;
+            onDay(day, millisecondsSince(runStart));
+        },
+        1);
+    if (!config.checkpoint.empty()) {
+        simulation.checkpointEvery(config.checkpoint, config.checkpointEvery);
+        if (config.resume && fileExists(config.checkpoint)) {
+            simulation.resumeFromCheckpoint(config.checkpoint);
+        }
+    } else if (config.resume) {
+        throw std::invalid_argument("Setting 'resume' needs a checkpoint file");
+    }
+    result.setupMs = millisecondsSince(setupStart);
+
+    runStart = Clock::now();
+    simulation.startSimulation();
+    result.runMs = millisecondsSince(runStart);
+}
+
+/**
+ * @brief Collects every day in memory.
+ */
+BatchResult BatchRunner::run() const {
+    BatchResult result;
+    execute(result, [&result](const DaySummary& day, double elapsedMs) {
+        result.days.push_back(day);
+        result.elapsedMs.push_back(elapsedMs);
+    });
+    return result;
+}
+
+/**
+ * @brief Writes each day as it completes and the timing and totals at the end.
+ */
+BatchResult BatchRunner::stream(std::ostream& out) const {
+    BatchResult result;
+    const bool csv = config.format == "csv";
+    if (csv) {
+        writeCsvHeader(out);
+    } else {
+        writeJsonHeader(out);
+    }
+    execute(result, [&](const DaySummary& day, double elapsedMs) {
+        if (csv) {
+            writeCsvRow(out, day, elapsedMs);
+        } else {
+            writeJsonDay(out, day, elapsedMs, result.daysRun == 1);
+        }
+    });
+    if (!csv) {
+        writeJsonFooter(out, result);
+    }
+    out.flush();
+    return result;
+}
+
+/**
+ * @brief Serialises a collected run as {"config", "days", "timing", "totals"}.
+ */
+void BatchRunner::writeJson(std::ostream& out, const BatchResult& result) const {
+    writeJsonHeader(out);
+    for (std::size_t i = 0; i < result.days.size(); ++i) {
+        writeJsonDay(out, result.days[i], i < result.elapsedMs.size() ? result.elapsedMs[i] : 0.0, i == 0);
+    }
+    writeJsonFooter(out, result);
+}
+
+/**
+ * @brief Serialises a collected run as one row per day.
+ */
+void BatchRunner::writeCsv(std::ostream& out, const BatchResult& result) const {
+    writeCsvHeader(out);
+    for (std::size_t i = 0; i < result.days.size(); ++i) {
+        writeCsvRow(out, result.days[i], i < result.elapsedMs.size() ? result.elapsedMs[i] : 0.0);
+    }
+}
+
+/**
+ * @brief Dispatches on the configured format.
+ */
+void BatchRunner::writeReport(std::ostream& out, const BatchResult& result) const {
+    if (config.format == "csv") {
+        writeCsv(out, result);
+    } else {
+        writeJson(out, result);
+    }
+}
+
+/**
+ * @brief Opens the JSON object with the configuration and the days array.
+ */
+void BatchRunner::writeJsonHeader(std::ostream& out) const {
+    out << "{\n  \"config\": {";
+    writeJsonScenario(out, config);
+    out << "},\n  \"days\": [";
+}
+
+/**
+ * @brief Appends one element of the days array.
+ */
+void BatchRunner::writeJsonDay(std::ostream& out, const DaySummary& day, double elapsedMs, bool first) const {
+    out << (first ? "\n" : ",\n") << "    {\"day\": " << day.dayIndex << ", \"businessLevel\": \""
+        << levelName(day.businessLevel) << "\", \"customersServed\": " << day.customersServed
+        << ", \"ordersCompleted\": " << day.ordersCompleted << ", \"queriesAnswered\": " << day.queriesAnswered
+        << ", \"maintenanceCommands\": " << day.maintenanceCommands
+        << ", \"suppliesConsumed\": " << day.suppliesConsumed << ", \"supplyShortages\": " << day.supplyShortages
+        << ", \"restocksScheduled\": " << day.restocksScheduled
+        << ", \"restocksDelivered\": " << day.restocksDelivered << ", \"meanWaitMinutes\": " << day.meanWaitMinutes
+        << ", \"peakQueueLength\": " << day.peakQueueLength << ", \"elapsedMs\": " << elapsedMs;
+    if (config.profilePhases) {
+        out << ", \"phases\": ";
+        writeJsonPhases(out, day);
+    }
+    out << "}";
+}
+
+/**
+ * @brief Closes the days array and appends timing and totals.
+ */
+void BatchRunner::writeJsonFooter(std::ostream& out, const BatchResult& result) const {
+    const DaySummary& totals = result.totals;
+    out << (result.daysRun == 0 ? "],\n" : "\n  ],\n");
+    out << "  \"timing\": {\"setupMs\": " << result.setupMs << ", \"runMs\": " << result.runMs
+        << ", \"msPerDay\": " << (result.daysRun == 0 ? 0.0 : result.runMs / result.daysRun) << "},\n";
+    out << "  \"totals\": {\"days\": " << result.daysRun << ", \"customersServed\": " << totals.customersServed
+        << ", \"ordersCompleted\": " << totals.ordersCompleted << ", \"queriesAnswered\": " << totals.queriesAnswered
+        << ", \"maintenanceCommands\": " << totals.maintenanceCommands
+        << ", \"suppliesConsumed\": " << totals.suppliesConsumed
+        << ", \"supplyShortages\": " << totals.supplyShortages
+        << ", \"restocksScheduled\": " << totals.restocksScheduled
+        << ", \"restocksDelivered\": " << totals.restocksDelivered;
+    if (config.profilePhases) {
+        out << ", \"phases\": ";
+        writeJsonPhases(out, totals);
+    }
+    out << "}\n}\n";
+}
+
+/**
+ * @brief Writes the CSV column names.
+ */
+void BatchRunner::writeCsvHeader(std::ostream& out) const {
+    out << "day,business_level,customers_served,orders_completed,queries_answered,maintenance_commands,"
+           "supplies_consumed,supply_shortages,restocks_scheduled,restocks_delivered,mean_wait_minutes,"
+           "peak_queue_length,elapsed_ms";
+    if (config.profilePhases) {
+        for (int i = 0; i < kDayPhaseCount; ++i) {
+            const std::string name = dayPhaseName(static_cast<DayPhase>(i));
+            out << ',' << name << "_ms," << name << "_plants_visited," << name << "_allocations," << name
+                << "_commands_executed";
+        }
+    }
+    out << '\n';
+}
+
+/**
+ * @brief Writes one CSV row.
+ */
+void BatchRunner::writeCsvRow(std::ostream& out, const DaySummary& day, double elapsedMs) const {
+    out << day.dayIndex << ',' << levelName(day.businessLevel) << ',' << day.customersServed << ','
+        << day.ordersCompleted << ',' << day.queriesAnswered << ',' << day.maintenanceCommands << ','
+        << day.suppliesConsumed << ',' << day.supplyShortages << ',' << day.restocksScheduled << ','
+        << day.restocksDelivered << ',' << day.meanWaitMinutes << ',' << day.peakQueueLength << ',' << elapsedMs;
+    if (config.profilePhases) {
+        for (const PhaseStats& phase : day.phases) {
+            // Without the allocation hook the column is left empty rather than reporting a false 0.
+            out << ',' << phase.elapsedMs << ',' << phase.counters.plantsVisited << ',';
+            if (allocationCountingLinked) {
+                out << phase.counters.allocations;
+            }
+            out << ',' << phase.counters.commandsExecuted;
+        }
+    }
+    out << '\n';
+}
+
+// -------------------- Monte Carlo --------------------
+/**
+ * @brief Sorts the samples and reads off moments, extremes, and percentiles.
+ */
+Distribution Distribution::of(std::vector<double>& samples) {
+    Distribution result;
+    if (samples.empty()) {
+        return result;
+    }
+    std::sort(samples.begin(), samples.end());
+    double sum = 0.0;
+    for (double value : samples) {
+        sum += value;
+    }
+    result.mean = sum / static_cast<double>(samples.size());
+    if (samples.size() > 1) {
+        double squares = 0.0;
+        for (double value : samples) {
+            squares += (value - result.mean) * (value - result.mean);
+        }
+        result.stddev = std::sqrt(squares / static_cast<double>(samples.size() - 1));
+    }
+    result.min = samples.front();
+    result.max = samples.back();
+    result.p05 = quantile(samples, 0.05);
+    result.p50 = quantile(samples, 0.5);
+    result.p95 = quantile(samples, 0.95);
+    return result;
+}
+
+MonteCarloRunner::MonteCarloRunner(const BatchConfig& config) : scenario(config) {
+    if (scenario.runs < 1) {
+        throw std::invalid_argument("Monte Carlo batches need at least one run");
+    }
+    if (scenario.threads < 0) {
+        throw std::invalid_argument("Thread count must not be negative");
+    }
+    if (!scenario.replay.empty()) {
+        throw std::invalid_argument("Traces are replayed one run at a time");
+    }
+    if (scenario.resume) {
+        throw std::invalid_argument("Checkpoints are resumed one run at a time");
+    }
+}
+
+std::string MonteCarloRunner::tracePathForRun(const std::string& base, std::size_t run) {
+    return base + "." + std::to_string(run);
+}
+
+/**
+ * @brief Hands run indices to workers through a shared counter, then aggregates by day.
+ */
+MonteCarloResult MonteCarloRunner::run() const {
+    MonteCarloResult result;
+    const std::size_t runCount = static_cast<std::size_t>(scenario.runs);
+    std::uint64_t base = scenario.seed;
+    if (!scenario.seeded) {
+        std::random_device rd;
+        base = static_cast<std::uint64_t>(rd()) << 32 | rd();
+    }
+    result.seed = base;
+    result.firstStream = scenario.stream;
+    // Streams are derived up front, one jump apart, rather than each worker walking to its own.
+    const std::vector<SimulationRandom> streams = randomStreams(base, scenario.stream, runCount);
+    result.runs.resize(runCount);
+
+    // The catalog is global; it is swapped before any worker starts and only read afterwards.
+    if (!scenario.catalog.empty()) {
+        PlantDatabase::loadCatalog(scenario.catalog);
+    }
+    unsigned int threads = scenario.threads > 0 ? static_cast<unsigned int>(scenario.threads)
+                                                : std::max(1u, std::thread::hardware_concurrency());
+    threads = static_cast<unsigned int>(std::min<std::size_t>(threads, runCount));
+    result.threads = threads;
+
+    std::vector<double> runMs(runCount, 0.0);
+    std::atomic<std::size_t> nextRun(0);
+    std::atomic<bool> failed(false);
+    std::exception_ptr failure;
+    std::mutex failureMutex;
+    auto worker = [&]() {
+        std::ostream discard(nullptr);
+        for (std::size_t i = nextRun++; i < runCount && !failed; i = nextRun++) {
+            try {
+                const Clock::time_point start = Clock::now();
+                Simulation simulation(scenario.days, scenario.verbose ? std::cout : discard);
+                simulation.setRandomGenerator(streams[i]);
+                configureSimulation(simulation, scenario);
+                if (!scenario.record.empty()) {
+                    simulation.recordTrace(tracePathForRun(scenario.record, i));
+                }
+                if (!scenario.checkpoint.empty()) {
+                    simulation.checkpointEvery(tracePathForRun(scenario.checkpoint, i), scenario.checkpointEvery);
+                }
+                std::vector<DaySummary>& days = result.runs[i];
+                simulation.streamDaySummaries([&days](const DaySummary& day) { days.push_back(day); }, 1);
+                simulation.startSimulation();
+                runMs[i] = millisecondsSince(start);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(failureMutex);
+                if (!failure) {
+                    failure = std::current_exception();
+                }
+                failed = true;
+            }
+        }
+    };
+
+    const Clock::time_point start = Clock::now();
+    {
+        std::vector<std::thread> pool;
+        for (unsigned int t = 1; t < threads; ++t) {
+            pool.emplace_back(worker);
+        }
+        worker();
+        for (std::thread& thread : pool) {
+            thread.join();
+        }
+    }
+    result.wallMs = millisecondsSince(start);
+    if (failure) {
+        std::rethrow_exception(failure);
+    }
+    for (double ms : runMs) {
+        result.runMsTotal += ms;
+    }
+
+    const std::size_t dayCount = result.runs.front().size();
+    std::vector<double> samples(runCount);
+    for (std::size_t d = 0; d < dayCount; ++d) {
+        DayDistribution day;
+        day.dayIndex = result.runs.front()[d].dayIndex;
+        for (const Metric& metric : kMetrics) {
+            for (std::size_t r = 0; r < runCount; ++r) {
+                samples[r] = metric.read(result.runs[r][d]);
+            }
+            day.*metric.distribution = Distribution::of(samples);
+        }
+        result.days.push_back(day);
+    }
+    return result;
+}
+
+/**
+ * @brief Serialises the batch as {"config", "timing", "days"} with one object per counter.
+ */
+void MonteCarloRunner::writeJson(std::ostream& out, const MonteCarloResult& result) const {
+    out << "{\n  \"config\": {";
+    writeJsonScenario(out, scenario);
+    out << ", \"runs\": " << result.runs.size() << ", \"threads\": " << result.threads
+        << ", \"firstStream\": " << result.firstStream << "},\n";
+    out << "  \"timing\": {\"wallMs\": " << result.wallMs << ", \"runMsTotal\": " << result.runMsTotal
+        << ", \"speedup\": " << (result.wallMs > 0.0 ? result.runMsTotal / result.wallMs : 0.0) << "},\n";
+    out << "  \"days\": [";
+    for (std::size_t i = 0; i < result.days.size(); ++i) {
+        const DayDistribution& day = result.days[i];
+        out << (i == 0 ? "\n" : ",\n") << "    {\"day\": " << day.dayIndex;
+        for (const Metric& metric : kMetrics) {
+            out << ", \"" << camelCase(metric.name) << "\": ";
+            writeJsonDistribution(out, day.*metric.distribution);
+        }
+        out << "}";
+    }
+    out << (result.days.empty() ? "]\n}\n" : "\n  ]\n}\n");
+}
+
+/**
+ * @brief Serialises one row per (day, counter).
+ */
+void MonteCarloRunner::writeCsv(std::ostream& out, const MonteCarloResult& result) const {
+    out << "day,metric,runs,mean,stddev,min,p05,p50,p95,max\n";
+    for (const DayDistribution& day : result.days) {
+        for (const Metric& metric : kMetrics) {
+            const Distribution& d = day.*metric.distribution;
+            out << day.dayIndex << ',' << metric.name << ',' << result.runs.size() << ',' << d.mean << ','
+                << d.stddev << ',' << d.min << ',' << d.p05 << ',' << d.p50 << ',' << d.p95 << ',' << d.max << '\n';
+        }
+    }
+}
+
+/**
+ * @brief Dispatches on the configured format.
+ */
+void MonteCarloRunner::writeReport(std::ostream& out, const MonteCarloResult& result) const {
+    if (scenario.format == "csv") {
+        writeCsv(out, result);
+    } else {
+        writeJson(out, result);
+    }
+}
+
+// -------------------- Scenario sweeps --------------------
+ScenarioSweep::ScenarioSweep(const BatchConfig& settings, const std::vector<std::string>& files)
+    : base(settings), paths(files) {
+    if (paths.empty()) {
+        throw std::invalid_argument("A sweep needs at least one scenario file");
+    }
+    if (base.threads < 0) {
+        throw std::invalid_argument("Thread count must not be negative");
+    }
+    base.scenarios.clear();
+}
+
+/**
+ * @brief Parses the file over the base settings and runs it, recording any failure instead of throwing.
+ */
+void ScenarioSweep::runOne(SweepEntry& entry) const {
+    try {
+        const Clock::time_point parseStart = Clock::now();
+        BatchConfig scenario = base;
+        scenario.loadFile(entry.path);
+        entry.parseMs = millisecondsSince(parseStart);
+        if (scenario.catalog != base.catalog) {
+            throw std::invalid_argument("Scenarios in a sweep share the catalog given with --catalog");
+        }
+        if (scenario.runs != 1) {
+            throw std::invalid_argument("Scenarios in a sweep run once each");
+        }
+        if (!scenario.scenarios.empty()) {
+            throw std::invalid_argument("Scenario files cannot start sweeps");
+        }
+        // The catalog is process-wide, so it is loaded once for the whole sweep.
+        scenario.catalog.clear();
+        entry.result = BatchRunner(scenario).run();
+        entry.result.days.clear();
+        entry.result.elapsedMs.clear();
+    } catch (const std::exception& error) {
+        entry.error = error.what();
+    }
+}
+
+/**
+ * @brief Hands files to workers through a shared counter; results are stored by file index.
+ */
+SweepResult ScenarioSweep::run() const {
+    SweepResult result;
+    result.scenarios.resize(paths.size());
+    for (std::size_t i = 0; i < paths.size(); ++i) {
+        result.scenarios[i].path = paths[i];
+    }
+    if (!base.catalog.empty()) {
+        PlantDatabase::loadCatalog(base.catalog);
+    }
+    unsigned int threads = base.threads > 0 ? static_cast<unsigned int>(base.threads)
+                                            : std::max(1u, std::thread::hardware_concurrency());
+    threads = static_cast<unsigned int>(std::min<std::size_t>(threads, paths.size()));
+    result.threads = threads;
+
+    std::atomic<std::size_t> next(0);
+    auto worker = [&]() {
+        for (std::size_t i = next++; i < paths.size(); i = next++) {
+            runOne(result.scenarios[i]);
+        }
+    };
+    const Clock::time_point start = Clock::now();
+    {
+        std::vector<std::thread> pool;
+        for (unsigned int t = 1; t < threads; ++t) {
+            pool.emplace_back(worker);
+        }
+        worker();
+        for (std::thread& thread : pool) {
+            thread.join();
+        }
+    }
+    result.wallMs = millisecondsSince(start);
+    for (const SweepEntry& entry : result.scenarios) {
+        result.failed += entry.error.empty() ? 0 : 1;
+    }
+    return result;
+}
+
+/**
+ * @brief Serialises the sweep as {"sweep", "scenarios"} with the totals of each file.
+ */
+void ScenarioSweep::writeJson(std::ostream& out, const SweepResult& result) const {
+    const double minutes = result.wallMs / 60000.0;
+    out << "{\n  \"sweep\": {\"scenarios\": " << result.scenarios.size() << ", \"failed\": " << result.failed
+        << ", \"threads\": " << result.threads << ", \"wallMs\": " << result.wallMs
+        << ", \"scenariosPerMinute\": " << (minutes > 0.0 ? result.scenarios.size() / minutes : 0.0) << "},\n";
+    out << "  \"scenarios\": [";
+    for (std::size_t i = 0; i < result.scenarios.size(); ++i) {
+        const SweepEntry& entry = result.scenarios[i];
+        out << (i == 0 ? "\n" : ",\n") << "    {\"file\": ";
+        writeJsonString(out, entry.path);
+        if (!entry.error.empty()) {
+            out << ", \"error\": ";
+            writeJsonString(out, entry.error);
+            out << "}";
+            continue;
+        }
+        const DaySummary& totals = entry.result.totals;
+        out << ", \"parseMs\": " << entry.parseMs << ", \"runMs\": " << entry.result.runMs
+            << ", \"days\": " << entry.result.daysRun << ", \"customersServed\": " << totals.customersServed
+            << ", \"ordersCompleted\": " << totals.ordersCompleted
+            << ", \"queriesAnswered\": " << totals.queriesAnswered
+            << ", \"maintenanceCommands\": " << totals.maintenanceCommands
+            << ", \"suppliesConsumed\": " << totals.suppliesConsumed
+            << ", \"supplyShortages\": " << totals.supplyShortages
+            << ", \"restocksScheduled\": " << totals.restocksScheduled
+            << ", \"restocksDelivered\": " << totals.restocksDelivered << "}";
+    }
+    out << (result.scenarios.empty() ? "]\n}\n" : "\n  ]\n}\n");
+}
+
+/**
+ * @brief Serialises one row per file; failed files leave the counters empty and fill `error`.
+ */
+void ScenarioSweep::writeCsv(std::ostream& out, const SweepResult& result) const {
+    out << "file,days,customers_served,orders_completed,queries_answered,maintenance_commands,supplies_consumed,"
+           "supply_shortages,restocks_scheduled,restocks_delivered,parse_ms,run_ms,error\n";
+    for (const SweepEntry& entry : result.scenarios) {
+        writeCsvField(out, entry.path);
+        if (!entry.error.empty()) {
+            out << ",,,,,,,,,,,,";
+            writeCsvField(out, entry.error);
+            out << '\n';
+            continue;
+        }
+        const DaySummary& totals = entry.result.totals;
+        out << ',' << entry.result.daysRun << ',' << totals.customersServed << ',' << totals.ordersCompleted << ','
+            << totals.queriesAnswered << ',' << totals.maintenanceCommands << ',' << totals.suppliesConsumed << ','
+            << totals.supplyShortages << ',' << totals.restocksScheduled << ',' << totals.restocksDelivered << ','
+            << entry.parseMs << ',' << entry.result.runMs << ",\n";
+    }
+}
+
+/**
+ * @brief Dispatches on the base format.
+ */
+void ScenarioSweep::writeReport(std::ostream& out, const SweepResult& result) const {
+    if (base.format == "csv") {
+        writeCsv(out, result);
+    } else {
+        writeJson(out, result);
+    }
+}
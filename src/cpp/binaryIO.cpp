@@ -0,0 +1,119 @@
+/**
+ * @file binaryIO.cpp
+ * @brief Implements whole-file helpers for binary formats.
+ */
+#include "../headers/binaryIO.h"
+
+#include <cerrno>
+#include <cstdio>
+#include <fcntl.h>
+#include <unistd.h>
+
+/**
+ * @brief Loads a file into memory using one sized read.
+ */
+std::vector<char> readFileBytes(const std::string& path) {
+    std::FILE* file = std::fopen(path.c_str(), "rb");
+    if (file == nullptr) {
+        throw std::runtime_error("Cannot open file for reading: " + path);
+    }
+    std::vector<char> bytes;
+    if (std::fseek(file, 0, SEEK_END) == 0) {
+        const long length = std::ftell(file);
+        if (length > 0) {
+            bytes.resize(static_cast<std::size_t>(length));
+        }
+        std::rewind(file);
+    }
+    const std::size_t read = bytes.empty() ? 0 : std::fread(&bytes[0], 1, bytes.size(), file);
+    std::fclose(file);
+    if (read != bytes.size()) {
+        throw std::runtime_error("Failed to read file: " + path);
+    }
+    return bytes;
+}
+
+/**
+ * @brief Writes a complete buffer to disk, truncating the destination.
+ */
+void writeFileBytes(const std::string& path, const std::vector<char>& bytes) {
+    std::FILE* file = std::fopen(path.c_str(), "wb");
+    if (file == nullptr) {
+        throw std::runtime_error("Cannot open file for writing: " + path);
+    }
+    const std::size_t written = bytes.empty() ? 0 : std::fwrite(&bytes[0], 1, bytes.size(), file);
+    const bool closed = std::fclose(file) == 0;
+    if (written != bytes.size() || !closed) {
+        throw std::runtime_error("Failed to write file: " + path);
+    }
+}
+
+std::uint32_t frameChecksum(const char* data, std::size_t size) {
+    std::uint32_t hash = 2166136261u;
+    for (std::size_t i = 0; i < size; ++i) {
+        hash ^= static_cast<unsigned char>(data[i]);
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+void writeAllBytes(int fd, const char* data, std::size_t size) {
+    while (size > 0) {
+        const ssize_t written = ::write(fd, data, size);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            throw std::runtime_error(std::string("Failed to write file: ") + std::strerror(errno));
+        }
+        data += written;
+        size -= static_cast<std::size_t>(written);
+    }
+}
+
+void syncFileData(int fd) {
+#ifdef __APPLE__
+    const int result = ::fsync(fd);
+#else
+    const int result = ::fdatasync(fd);
+#endif
+    if (result != 0) {
+        throw std::runtime_error(std::string("Failed to sync file: ") + std::strerror(errno));
+    }
+}
+
+void replaceFileDurably(const std::string& path, const std::vector<char>& bytes) {
+    const std::string temporary = path + ".tmp";
+    const int fd = ::open(temporary.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        throw std::runtime_error("Cannot open file for writing: " + temporary);
+    }
+    try {
+        writeAllBytes(fd, bytes.data(), bytes.size());
+        syncFileData(fd);
+    } catch (...) {
+        ::close(fd);
+        throw;
+    }
+    ::close(fd);
+    if (std::rename(temporary.c_str(), path.c_str()) != 0) {
+        throw std::runtime_error("Failed to replace file: " + path);
+    }
+}
+
+void appendFileDurably(const std::string& path, const std::vector<char>& bytes) {
+    const int fd = ::open(path.c_str(), O_WRONLY | O_APPEND);
+    if (fd < 0) {
+        throw std::runtime_error("Cannot open file for appending: " + path);
+    }
+    try {
+        writeAllBytes(fd, bytes.data(), bytes.size());
+        syncFileData(fd);
+    } catch (...) {
+        ::close(fd);
+        throw;
+    }
+    ::close(fd);
+}
+
+bool fileExists(const std::string& path) { return ::access(path.c_str(), R_OK) == 0; }
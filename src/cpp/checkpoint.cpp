@@ -0,0 +1,543 @@
+/**
+ * @file checkpoint.cpp
+ * @brief Implements incremental simulation checkpoints and resuming from them.
+ */
+#include "../headers/checkpoint.h"
+
+#include "../headers/binaryIO.h"
+#include "../headers/garden.h"
+#include "../headers/greenhouseManager.h"
+#include "../headers/plant.h"
+
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
+
+namespace {
+
+constexpr char kCheckpointMagic[8] = {'G', 'H', 'R', 'U', 'N', 'C', 'K', '1'};
+constexpr std::uint32_t kCheckpointVersion = 2;
+/** Magic, byte-order marker, and version. */
+constexpr std::size_t kHeaderBytes = sizeof(kCheckpointMagic) + 2 * sizeof(std::uint32_t);
+/** Payload length and checksum preceding every frame. */
+constexpr std::size_t kFrameHeaderBytes = 2 * sizeof(std::uint32_t);
+constexpr std::uint32_t kNoIndex = 0xFFFFFFFFu;
+/** Delta bytes, as a multiple of the last full frame, after which the file is rewritten. */
+constexpr std::size_t kCompactionFactor = 8;
+
+/** @brief Kinds of checkpoint frame. */
+enum FrameKind : std::uint8_t { FULL_FRAME = 1, DELTA_FRAME = 2 };
+/** @brief Kinds of entry in a section's child list. */
+enum ChildTag : std::uint8_t { PLANT_CHILD = 0, SECTION_CHILD = 1 };
+
+/** @brief Section tree gathered in pre-order. */
+struct SectionTree {
+    std::vector<const GardenSection*> sections;
+    std::vector<std::string> names;
+    std::vector<std::uint32_t> parents;
+};
+
+/**
+ * @brief Walks the greenhouse in pre-order, children in their stored order.
+ */
+SectionTree gatherSections(const GreenHouseManager& greenhouse) {
+    std::unordered_map<const GardenSection*, const std::string*> names;
+    for (const auto& entry : greenhouse.getSectionIndex()) {
+        names[entry.second] = &entry.first;
+    }
+    SectionTree tree;
+    std::vector<std::pair<const GardenSection*, std::uint32_t>> pending;
+    pending.push_back(std::make_pair(greenhouse.getRoot(), kNoIndex));
+    while (!pending.empty()) {
+        const GardenSection* section = pending.back().first;
+        const std::uint32_t parent = pending.back().second;
+        pending.pop_back();
+        const auto index = static_cast<std::uint32_t>(tree.sections.size());
+        const auto name = names.find(section);
+        tree.sections.push_back(section);
+        tree.names.push_back(name != names.end() ? *name->second : std::string());
+        tree.parents.push_back(parent);
+
+        const std::vector<GardenComponent*> children = section->getChildren();
+        for (auto it = children.rbegin(); it != children.rend(); ++it) {
+            if (!(*it)->isLeaf()) {
+                if (const auto* subsection = dynamic_cast<const GardenSection*>(*it)) {
+                    pending.push_back(std::make_pair(subsection, index));
+                }
+            }
+        }
+    }
+    return tree;
+}
+
+/**
+ * @brief Encodes a section's children in order: each plant's condition, and a marker per subsection.
+ *
+ * Plants carry their species name rather than a file-wide string id, so a
+ * section's encoding stands alone in whichever frame holds it.
+ */
+void encodeSection(ByteWriter& out, const GardenSection* section) {
+    const std::vector<GardenComponent*> children = section->getChildren();
+    out.put(static_cast<std::uint32_t>(children.size()));
+    for (GardenComponent* child : children) {
+        auto* plant = child->isLeaf() ? dynamic_cast<Plant*>(child) : nullptr;
+        if (plant == nullptr) {
+            out.put(static_cast<std::uint8_t>(SECTION_CHILD));
+            continue;
+        }
+        out.put(static_cast<std::uint8_t>(PLANT_CHILD));
+        out.putString(plant->getName());
+        out.put(plant->getPrice());
+        out.put(plant->getWaterLevel());
+        out.put(static_cast<std::int32_t>(plant->getAge()));
+        out.put(static_cast<std::uint8_t>(plant->getWaterPreference()));
+        out.put(static_cast<std::uint8_t>(plant->getSunlightPreference()));
+        out.put(static_cast<std::uint8_t>(plant->getLifecycle()));
+        out.put(static_cast<std::uint8_t>(plant->getLocation()));
+    }
+}
+
+/**
+ * @brief Folds one word into a running hash with the splitmix64 finaliser.
+ */
+std::uint64_t mixWord(std::uint64_t hash, std::uint64_t word) {
+    word += hash + 0x9E3779B97F4A7C15ull;
+    word = (word ^ (word >> 30)) * 0xBF58476D1CE4E5B9ull;
+    word = (word ^ (word >> 27)) * 0x94D049BB133111EBull;
+    return word ^ (word >> 31);
+}
+
+/**
+ * @brief Hashes everything @ref encodeSection writes, a few words per plant, without encoding it.
+ *
+ * Hashes are only compared within one writer, so the process-local string
+ * hash is fine.
+ */
+std::uint64_t contentHash(const GardenSection* section) {
+    const std::hash<std::string> hashName;
+    const std::vector<GardenComponent*> children = section->getChildren();
+    std::uint64_t hash = mixWord(0, children.size());
+    for (GardenComponent* child : children) {
+        auto* plant = child->isLeaf() ? dynamic_cast<Plant*>(child) : nullptr;
+        if (plant == nullptr) {
+            hash = mixWord(hash, SECTION_CHILD);
+            continue;
+        }
+        std::uint64_t price = 0;
+        std::uint64_t water = 0;
+        const double priceValue = plant->getPrice();
+        const double waterValue = plant->getWaterLevel();
+        std::memcpy(&price, &priceValue, sizeof(price));
+        std::memcpy(&water, &waterValue, sizeof(water));
+        const std::uint64_t condition = static_cast<std::uint64_t>(static_cast<std::uint32_t>(plant->getAge())) << 32 |
+                                        static_cast<std::uint64_t>(plant->getWaterPreference()) << 24 |
+                                        static_cast<std::uint64_t>(plant->getSunlightPreference()) << 16 |
+                                        static_cast<std::uint64_t>(plant->getLifecycle()) << 8 |
+                                        static_cast<std::uint64_t>(plant->getLocation());
+        hash = mixWord(hash, hashName(plant->getName()));
+        hash = mixWord(hash, price);
+        hash = mixWord(hash, water);
+        hash = mixWord(hash, condition);
+    }
+    return hash;
+}
+
+/**
+ * @brief Appends a generator's state as 64-bit words.
+ */
+void putGenerator(ByteWriter& out, const SimulationRandom& generator) {
+    const std::vector<std::uint64_t> state = generatorWords(generator);
+    out.put(static_cast<std::uint32_t>(state.size()));
+    out.putBytes(state.data(), state.size() * sizeof(std::uint64_t));
+}
+
+SimulationRandom getGenerator(ByteReader& in) {
+    const std::uint32_t words = in.get<std::uint32_t>();
+    if (words > in.remaining() / sizeof(std::uint64_t)) {
+        throw std::runtime_error("Checkpoint RNG state is corrupt");
+    }
+    std::vector<std::uint64_t> state(words);
+    for (std::uint64_t& word : state) {
+        word = in.get<std::uint64_t>();
+    }
+    try {
+        return generatorFromWords<SimulationRandom>(state);
+    } catch (const std::runtime_error&) {
+        throw std::runtime_error("Checkpoint RNG state is corrupt");
+    }
+}
+
+void putSummary(ByteWriter& out, const DaySummary& day) {
+    out.put(static_cast<std::int32_t>(day.dayIndex));
+    out.put(static_cast<std::uint8_t>(day.businessLevel));
+    out.put(static_cast<std::int32_t>(day.customersServed));
+    out.put(static_cast<std::int32_t>(day.ordersCompleted));
+    out.put(static_cast<std::int32_t>(day.queriesAnswered));
+    out.put(static_cast<std::int32_t>(day.maintenanceCommands));
+    out.put(static_cast<std::int64_t>(day.suppliesConsumed));
+    out.put(static_cast<std::int64_t>(day.supplyShortages));
+    out.put(static_cast<std::int32_t>(day.restocksScheduled));
+    out.put(static_cast<std::int32_t>(day.restocksDelivered));
+    out.put(day.meanWaitMinutes);
+    out.put(static_cast<std::int32_t>(day.peakQueueLength));
+}
+
+DaySummary getSummary(ByteReader& in) {
+    DaySummary day;
+    day.dayIndex = in.get<std::int32_t>();
+    day.businessLevel = in.getEnum(BusinessLevel::HIGH, "Checkpoint business level is corrupt");
+    day.customersServed = in.get<std::int32_t>();
+    day.ordersCompleted = in.get<std::int32_t>();
+    day.queriesAnswered = in.get<std::int32_t>();
+    day.maintenanceCommands = in.get<std::int32_t>();
+    day.suppliesConsumed = in.get<std::int64_t>();
+    day.supplyShortages = in.get<std::int64_t>();
+    day.restocksScheduled = in.get<std::int32_t>();
+    day.restocksDelivered = in.get<std::int32_t>();
+    day.meanWaitMinutes = in.get<double>();
+    day.peakQueueLength = in.get<std::int32_t>();
+    return day;
+}
+
+/**
+ * @brief Appends the run state, stock lines, and the summaries after @p lastDay.
+ */
+void putRunState(ByteWriter& out, const CheckpointState& state, const std::vector<const GardenSection*>& sections,
+                 const Inventory& inventory, const std::vector<DaySummary>& summaries, int lastDay) {
+    out.put(static_cast<std::int32_t>(state.day));
+    putGenerator(out, state.rng);
+    putGenerator(out, state.pricing);
+    out.put(state.generatedCustomers);
+    out.put(state.manualCustomerIndex);
+    out.put(static_cast<std::uint32_t>(state.pendingRestocks.size()));
+    for (SkuId sku : state.pendingRestocks) {
+        out.put(static_cast<std::int32_t>(sku));
+    }
+    out.put(static_cast<std::uint32_t>(state.employees.size()));
+    for (const CheckpointedEmployee& employee : state.employees) {
+        const auto home = std::find(sections.begin(), sections.end(), employee.homeSection);
+        out.put(static_cast<std::int32_t>(employee.complaints));
+        out.put(employee.homeSection != nullptr && home != sections.end()
+                    ? static_cast<std::uint32_t>(home - sections.begin())
+                    : kNoIndex);
+    }
+
+    const std::size_t lines = inventory.skuCount();
+    out.put(static_cast<std::uint32_t>(lines));
+    for (std::size_t i = 0; i < lines; ++i) {
+        const auto sku = static_cast<SkuId>(i);
+        out.put(static_cast<std::uint8_t>(inventory.skuCategory(sku)));
+        out.putString(inventory.skuName(sku));
+        out.put(static_cast<std::int32_t>(inventory.getQuantity(sku)));
+    }
+
+    const auto firstNew = std::find_if(summaries.begin(), summaries.end(),
+                                       [lastDay](const DaySummary& day) { return day.dayIndex > lastDay; });
+    out.put(static_cast<std::uint32_t>(summaries.end() - firstNew));
+    for (auto it = firstNew; it != summaries.end(); ++it) {
+        putSummary(out, *it);
+    }
+}
+
+/** @brief Everything a chain of frames restores, before the greenhouse is rebuilt. */
+struct RestoredFrames {
+    CheckpointState state;
+    std::vector<std::uint32_t> homeSections;
+    std::vector<SupplyLine> stock;
+    std::vector<std::string> names;
+    std::vector<std::uint32_t> parents;
+    std::vector<std::vector<char>> contents;
+};
+
+/**
+ * @brief Reads the run state and stock of a frame; summaries replace or extend the restored ones.
+ */
+void getRunState(ByteReader& in, RestoredFrames& restored, bool full) {
+    CheckpointState& state = restored.state;
+    state.day = in.get<std::int32_t>();
+    state.rng = getGenerator(in);
+    state.pricing = getGenerator(in);
+    state.generatedCustomers = in.get<std::int64_t>();
+    state.manualCustomerIndex = in.get<std::uint64_t>();
+    state.pendingRestocks.clear();
+    for (std::uint32_t count = in.get<std::uint32_t>(); count > 0; --count) {
+        state.pendingRestocks.push_back(in.get<std::int32_t>());
+    }
+    state.employees.clear();
+    restored.homeSections.clear();
+    for (std::uint32_t count = in.get<std::uint32_t>(); count > 0; --count) {
+        CheckpointedEmployee employee;
+        employee.complaints = in.get<std::int32_t>();
+        state.employees.push_back(employee);
+        restored.homeSections.push_back(in.get<std::uint32_t>());
+    }
+
+    restored.stock.clear();
+    for (std::uint32_t count = in.get<std::uint32_t>(); count > 0; --count) {
+        SupplyLine line;
+        line.category = in.getEnum(InventoryCategory::WRAPPER, "Checkpoint supply category is corrupt");
+        line.item = in.getString();
+        line.quantity = in.get<std::int32_t>();
+        restored.stock.push_back(line);
+    }
+
+    if (full) {
+        state.summaries.clear();
+    }
+    for (std::uint32_t count = in.get<std::uint32_t>(); count > 0; --count) {
+        state.summaries.push_back(getSummary(in));
+    }
+}
+
+std::vector<char> getContents(ByteReader& in) {
+    const std::uint32_t size = in.get<std::uint32_t>();
+    const char* bytes = in.take(size);
+    return std::vector<char>(bytes, bytes + size);
+}
+
+/**
+ * @brief Adds a section's plants and subsections in their recorded order, recursing into subsections.
+ */
+void rebuildSection(GreenHouseManager& greenhouse, const RestoredFrames& restored,
+                    const std::vector<std::vector<std::uint32_t>>& childSections, std::uint32_t index,
+                    std::vector<GardenSection*>& built) {
+    GardenSection* section = built[index];
+    const std::vector<char>& bytes = restored.contents[index];
+    ByteReader in(bytes.data(), bytes.size());
+    std::size_t nextChild = 0;
+    for (std::uint32_t count = in.get<std::uint32_t>(); count > 0; --count) {
+        if (in.get<std::uint8_t>() == SECTION_CHILD) {
+            if (nextChild >= childSections[index].size()) {
+                throw std::runtime_error("Checkpoint section table is corrupt");
+            }
+            const std::uint32_t child = childSections[index][nextChild++];
+            const std::string& name = restored.names[child];
+            if (!name.empty() && (index == 0 || !restored.names[index].empty())) {
+                built[child] = greenhouse.addSection(name, index == 0 ? greenhouse.getRootName() : restored.names[index]);
+            } else {
+                built[child] = new GardenSection();
+                section->add(built[child]);
+            }
+            rebuildSection(greenhouse, restored, childSections, child, built);
+            continue;
+        }
+        const std::string name = in.getString();
+        const double price = in.get<double>();
+        const double waterLevel = in.get<double>();
+        const std::int32_t age = in.get<std::int32_t>();
+        const auto water = in.getEnum(WaterPreference::HIGH, "Checkpoint water preference is corrupt");
+        const auto sun = in.getEnum(SunlightPreference::HIGH, "Checkpoint sunlight preference is corrupt");
+        const auto lifecycle = in.getEnum(PlantLifecycle::DEAD, "Checkpoint lifecycle is corrupt");
+        const auto location = in.getEnum(PlantLocation::INSIDE, "Checkpoint plant location is corrupt");
+        auto* plant = new Plant(name, price, createWaterLossStrategy(water), createSunlightStrategy(sun),
+                                createPlantState(lifecycle));
+        plant->restoreCondition(waterLevel, age, location);
+        section->add(plant);
+    }
+    if (nextChild != childSections[index].size() || !in.atEnd()) {
+        throw std::runtime_error("Checkpoint section table is corrupt");
+    }
+}
+
+} // namespace
+
+SimulationCheckpoint::SimulationCheckpoint(const std::string& path) : path(path) {}
+
+/**
+ * @brief Appends a delta of the sections whose encoding changed, or starts over with a full frame.
+ */
+void SimulationCheckpoint::write(const GreenHouseManager& greenhouse, const Inventory& inventory,
+                                 const CheckpointState& state, const std::vector<DaySummary>& summaries) {
+    SectionTree tree = gatherSections(greenhouse);
+    if (stats.fullFrames == 0 || tree.sections != sections || tree.names != sectionNames ||
+        tree.parents != sectionParents || deltaBytes > kCompactionFactor * fullFrameBytes) {
+        sections.swap(tree.sections);
+        sectionNames.swap(tree.names);
+        sectionParents.swap(tree.parents);
+        writeFull(greenhouse, inventory, state, summaries);
+        return;
+    }
+
+    ByteWriter frame;
+    frame.extend(kFrameHeaderBytes);
+    frame.put(static_cast<std::uint8_t>(DELTA_FRAME));
+    putRunState(frame, state, sections, inventory, summaries, lastSummaryDay);
+    const std::size_t countAt = frame.size();
+    frame.put(static_cast<std::uint32_t>(0));
+    std::uint32_t changed = 0;
+    ByteWriter encoded;
+    for (std::size_t i = 0; i < sections.size(); ++i) {
+        const std::uint64_t revision = sections[i]->getRevision();
+        if (revision == revisions[i]) {
+            stats.sectionsSkipped++;
+            continue;
+        }
+        revisions[i] = revision;
+        const std::uint64_t hash = contentHash(sections[i]);
+        if (hash == hashes[i]) {
+            stats.sectionsSkipped++;
+            continue;
+        }
+        hashes[i] = hash;
+        encoded.clear();
+        encodeSection(encoded, sections[i]);
+        frame.put(static_cast<std::uint32_t>(i));
+        frame.put(static_cast<std::uint32_t>(encoded.size()));
+        frame.putBytes(encoded.bytes().data(), encoded.size());
+        changed++;
+    }
+    frame.patch(countAt, changed);
+
+    const std::size_t payloadBytes = frame.size() - kFrameHeaderBytes;
+    frame.patch(0, static_cast<std::uint32_t>(payloadBytes));
+    frame.patch(sizeof(std::uint32_t), frameChecksum(frame.bytes().data() + kFrameHeaderBytes, payloadBytes));
+    appendFileDurably(path, frame.bytes());
+
+    lastSummaryDay = summaries.empty() ? lastSummaryDay : summaries.back().dayIndex;
+    deltaBytes += frame.size();
+    stats.deltaFrames++;
+    stats.sectionsWritten += changed;
+    stats.bytes += frame.size();
+    stats.lastFrameBytes = frame.size();
+}
+
+/**
+ * @brief Replaces the file with a header and one frame holding the tree and every section.
+ */
+void SimulationCheckpoint::writeFull(const GreenHouseManager& greenhouse, const Inventory& inventory,
+                                     const CheckpointState& state, const std::vector<DaySummary>& summaries) {
+    ByteWriter out;
+    out.putBytes(kCheckpointMagic, sizeof(kCheckpointMagic));
+    out.put(kByteOrderMarker);
+    out.put(kCheckpointVersion);
+    const std::size_t frameAt = out.size();
+    out.extend(kFrameHeaderBytes);
+    out.put(static_cast<std::uint8_t>(FULL_FRAME));
+    putRunState(out, state, sections, inventory, summaries, 0);
+
+    out.put(static_cast<std::uint32_t>(sections.size()));
+    for (std::size_t i = 0; i < sections.size(); ++i) {
+        out.putString(sectionNames[i]);
+        out.put(sectionParents[i]);
+    }
+    revisions.assign(sections.size(), 0);
+    hashes.assign(sections.size(), 0);
+    ByteWriter encoded;
+    for (std::size_t i = 0; i < sections.size(); ++i) {
+        revisions[i] = sections[i]->getRevision();
+        hashes[i] = contentHash(sections[i]);
+        encoded.clear();
+        encodeSection(encoded, sections[i]);
+        out.put(static_cast<std::uint32_t>(encoded.size()));
+        out.putBytes(encoded.bytes().data(), encoded.size());
+    }
+
+    const std::size_t payloadBytes = out.size() - frameAt - kFrameHeaderBytes;
+    out.patch(frameAt, static_cast<std::uint32_t>(payloadBytes));
+    out.patch(frameAt + sizeof(std::uint32_t),
+              frameChecksum(out.bytes().data() + frameAt + kFrameHeaderBytes, payloadBytes));
+    replaceFileDurably(path, out.bytes());
+
+    lastSummaryDay = summaries.empty() ? 0 : summaries.back().dayIndex;
+    fullFrameBytes = out.size();
+    deltaBytes = 0;
+    stats.fullFrames++;
+    stats.sectionsWritten += sections.size();
+    stats.bytes += out.size();
+    stats.lastFrameBytes = out.size() - frameAt;
+}
+
+/**
+ * @brief Applies the full frame and every intact delta after it, then rebuilds the greenhouse once.
+ */
+CheckpointState SimulationCheckpoint::restore(const std::string& path, GreenHouseManager& greenhouse,
+                                              Inventory& inventory) {
+    GardenSection* root = greenhouse.getRoot();
+    if (!root->getChildren().empty()) {
+        throw std::logic_error("Checkpoints can only be restored into an empty greenhouse");
+    }
+    const std::vector<char> image = readFileBytes(path);
+    ByteReader header(image.data(), image.size());
+    if (image.size() < kHeaderBytes ||
+        std::memcmp(header.take(sizeof(kCheckpointMagic)), kCheckpointMagic, sizeof(kCheckpointMagic)) != 0) {
+        throw std::runtime_error("Not a simulation checkpoint: " + path);
+    }
+    if (header.get<std::uint32_t>() != kByteOrderMarker) {
+        throw std::runtime_error("Checkpoint was written on a host with a different byte order: " + path);
+    }
+    if (header.get<std::uint32_t>() != kCheckpointVersion) {
+        throw std::runtime_error("Unsupported checkpoint version: " + path);
+    }
+
+    RestoredFrames restored;
+    bool haveFull = false;
+    std::size_t offset = kHeaderBytes;
+    while (image.size() - offset >= kFrameHeaderBytes) {
+        ByteReader frameHeader(image.data() + offset, kFrameHeaderBytes);
+        const std::uint32_t payloadBytes = frameHeader.get<std::uint32_t>();
+        const std::uint32_t expected = frameHeader.get<std::uint32_t>();
+        const char* payload = image.data() + offset + kFrameHeaderBytes;
+        if (payloadBytes > image.size() - offset - kFrameHeaderBytes ||
+            frameChecksum(payload, payloadBytes) != expected) {
+            break;
+        }
+        ByteReader in(payload, payloadBytes);
+        const std::uint8_t kind = in.get<std::uint8_t>();
+        if (kind != FULL_FRAME && (kind != DELTA_FRAME || !haveFull)) {
+            throw std::runtime_error("Checkpoint frame sequence is corrupt: " + path);
+        }
+        getRunState(in, restored, kind == FULL_FRAME);
+        if (kind == FULL_FRAME) {
+            const std::uint32_t sectionCount = in.get<std::uint32_t>();
+            restored.names.clear();
+            restored.parents.clear();
+            for (std::uint32_t i = 0; i < sectionCount; ++i) {
+                restored.names.push_back(in.getString());
+                restored.parents.push_back(in.get<std::uint32_t>());
+                if (i == 0 ? restored.parents[i] != kNoIndex : restored.parents[i] >= i) {
+                    throw std::runtime_error("Checkpoint section table is corrupt");
+                }
+            }
+            restored.contents.clear();
+            for (std::uint32_t i = 0; i < sectionCount; ++i) {
+                restored.contents.push_back(getContents(in));
+            }
+            haveFull = sectionCount > 0;
+        } else {
+            for (std::uint32_t count = in.get<std::uint32_t>(); count > 0; --count) {
+                const std::uint32_t index = in.get<std::uint32_t>();
+                if (index >= restored.contents.size()) {
+                    throw std::runtime_error("Checkpoint references an unknown section");
+                }
+                restored.contents[index] = getContents(in);
+            }
+        }
+        if (!in.atEnd()) {
+            throw std::runtime_error("Checkpoint frame has trailing bytes: " + path);
+        }
+        offset += kFrameHeaderBytes + payloadBytes;
+    }
+    if (!haveFull) {
+        throw std::runtime_error("Checkpoint has no intact full frame: " + path);
+    }
+
+    std::vector<std::vector<std::uint32_t>> childSections(restored.names.size());
+    for (std::uint32_t i = 1; i < restored.parents.size(); ++i) {
+        childSections[restored.parents[i]].push_back(i);
+    }
+    std::vector<GardenSection*> built(restored.names.size(), nullptr);
+    built[0] = root;
+    rebuildSection(greenhouse, restored, childSections, 0, built);
+
+    for (const SupplyLine& line : restored.stock) {
+        inventory.addStock(line.category, line.item, line.quantity);
+    }
+    for (std::size_t i = 0; i < restored.homeSections.size(); ++i) {
+        const std::uint32_t home = restored.homeSections[i];
+        restored.state.employees[i].homeSection = home < built.size() ? built[home] : nullptr;
+    }
+    return restored.state;
+}
@@ -0,0 +1,99 @@
+/**
+ * @file demand.cpp
+ * @brief Implements alias-table construction and demand profile checks.
+ */
+#include "../headers/demand.h"
+
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+namespace {
+
+/**
+ * @brief Rejects negative or non-finite weights and returns their sum.
+ */
+double checkedTotal(const std::vector<double>& weights, const char* what) {
+    double total = 0.0;
+    for (double weight : weights) {
+        if (!(weight >= 0.0) || std::isinf(weight)) {
+            throw std::invalid_argument(std::string(what) + " weights must be finite and non-negative");
+        }
+        total += weight;
+    }
+    return total;
+}
+
+} // namespace
+
+// -------------------- AliasTable --------------------
+/**
+ * @brief Vose's construction: scale weights to mean 1, then pair each short column with a tall one.
+ *
+ * Each short column keeps its own share and is topped up by the tall column,
+ * which shrinks by the same amount and is re-filed as short or tall.
+ * Columns left at the end are full up to rounding error.
+ */
+AliasTable::AliasTable(const std::vector<double>& weights) {
+    const double total = checkedTotal(weights, "Alias table");
+    if (!(total > 0.0)) {
+        throw std::invalid_argument("Alias table needs at least one positive weight");
+    }
+    const std::size_t count = weights.size();
+    if (count > std::numeric_limits<std::uint32_t>::max()) {
+        throw std::invalid_argument("Alias table holds at most 2^32 - 1 weights");
+    }
+    std::vector<double> probability(count);
+    alias.resize(count);
+    std::vector<double> scaled(count);
+    std::vector<std::uint32_t> small;
+    std::vector<std::uint32_t> large;
+    for (std::size_t i = 0; i < count; ++i) {
+        scaled[i] = weights[i] * static_cast<double>(count) / total;
+        (scaled[i] < 1.0 ? small : large).push_back(static_cast<std::uint32_t>(i));
+    }
+    while (!small.empty() && !large.empty()) {
+        const std::uint32_t shortColumn = small.back();
+        small.pop_back();
+        const std::uint32_t tallColumn = large.back();
+        probability[shortColumn] = scaled[shortColumn];
+        alias[shortColumn] = tallColumn;
+        scaled[tallColumn] -= 1.0 - scaled[shortColumn];
+        if (scaled[tallColumn] < 1.0) {
+            large.pop_back();
+            small.push_back(tallColumn);
+        }
+    }
+    for (std::uint32_t column : large) {
+        probability[column] = 1.0;
+        alias[column] = column;
+    }
+    for (std::uint32_t column : small) {
+        probability[column] = 1.0;
+        alias[column] = column;
+    }
+    keep.resize(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        keep[i] = static_cast<std::uint64_t>(std::ldexp(probability[i], 32));
+    }
+}
+
+// -------------------- DemandProfile --------------------
+void DemandProfile::validate() const {
+    for (const auto& entry : popularity) {
+        if (!(entry.second >= 0.0) || std::isinf(entry.second)) {
+            throw std::invalid_argument("Popularity of " + entry.first + " must be finite and non-negative");
+        }
+    }
+    if (!(checkedTotal(productsPerOrder, "Products-per-order") > 0.0)) {
+        throw std::invalid_argument("Products-per-order weights need a positive entry");
+    }
+    if (!(checkedTotal(plantsPerProduct, "Plants-per-product") > 0.0)) {
+        throw std::invalid_argument("Plants-per-product weights need a positive entry");
+    }
+}
+
+double DemandProfile::weightOf(const std::string& species) const {
+    auto found = popularity.find(species);
+    return found == popularity.end() ? 1.0 : found->second;
+}
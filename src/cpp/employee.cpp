@@ -7,15 +7,21 @@
 #include "../headers/plantDatabase.h"
 #include "../headers/iterator.h"
 #include "../headers/frontDesk.h"
+#include <unordered_set>
 namespace {
 
+/** Wrapping paper drawn from the shared inventory for wrapped products. */
+const char* const kWrappingPaper = "Wrapping";
+
 /**
  * @brief Finds a plant by name that is currently sellable.
  * @param greenhouse Root component to search.
  * @param name Plant name to locate.
+ * @param claimed Plants already promised to other products, skipped when non-null.
  * @return Pointer to qualifying plant or nullptr.
  */
-Plant* findAvailablePlant(GardenComponent* greenhouse, const std::string& name) {
+Plant* findAvailablePlant(GardenComponent* greenhouse, const std::string& name,
+                          const std::unordered_set<const Plant*>* claimed = nullptr) {
     if (!greenhouse) {
         return nullptr;
     }
@@ -27,7 +33,7 @@ Plant* findAvailablePlant(GardenComponent* greenhouse, const std::string& name)
 
     for (GardenComponent* node = iter->first(); node != nullptr; node = iter->next()) {
         if (auto* plant = dynamic_cast<Plant*>(node)) {
-            if (plant->getName() == name && plant->canSell()) {
+            if (plant->getName() == name && plant->canSell() && (!claimed || claimed->count(plant) == 0)) {
                 delete iter;
                 return plant;
             }
@@ -38,6 +44,32 @@ Plant* findAvailablePlant(GardenComponent* greenhouse, const std::string& name)
     return nullptr;
 }
 
+/**
+ * @brief Finds a sellable plant by exact name, else resolves an unlisted name to the closest catalog match in stock.
+ * @param greenhouse Root component to search.
+ * @param name Plant name as requested, possibly misspelt.
+ * @param console Stream told which species an unlisted name was taken to mean.
+ * @param claimed Plants already promised to other products, skipped when non-null.
+ * @return Pointer to qualifying plant or nullptr.
+ */
+Plant* findAvailableOrClosestPlant(GardenComponent* greenhouse, const std::string& name, std::ostream& console,
+                                   const std::unordered_set<const Plant*>* claimed = nullptr) {
+    if (Plant* plant = findAvailablePlant(greenhouse, name, claimed)) {
+        return plant;
+    }
+    // A listed species that is sold out is not swapped for a similar-sounding one.
+    if (PlantDatabase::find(name) != nullptr) {
+        return nullptr;
+    }
+    for (const PlantMatch& match : PlantDatabase::searchByName(name, 3)) {
+        if (Plant* plant = findAvailablePlant(greenhouse, match.plant->name, claimed)) {
+            console << "Cashier: taking \"" << name << "\" to mean " << match.plant->name << "\n";
+            return plant;
+        }
+    }
+    return nullptr;
+}
+
 } // namespace
 
 // -------------------- Cashier --------------------
@@ -57,22 +89,16 @@ bool Cashier::canHandle(Command* cmd) {
 void Cashier::process(Command* cmd) {
     RequestCommand* rCmd = dynamic_cast<RequestCommand*>(cmd);
     if(rCmd) {
-        std::cout << "Cashier handling request: " << rCmd->getMessage() << "\n";
+        getConsole() << "Cashier handling request: " << rCmd->getMessage() << "\n";
         if(rCmd->getRequestType() == COMPLAINT) {
-            std::cout << "Cashier responds to complaint: \"We understand your concerns, but have you considered taking your head out of your ass?\"";
+            getConsole() << "Cashier responds to complaint: \"We understand your concerns, but have you considered taking your head out of your ass?\"";
         }else if(rCmd->getRequestType() == ADVICE){
             AdviceCriteria crit = rCmd->getCriteria();
 
-        std::cout << "Cashier providing plant advice:\n";
+            getConsole() << "Cashier providing plant advice:\n";
 
-        for (const auto& plantPair : PlantDatabase::getAllPlants()) {
-            const std::string& name = plantPair.first;
-            const PlantInfo& info = plantPair.second;
-
-                if ((crit.sunlight == SunlightPreference::UNKNOWN || info.sunlight == crit.sunlight) &&
-                    (crit.water == WaterPreference::UNKNOWN || info.water == crit.water)) {
-                    std::cout << " - " << name << "\n";
-                }
+            for (const char* name : PlantDatabase::findByCare(crit.sunlight, crit.water)) {
+                getConsole() << " - " << name << "\n";
             }
         }
     }
@@ -82,18 +108,24 @@ void Cashier::process(Command* cmd) {
  * @brief Constructs a product using either bouquet or basic builders.
  */
 Product* Cashier::construct(const ProductRequest& req, GardenComponent* greenhouse) {//plants are added upon Builder construction
-   std::vector<Plant*> plants = buildPlantVector(req.plantNames);
+    return construct(req, buildPlantVector(req.plantNames), greenhouse, inventory);
+}
+
+/**
+ * @brief Builds and decorates a product from already selected plants.
+ */
+Product* Cashier::construct(const ProductRequest& req, const std::vector<Plant*>& plants,
+                            GardenComponent* greenhouse, Inventory* supplies) {
+    if (plants.empty()) {
+        return nullptr;
+    }
     Bob* builder = nullptr;
     if (plants.size() > 1) {
-        builder = new BouquetBuilder(plants, greenhouse);
+        builder = new BouquetBuilder(plants, greenhouse, supplies);
     } else {
-        builder = new BasicBuilder(plants, greenhouse);
+        builder = new BasicBuilder(plants, greenhouse, supplies);
     }
 
-    //error handling if not enough plants for bouquet
-    // builder->addPlant();
-    //builder->getProduct();
-
     Product* product = builder->getProduct();
     
     if (req.wantsCard) {
@@ -101,24 +133,59 @@ Product* Cashier::construct(const ProductRequest& req, GardenComponent* greenhou
     }
     
     if (req.wantsWrapping) {
-        product = new WrappingPaperDecorator(product, "Wrapping");
+        product = new WrappingPaperDecorator(product, kWrappingPaper);
     }
 
     delete builder;
     return product;
 }
 
+/**
+ * @brief Selects sellable plants for a request, skipping and recording claimed ones.
+ */
+std::vector<Plant*> Cashier::collectPlants(const ProductRequest& req, std::unordered_set<const Plant*>& claimed) {
+    std::vector<Plant*> result;
+    for (const std::string& name : req.plantNames) {
+        Plant* plant = findAvailableOrClosestPlant(greenhouse, name, getConsole(), &claimed);
+        if (plant) {
+            claimed.insert(plant);
+            result.push_back(plant);
+        } else {
+            getConsole() << "Sorry! We couldn't fulfil your order with the " << name << " plant\n";
+        }
+    }
+    return result;
+}
+
+/**
+ * @brief Lists the supplies a request consumes once built from @p plantCount plants.
+ */
+std::vector<SupplyLine> Cashier::requiredSupplies(const ProductRequest& req, std::size_t plantCount) const {
+    std::vector<SupplyLine> lines;
+    if (plantCount == 0) {
+        return lines;
+    }
+    lines = plantCount > 1 ? BouquetBuilder::requiredSupplies() : BasicBuilder::requiredSupplies();
+    if (req.wantsCard && !req.cardMessage.empty()) {
+        lines.push_back(SupplyLine{InventoryCategory::CARD, req.cardMessage, 1});
+    }
+    if (req.wantsWrapping) {
+        lines.push_back(SupplyLine{InventoryCategory::WRAPPER, kWrappingPaper, 1});
+    }
+    return lines;
+}
+
 /**
  * @brief Builds a vector of available plants that match requested names.
  */
 std::vector<Plant*> Cashier::buildPlantVector(const std::vector<std::string>& names) {
     std::vector<Plant*> result;
     for (const std::string& name : names) {
-        Plant* plant = findAvailablePlant(greenhouse, name);
+        Plant* plant = findAvailableOrClosestPlant(greenhouse, name, getConsole());
         if (plant) {
             result.push_back(plant);
         } else {
-            std::cout << "Sorry! We couldn't fulfil your order with the " << name << " plant\n";
+            getConsole() << "Sorry! We couldn't fulfil your order with the " << name << " plant\n";
         }
     }
     return result;
@@ -218,7 +285,7 @@ bool Manager::canHandle(Command* cmd) {
 void Manager::process(Command* cmd) {
     RequestCommand* rCmd = dynamic_cast<RequestCommand*>(cmd);
     if(rCmd) {
-        std::cout << "Manager handling request: " << rCmd->getMessage() << "\n";
+        getConsole() << "Manager handling request: " << rCmd->getMessage() << "\n";
         handleEscalation();
     }
 }
@@ -227,7 +294,7 @@ void Manager::process(Command* cmd) {
  * @brief Handles escalation tracking for the manager.
  */
 void Manager::handleEscalation() { numComplaints++; 
-    std::cout << "Manager responds to escalation: \"We understand you're concerns, but we lowkey don't gaf :). \"";
+    getConsole() << "Manager responds to escalation: \"We understand you're concerns, but we lowkey don't gaf :). \"";
 }
 
 // -------------------- Employee Factories --------------------
@@ -0,0 +1,125 @@
+/**
+ * @file eventEngine.cpp
+ * @brief Implements the event heap, clocks, and dispatch loop.
+ */
+#include "../headers/eventEngine.h"
+
+#include <algorithm>
+#include <chrono>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+namespace {
+
+/**
+ * @brief Heap order: the earliest time first, then the earliest scheduled.
+ */
+struct LaterEvent {
+    bool operator()(const SimEvent& a, const SimEvent& b) const {
+        return a.time != b.time ? a.time > b.time : a.sequence > b.sequence;
+    }
+};
+
+/**
+ * @brief Seconds on the steady clock.
+ */
+double wallSeconds() {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+} // namespace
+
+// -------------------- Clocks --------------------
+PacedClock::PacedClock(double minutesPerSecond) : rate(minutesPerSecond) {
+    if (!(minutesPerSecond > 0.0)) {
+        throw std::invalid_argument("Paced clock rate must be positive");
+    }
+}
+
+/**
+ * @brief Takes the first event as the origin, then sleeps off any lead over the wall clock.
+ */
+void PacedClock::advanceTo(SimTime time) {
+    if (!started) {
+        started = true;
+        origin = time;
+        wallOrigin = wallSeconds();
+    }
+    const double due = wallOrigin + (time - origin) / rate;
+    const double wait = due - wallSeconds();
+    if (wait > 0.0) {
+        std::this_thread::sleep_for(std::chrono::duration<double>(wait));
+    }
+    current = time;
+}
+
+// -------------------- EventEngine --------------------
+EventEngine::EventEngine() : clock(&virtualClock) {}
+
+void EventEngine::setClock(SimulationClock* replacement) {
+    clock = replacement != nullptr ? replacement : &virtualClock;
+}
+
+void EventEngine::on(std::uint32_t kind, Handler handler) {
+    if (kind >= handlers.size()) {
+        handlers.resize(kind + 1);
+    }
+    handlers[kind] = std::move(handler);
+}
+
+void EventEngine::schedule(SimTime time, std::uint32_t kind, std::uint32_t payload) {
+    if (time < clock->now()) {
+        throw std::invalid_argument("Cannot schedule an event in the past");
+    }
+    queue.push_back(SimEvent{time, nextSequence++, kind, payload});
+    std::push_heap(queue.begin(), queue.end(), LaterEvent());
+}
+
+void EventEngine::scheduleAfter(SimTime delay, std::uint32_t kind, std::uint32_t payload) {
+    schedule(clock->now() + delay, kind, payload);
+}
+
+/**
+ * @brief Pops the earliest event, advances the clock to it, and calls its handler.
+ */
+void EventEngine::dispatchNext() {
+    std::pop_heap(queue.begin(), queue.end(), LaterEvent());
+    const SimEvent event = queue.back();
+    queue.pop_back();
+    if (event.kind >= handlers.size() || !handlers[event.kind]) {
+        throw std::logic_error("No handler registered for event kind " + std::to_string(event.kind));
+    }
+    clock->advanceTo(event.time);
+    ++handled;
+    handlers[event.kind](event);
+}
+
+std::size_t EventEngine::run(SimTime until) {
+    std::size_t count = 0;
+    while (!queue.empty() && queue.front().time <= until) {
+        dispatchNext();
+        ++count;
+    }
+    return count;
+}
+
+bool EventEngine::step() {
+    if (queue.empty()) {
+        return false;
+    }
+    dispatchNext();
+    return true;
+}
+
+void EventEngine::reserve(std::size_t events) {
+    queue.reserve(events);
+}
+
+void EventEngine::clear() {
+    queue.clear();
+}
+
+SimTime EventEngine::now() const {
+    return clock->now();
+}
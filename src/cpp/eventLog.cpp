@@ -0,0 +1,126 @@
+/**
+ * @file eventLog.cpp
+ * @brief Implements the structured event log ring.
+ */
+#include "../headers/eventLog.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+/**
+ * @brief Allocates a power-of-two ring with one slot beyond the retained records.
+ *
+ * The spare slot is the one the writer fills next, so a reader never keeps a
+ * record the writer may be overwriting.
+ */
+EventLog::EventLog(std::size_t capacity) : head(0), floor(0), nameCount(0) {
+    if (capacity == 0) {
+        throw std::invalid_argument("Event log capacity must be positive");
+    }
+    std::size_t size = 1;
+    while (size <= capacity) {
+        size <<= 1;
+    }
+    slots.reset(new Slot[size]);
+    mask = size - 1;
+}
+
+/**
+ * @brief Fills the slot, then publishes it by advancing the end position.
+ *
+ * The release fence orders the previous end position before the slot stores:
+ * a reader that sees any of them is then bound to see that end position after
+ * its acquire fence, and rejects the torn copy.
+ */
+void EventLog::append(const LogRecord& record) {
+    const std::uint64_t position = head.load(std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    Slot& slot = slots[position & mask];
+    slot.type.store(static_cast<std::uint32_t>(record.type), std::memory_order_relaxed);
+    slot.day.store(record.day, std::memory_order_relaxed);
+    slot.subject.store(record.subject, std::memory_order_relaxed);
+    slot.name.store(record.name, std::memory_order_relaxed);
+    slot.value.store(record.value, std::memory_order_relaxed);
+    slot.extra.store(record.extra, std::memory_order_relaxed);
+    head.store(position + 1, std::memory_order_release);
+}
+
+/**
+ * @brief Copies the slot, then checks the writer had not reached it again.
+ *
+ * The writer only refills the slot, for position + capacity + 1, once the
+ * end position has reached that value. An end still below it after the copy
+ * therefore means the copy is intact.
+ */
+bool EventLog::read(std::uint64_t position, LogRecord& record) const {
+    if (position < floor.load(std::memory_order_acquire) || position >= end()) {
+        return false;
+    }
+    const Slot& slot = slots[position & mask];
+    record.type = static_cast<LogEvent>(slot.type.load(std::memory_order_relaxed));
+    record.day = slot.day.load(std::memory_order_relaxed);
+    record.subject = slot.subject.load(std::memory_order_relaxed);
+    record.name = slot.name.load(std::memory_order_relaxed);
+    record.value = slot.value.load(std::memory_order_relaxed);
+    record.extra = slot.extra.load(std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return head.load(std::memory_order_relaxed) - position <= capacity();
+}
+
+std::uint64_t EventLog::begin() const {
+    const std::uint64_t last = end();
+    const std::uint64_t retained = last > capacity() ? last - capacity() : 0;
+    return std::max(retained, floor.load(std::memory_order_acquire));
+}
+
+void EventLog::discardBefore(std::uint64_t position) {
+    floor.store(std::max(floor.load(std::memory_order_relaxed), std::min(position, end())), std::memory_order_release);
+}
+
+std::uint64_t EventLog::overwritten() const {
+    const std::uint64_t last = end();
+    return last > capacity() ? last - capacity() : 0;
+}
+
+void EventLog::locateName(std::uint32_t id, std::size_t& segment, std::size_t& offset) {
+    std::size_t size = kFirstNameSegment;
+    offset = id;
+    for (segment = 0; offset >= size; ++segment) {
+        offset -= size;
+        size <<= 1;
+    }
+}
+
+/**
+ * @brief Stores a new name in place, then publishes it by advancing the count.
+ */
+std::uint32_t EventLog::intern(const std::string& text) {
+    auto found = nameIds.find(text);
+    if (found != nameIds.end()) {
+        return found->second;
+    }
+    const std::uint32_t id = nameCount.load(std::memory_order_relaxed);
+    std::size_t segment = 0;
+    std::size_t offset = 0;
+    locateName(id, segment, offset);
+    if (segment >= kNameSegments) {
+        throw std::length_error("Event log name table is full");
+    }
+    if (!nameSegments[segment]) {
+        nameSegments[segment].reset(new std::string[kFirstNameSegment << segment]);
+    }
+    nameSegments[segment][offset] = text;
+    nameIds.emplace(text, id);
+    nameCount.store(id + 1, std::memory_order_release);
+    return id;
+}
+
+const std::string& EventLog::name(std::uint32_t id) const {
+    if (id >= nameCount.load(std::memory_order_acquire)) {
+        throw std::out_of_range("Unknown event log name id");
+    }
+    std::size_t segment = 0;
+    std::size_t offset = 0;
+    locateName(id, segment, offset);
+    return nameSegments[segment][offset];
+}
@@ -5,6 +5,7 @@
 #include "../headers/frontDesk.h"
 #include "../headers/employee.h"
 #include "../headers/Customer.h"
+#include "../headers/phaseProfile.h"
 
 /**
  * @brief Releases front desk resources, including queued commands.
@@ -96,11 +97,13 @@ void FrontDesk::executeAllCommands() {
             Caretaker* caretaker = getAvailableEmployee<Caretaker>();
             if (caretaker) {
                 cmd->execute(caretaker);
+                countCommandExecuted();
             }
         } else if (cmd->getType() == REQUEST_COMMAND) {
             Employee* emp = getAvailableEmployee<Employee>();
             if (emp) {
                 cmd->execute(emp);
+                countCommandExecuted();
             }
         }
         delete cmd;
@@ -135,6 +138,11 @@ bool FrontDesk::placeOrder(std::vector<ProductRequest>& requests, Customer* c){
     }
 
     currentOrder->finaliseOrder(greenhouse); //requests get handled here
+    if(currentOrder->getStatus() == CANCELLED) {
+        delete currentOrder;
+        currentOrder = nullptr;
+        return false;
+    }
     return true;
 }
 
@@ -4,13 +4,43 @@
  */
 #include "../headers/garden.h"
 #include "../headers/iterator.h"
+#include "../headers/plantStock.h"
 #include <algorithm>
+#include <atomic>
 #include <stdexcept>
 
+namespace {
+
+/** @brief Process-wide source of section revision stamps. */
+std::atomic<std::uint64_t> revisionCounter(0);
+
+/**
+ * @brief Issues a revision stamp never handed out before.
+ */
+std::uint64_t nextRevision() { return revisionCounter.fetch_add(1, std::memory_order_relaxed) + 1; }
+
+} // namespace
+
+/**
+ * @brief Creates an empty section stamped with a fresh revision.
+ */
+GardenSection::GardenSection() : revision(nextRevision()) {}
+
+/**
+ * @brief Destroys the section and any stock index it owns.
+ */
+GardenSection::~GardenSection() = default;
+
+/**
+ * @brief Stamps the section with a new revision after a mutation.
+ */
+void GardenSection::markChanged() { revision = nextRevision(); }
+
 /**
  * @brief Waters all child components in the section.
  */
 void GardenSection::waterPlant() {
+    markChanged();
     for (auto* child : children) {
         if (child != nullptr) {
             child->waterPlant();
@@ -22,6 +52,7 @@ void GardenSection::waterPlant() {
  * @brief Exposes child components to sunlight.
  */
 void GardenSection::exposeToSunlight() {
+    markChanged();
     for (auto* child : children) {
         if (child != nullptr) {
             child->exposeToSunlight();
@@ -33,6 +64,7 @@ void GardenSection::exposeToSunlight() {
  * @brief Applies water loss to child components.
  */
 void GardenSection::loseWater() {
+    markChanged();
     for (auto* child : children) {
         if (child != nullptr) {
             child->loseWater();
@@ -61,6 +93,7 @@ bool GardenSection::canSell() {
  * @brief Invokes growth on all child components.
  */
 void GardenSection::grow() {
+    markChanged();
     for (auto* child : children) {
         if (child != nullptr) {
             child->grow();
@@ -76,6 +109,10 @@ void GardenSection::add(GardenComponent* param) {
         throw std::invalid_argument("Cannot add null GardenComponent to GardenSection");
     }
     children.push_back(param);
+    if (stockIndex) {
+        param->setStockIndex(stockIndex);
+    }
+    markChanged();
 }
 
 /**
@@ -100,10 +137,57 @@ void GardenSection::remove(GardenComponent* param) {
     if (param == nullptr) {
         return;
     }
+    removeFromSubtree(param);
+}
+
+/**
+ * @brief Removes a component from this section or the first descendant holding it.
+ */
+bool GardenSection::removeFromSubtree(GardenComponent* param) {
     const auto it = std::find(children.begin(), children.end(), param);
     if (it != children.end()) {
         children.erase(it);
+        param->setStockIndex(nullptr);
+        markChanged();
+        return true;
+    }
+    for (auto* child : children) {
+        auto* subsection = child != nullptr && !child->isLeaf() ? dynamic_cast<GardenSection*>(child) : nullptr;
+        if (subsection != nullptr && subsection->removeFromSubtree(param)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Re-points the subtree at a stock index.
+ */
+void GardenSection::setStockIndex(PlantStockIndex* index) {
+    if (index == stockIndex) {
+        return;
+    }
+    stockIndex = index;
+    for (auto* child : children) {
+        if (child != nullptr) {
+            child->setStockIndex(index);
+        }
+    }
+    if (ownedIndex && ownedIndex.get() != index) {
+        ownedIndex.reset();
+    }
+}
+
+/**
+ * @brief Creates an owned stock index for the subtree when none is attached.
+ */
+PlantStockIndex& GardenSection::ensureStockIndex() {
+    if (stockIndex == nullptr) {
+        std::unique_ptr<PlantStockIndex> index(new PlantStockIndex());
+        setStockIndex(index.get());
+        ownedIndex = std::move(index);
     }
+    return *stockIndex;
 }
 
 /**
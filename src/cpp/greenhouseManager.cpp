@@ -5,8 +5,11 @@
 #include "../headers/greenhouseManager.h"
 
 #include "../headers/garden.h"
+#include "../headers/greenhouseView.h"
 #include "../headers/iterator.h"
+#include "../headers/phaseProfile.h"
 #include "../headers/plant.h"
+#include "../headers/plantStock.h"
 
 #include <stdexcept>
 #include <utility> 
@@ -28,6 +31,21 @@ GreenHouseManager::GreenHouseManager(GardenSection* rootSection, std::string roo
         throw std::invalid_argument("GreenHouseManager requires a non-null root section");
     }
     indexSection(rootName, root);
+    root->ensureStockIndex();
+}
+
+/**
+ * @brief Exposes the root's incrementally maintained plant counts.
+ */
+const PlantStockIndex& GreenHouseManager::getPlantStock() const {
+    return root->ensureStockIndex();
+}
+
+/**
+ * @brief Reports how many mature plants of a species can be sold.
+ */
+int GreenHouseManager::countSellable(const std::string& name) const {
+    return getPlantStock().sellable(name);
 }
 
 /**
@@ -88,6 +106,7 @@ Plant* GreenHouseManager::find(const std::string& name) const {
 
     PlantOnlyIterator iterator(root);
     for (GardenComponent* component = iterator.first(); component != nullptr; component = iterator.next()) {
+        countPlantVisits(1);
         auto* plant = dynamic_cast<Plant*>(component);
         if (plant != nullptr && plant->getName() == name) {
             return plant;
@@ -96,6 +115,28 @@ Plant* GreenHouseManager::find(const std::string& name) const {
     return nullptr;
 }
 
+/**
+ * @brief Falls back to ranked fuzzy catalog matches when the name is not a listed species.
+ */
+Plant* GreenHouseManager::findClosest(const std::string& name) const {
+    if (Plant* plant = find(name)) {
+        return plant;
+    }
+#if GREENHOUSE_HAS_PLANT_DATABASE
+    if (PlantDatabase::find(name) != nullptr) {
+        return nullptr;
+    }
+    const PlantStockIndex& stock = getPlantStock();
+    for (const PlantMatch& match : PlantDatabase::searchByName(name)) {
+        const PlantStockCounts* counts = stock.find(match.plant->name);
+        if (counts != nullptr && counts->total() > 0) {
+            return find(match.plant->name);
+        }
+    }
+#endif
+    return nullptr;
+}
+
 /**
  * @brief Finds a plant by name that is currently mature.
  */
@@ -141,6 +182,7 @@ void GreenHouseManager::clearAllDead() {
     std::vector<Plant*> deadPlants;
     PlantOnlyIterator iterator(root);
     for (GardenComponent* component = iterator.first(); component != nullptr; component = iterator.next()) {
+        countPlantVisits(1);
         auto* plant = dynamic_cast<Plant*>(component);
         if (plant != nullptr && plant->isDead()) {
             deadPlants.push_back(plant);
@@ -151,6 +193,89 @@ void GreenHouseManager::clearAllDead() {
     }
 }
 
+/**
+ * @brief Public lookup of a section by name.
+ */
+GardenSection* GreenHouseManager::getSection(const std::string& sectionName) const {
+    return findSection(sectionName);
+}
+
+/**
+ * @brief Exposes the section index for traversal and persistence.
+ */
+const std::unordered_map<std::string, GardenSection*>& GreenHouseManager::getSectionIndex() const {
+    return sectionIndex;
+}
+
+/**
+ * @brief Returns the root section's friendly name.
+ */
+const std::string& GreenHouseManager::getRootName() const { return rootName; }
+
+/**
+ * @brief Captures a structurally shared view of the current greenhouse.
+ */
+std::shared_ptr<const GreenhouseView> GreenHouseManager::snapshot(int dayIndex) {
+    std::unordered_map<const GardenSection*, const std::string*> names;
+    for (const auto& entry : sectionIndex) {
+        names[entry.second] = &entry.first;
+    }
+    std::unordered_map<const GardenSection*, std::shared_ptr<const SectionView>> nextCache;
+    std::shared_ptr<const SectionView> rootView = captureSection(root, names, nextCache);
+    viewCache.swap(nextCache);
+    return std::make_shared<const GreenhouseView>(rootView, dayIndex);
+}
+
+/**
+ * @brief Captures one section, copying plant state only when the section changed.
+ */
+std::shared_ptr<const SectionView> GreenHouseManager::captureSection(
+    GardenSection* section, const std::unordered_map<const GardenSection*, const std::string*>& names,
+    std::unordered_map<const GardenSection*, std::shared_ptr<const SectionView>>& nextCache) {
+    const std::vector<GardenComponent*> children = section->getChildren();
+    std::vector<std::shared_ptr<const SectionView>> childViews;
+    for (GardenComponent* child : children) {
+        if (!child->isLeaf()) {
+            if (auto* subsection = dynamic_cast<GardenSection*>(child)) {
+                childViews.push_back(captureSection(subsection, names, nextCache));
+            }
+        }
+    }
+
+    const auto cached = viewCache.find(section);
+    if (cached != viewCache.end() && cached->second->revision == section->getRevision() &&
+        cached->second->children == childViews) {
+        nextCache[section] = cached->second;
+        return cached->second;
+    }
+
+    auto view = std::make_shared<SectionView>();
+    const auto nameIt = names.find(section);
+    if (nameIt != names.end()) {
+        view->name = *nameIt->second;
+    }
+    view->revision = section->getRevision();
+    view->children.swap(childViews);
+    for (GardenComponent* child : children) {
+        if (!child->isLeaf()) {
+            continue;
+        }
+        if (auto* plant = dynamic_cast<Plant*>(child)) {
+            PlantView plantView;
+            plantView.name = plant->getName();
+            plantView.price = plant->getPrice();
+            plantView.waterLevel = plant->getWaterLevel();
+            plantView.age = plant->getAge();
+            plantView.lifecycle = plant->getLifecycle();
+            plantView.location = plant->getLocation();
+            view->plants.push_back(plantView);
+        }
+    }
+    std::shared_ptr<const SectionView> frozen = view;
+    nextCache[section] = frozen;
+    return frozen;
+}
+
 /**
  * @brief Retrieves a section by name if present.
  */
@@ -187,10 +312,8 @@ std::string GreenHouseManager::resolveSectionForPlant(const Plant* plant) const
         return {};
     }
 #if GREENHOUSE_HAS_PLANT_DATABASE
-    const auto& entries = PlantDatabase::getAllPlants();
-    const auto it = entries.find(plant->getName());
-    if (it != entries.end()) {
-        return it->second.section;
+    if (const PlantRecord* record = PlantDatabase::find(plant->getName())) {
+        return record->section;
     }
 #endif
     return {};
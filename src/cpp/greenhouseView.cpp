@@ -0,0 +1,77 @@
+/**
+ * @file greenhouseView.cpp
+ * @brief Implements read-only reports over captured greenhouse views.
+ */
+#include "../headers/greenhouseView.h"
+
+#include <utility>
+
+namespace {
+
+/**
+ * @brief Adds a section's plants, and those of its unnamed descendants, to a named bucket.
+ */
+void countStock(const SectionView& section, const std::string& bucket, std::map<std::string, std::size_t>& counts) {
+    counts[bucket] += section.plants.size();
+    for (const auto& child : section.children) {
+        countStock(*child, child->name.empty() ? bucket : child->name, counts);
+    }
+}
+
+} // namespace
+
+/**
+ * @brief Stores the captured root and its day index.
+ */
+GreenhouseView::GreenhouseView(std::shared_ptr<const SectionView> root, int dayIndex)
+    : root(std::move(root)), dayIndex(dayIndex) {}
+
+/**
+ * @brief Counts every plant reachable from the root.
+ */
+std::size_t GreenhouseView::plantCount() const {
+    std::size_t total = 0;
+    std::vector<const SectionView*> pending(1, root.get());
+    while (!pending.empty()) {
+        const SectionView* section = pending.back();
+        pending.pop_back();
+        total += section->plants.size();
+        for (const auto& child : section->children) {
+            pending.push_back(child.get());
+        }
+    }
+    return total;
+}
+
+/**
+ * @brief Produces per-section stock counts.
+ */
+std::map<std::string, std::size_t> GreenhouseView::stockBySection() const {
+    std::map<std::string, std::size_t> counts;
+    countStock(*root, root->name, counts);
+    return counts;
+}
+
+/**
+ * @brief Buckets plants by water level.
+ */
+std::vector<std::size_t> GreenhouseView::waterDistribution(std::size_t buckets) const {
+    std::vector<std::size_t> histogram(buckets, 0);
+    if (buckets == 0) {
+        return histogram;
+    }
+    std::vector<const SectionView*> pending(1, root.get());
+    while (!pending.empty()) {
+        const SectionView* section = pending.back();
+        pending.pop_back();
+        for (const PlantView& plant : section->plants) {
+            double level = plant.waterLevel < 0.0 ? 0.0 : (plant.waterLevel > 1.0 ? 1.0 : plant.waterLevel);
+            std::size_t bucket = static_cast<std::size_t>(level * static_cast<double>(buckets));
+            histogram[bucket < buckets ? bucket : buckets - 1]++;
+        }
+        for (const auto& child : section->children) {
+            pending.push_back(child.get());
+        }
+    }
+    return histogram;
+}
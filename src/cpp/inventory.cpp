@@ -3,38 +3,77 @@
  * @brief Implements stock management for greenhouse supplies.
  */
 #include "../headers/inventory.h"
+#include "../headers/garden.h"
+#include "../headers/inventoryJournal.h"
+#include "../headers/iterator.h"
+#include "../headers/phaseProfile.h"
+#include "../headers/plant.h"
+#include "../headers/plantStock.h"
+#include "../headers/restockQueue.h"
+
+#include <algorithm>
 
 /**
  * @brief Constructs the inventory bound to a greenhouse composite.
  */
-Inventory::Inventory(GardenComponent *plants) : plants(plants) {}
+Inventory::Inventory(GardenComponent *plants) : plants(plants) {
+    static_assert(sizeof(StockSlot) == kCacheLineSize && alignof(StockSlot) == kCacheLineSize,
+                  "Stock slots must fill exactly one cache line");
+}
+
+/**
+ * @brief Resolves the mutable name index backing a category.
+ */
+std::unordered_map<std::string, SkuId>& Inventory::indexForCategory(const InventoryCategory category) {
+    if (category == InventoryCategory::PLANT) {
+        throw std::invalid_argument("NO Supporting Inventory Map For Category");
+    }
+    return skuIndex[static_cast<int>(category)];
+}
 
 /**
- * @brief Resolves the mutable map backing a category.
+ * @brief Resolves the const name index backing a category.
  */
-std::map<std::string, int>& Inventory::mapForCategory(const InventoryCategory category) {
-    switch (category) {
-        case InventoryCategory::CARD : return cards;
-        case InventoryCategory::CONTAINER: return containers;
-        case InventoryCategory::SOIL : return soil;
-        case InventoryCategory::WRAPPER : return wrappers;
-        case InventoryCategory::PLANT : break ;
+const std::unordered_map<std::string, SkuId>& Inventory::indexForCategory(const InventoryCategory category) const {
+    if (category == InventoryCategory::PLANT) {
+        throw std::invalid_argument("NO Supporting Inventory Map For Category");
     }
-    throw std::invalid_argument("NO Supporting Inventory Map For Category");
+    return skuIndex[static_cast<int>(category)];
+}
+
+/**
+ * @brief Checks that a SKU id lies inside the registry.
+ */
+bool Inventory::isValidSku(const SkuId sku) const {
+    return sku >= 0 && static_cast<std::size_t>(sku) < slots.size();
+}
+
+/**
+ * @brief Looks up a stock line's SKU id.
+ */
+SkuId Inventory::findSku(const InventoryCategory category, const std::string& item) const {
+    const auto& index = indexForCategory(category);
+    const auto it = index.find(item);
+    return it == index.end() ? kInvalidSku : it->second;
 }
 
 /**
- * @brief Resolves the const map backing a category.
+ * @brief Looks up or registers a stock line's SKU id.
  */
-const std::map<std::string, int>& Inventory::mapForCategory(const InventoryCategory category) const {
-    switch (category) {
-        case InventoryCategory::CARD : return cards;
-        case InventoryCategory::CONTAINER: return containers;
-        case InventoryCategory::SOIL : return soil;
-        case InventoryCategory::WRAPPER : return wrappers;
-        case InventoryCategory::PLANT : break ;
+SkuId Inventory::registerSku(const InventoryCategory category, const std::string& item) {
+    auto& index = indexForCategory(category);
+    const auto it = index.find(item);
+    if (it != index.end()) {
+        return it->second;
+    }
+    if (concurrent) {
+        throw std::logic_error("Inventory registry is frozen while concurrent mode is enabled");
     }
-    throw std::invalid_argument("NO Supporting Inventory Map For Category");
+    const SkuId sku = static_cast<SkuId>(skus.size());
+    skus.push_back(SkuInfo{category, item});
+    slots.emplace_back();
+    index.emplace(item, sku);
+    return sku;
 }
 
 /**
@@ -45,12 +84,13 @@ bool Inventory::addStock(const InventoryCategory category, const std::string& it
         return false;
     }
     if (category == InventoryCategory::PLANT) {
-        //Todo :: Use plant composite to add plant stock
+        // Plants enter stock by being added to the greenhouse composite.
         return false ;
     }
-    auto& map = mapForCategory(category) ;
-    map[item] += quantity ;
-    return true ;
+    if (concurrent) {
+        return addStock(findSku(category, item), quantity);
+    }
+    return addStock(registerSku(category, item), quantity);
 };
 
 
@@ -62,19 +102,9 @@ bool Inventory::useItem(const InventoryCategory category, const std::string& ite
         return false;
     }
     if (category == InventoryCategory::PLANT) {
-        //Todo :: Use plant composite to remove plant stock
-        return false ;
+        return sellPlants(item, quantity);
     }
-    auto& map = mapForCategory(category) ;
-    const auto it = map.find(item) ;
-    if (it == map.end()) {
-        return false;
-    }
-    if (quantity > it->second) {
-        return false;
-    }
-    it->second -= quantity ;
-    return true ;
+    return useItem(findSku(category, item), quantity);
 };
 
 
@@ -83,11 +113,11 @@ bool Inventory::useItem(const InventoryCategory category, const std::string& ite
  */
 bool Inventory::itemExists(const InventoryCategory category, const std::string& item) const {
     if (category  == InventoryCategory::PLANT) {
-        //TODO :: Use plant composite to check if plant exists
-        return false;
+        const PlantStockIndex* index = plantStock();
+        const PlantStockCounts* counts = index ? index->find(item) : nullptr;
+        return counts != nullptr && counts->total() > 0;
     }
-    const auto& m = mapForCategory(category);
-    return m.find(item) != m.end();
+    return findSku(category, item) != kInvalidSku;
 };
 
 
@@ -96,12 +126,334 @@ bool Inventory::itemExists(const InventoryCategory category, const std::string&
  */
 int  Inventory::getQuantity(const InventoryCategory category, const std::string& item) const {
     if (category == InventoryCategory::PLANT) {
-        //Todo :: Use plant composite to check quantity of plant
+        const PlantStockIndex* index = plantStock();
+        const PlantStockCounts* counts = index ? index->find(item) : nullptr;
+        return counts ? counts->mature : -1;
     }
-    const auto& map = mapForCategory(category);
-    const auto it = map.find(item);
-    if (it == map.end()) {
-        return -1;
-    }
-    return it->second;
+    return getQuantity(findSku(category, item));
 };
+
+/**
+ * @brief Resolves the stock index the bound greenhouse already maintains.
+ */
+PlantStockIndex* Inventory::plantStock() const {
+    const auto* section = dynamic_cast<const GardenSection*>(plants);
+    return section ? section->getStockIndex() : nullptr;
+}
+
+/**
+ * @brief Removes and destroys sellable plants of a species.
+ */
+bool Inventory::sellPlants(const std::string& item, const int quantity) {
+    const PlantStockIndex* index = plantStock();
+    if (index == nullptr || index->sellable(item) < quantity) {
+        return false;
+    }
+    std::vector<Plant*> sold;
+    PlantOnlyIterator iterator(plants);
+    for (GardenComponent* component = iterator.first();
+         component != nullptr && static_cast<int>(sold.size()) < quantity; component = iterator.next()) {
+        countPlantVisits(1);
+        auto* plant = dynamic_cast<Plant*>(component);
+        if (plant != nullptr && plant->getName() == item && plant->canSell()) {
+            sold.push_back(plant);
+        }
+    }
+    for (Plant* plant : sold) {
+        plants->remove(plant);
+        delete plant;
+    }
+    return true;
+}
+
+/**
+ * @brief Adds units to a SKU slot.
+ */
+bool Inventory::addStock(const SkuId sku, const int quantity) {
+    if (quantity < 0 || !isValidSku(sku)) {
+        return false;
+    }
+    putUnits(sku, quantity);
+    if (journal) {
+        journal->recordDelta(sku, quantity);
+    }
+    return true;
+}
+
+/**
+ * @brief Deducts units from a SKU slot when enough remain.
+ */
+bool Inventory::useItem(const SkuId sku, const int quantity) {
+    if (quantity < 0) {
+        return false;
+    }
+    if (!isValidSku(sku)) {
+        unknownSkuRequests.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    StockSlot& slot = slots[static_cast<std::size_t>(sku)];
+    int before = 0;
+    if (!takeUnits(sku, quantity, before)) {
+        slot.shortages.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    slot.consumed.fetch_add(quantity, std::memory_order_relaxed);
+    notifyIfCrossed(sku, before, before - quantity);
+    if (journal) {
+        journal->recordDelta(sku, -quantity);
+    }
+    return true;
+}
+
+/**
+ * @brief Removes units from a valid slot, never letting it go below zero.
+ */
+bool Inventory::takeUnits(const SkuId sku, const int quantity, int& before) {
+    std::atomic<int>& count = slots[static_cast<std::size_t>(sku)].quantity;
+    int available = count.load(std::memory_order_relaxed);
+    if (concurrent) {
+        // Retry until the deduction lands on an unchanged count or stock runs out.
+        while (quantity <= available &&
+               !count.compare_exchange_weak(available, available - quantity, std::memory_order_relaxed)) {
+        }
+        if (quantity > available) {
+            return false;
+        }
+    } else {
+        if (quantity > available) {
+            return false;
+        }
+        count.store(available - quantity, std::memory_order_relaxed);
+    }
+    // The successful swap saw the exact prior count, so only one thread observes the crossing.
+    before = available;
+    return true;
+}
+
+/**
+ * @brief Pushes a restock event when a deduction went from above the mark to at or below it.
+ */
+void Inventory::notifyIfCrossed(const SkuId sku, const int before, const int after) {
+    const int threshold = slots[static_cast<std::size_t>(sku)].lowWaterMark.load(std::memory_order_relaxed);
+    if (threshold < 0 || before <= threshold || after > threshold || restockQueue == nullptr) {
+        return;
+    }
+    RestockEvent event;
+    event.sku = sku;
+    event.quantity = after;
+    event.threshold = threshold;
+    if (!restockQueue->tryPush(event)) {
+        droppedRestockEvents.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+/**
+ * @brief Sets the low-water mark of a registered SKU.
+ */
+bool Inventory::setLowWaterMark(const SkuId sku, const int threshold) {
+    if (!isValidSku(sku)) {
+        return false;
+    }
+    slots[static_cast<std::size_t>(sku)].lowWaterMark.store(threshold < 0 ? -1 : threshold,
+                                                            std::memory_order_relaxed);
+    return true;
+}
+
+/**
+ * @brief Sets the low-water mark of a named stock line.
+ */
+bool Inventory::setLowWaterMark(const InventoryCategory category, const std::string& item, const int threshold) {
+    return setLowWaterMark(findSku(category, item), threshold);
+}
+
+/**
+ * @brief Reads the low-water mark of a SKU.
+ */
+int Inventory::getLowWaterMark(const SkuId sku) const {
+    return isValidSku(sku) ? slots[static_cast<std::size_t>(sku)].lowWaterMark.load(std::memory_order_relaxed) : -1;
+}
+
+/**
+ * @brief Puts units back into a valid slot.
+ */
+void Inventory::putUnits(const SkuId sku, const int quantity) {
+    std::atomic<int>& count = slots[static_cast<std::size_t>(sku)].quantity;
+    if (concurrent) {
+        count.fetch_add(quantity, std::memory_order_relaxed);
+    } else {
+        count.store(count.load(std::memory_order_relaxed) + quantity, std::memory_order_relaxed);
+    }
+}
+
+/**
+ * @brief Applies a journaled delta without the checks of a live update.
+ */
+bool Inventory::adjustUnits(const SkuId sku, const int delta) {
+    if (!isValidSku(sku)) {
+        return false;
+    }
+    putUnits(sku, delta);
+    return true;
+}
+
+/**
+ * @brief Resolves, merges, and holds every line of an order.
+ */
+bool Inventory::reserve(const std::vector<SupplyLine>& lines, SupplyReservation& reservation) {
+    if (reservation.isActive()) {
+        throw std::logic_error("Reservation already holds supplies");
+    }
+    std::vector<std::pair<SkuId, int>> wanted;
+    wanted.reserve(lines.size());
+    for (const SupplyLine& line : lines) {
+        const SkuId sku = findSku(line.category, line.item);
+        if (sku == kInvalidSku || line.quantity < 0) {
+            unknownSkuRequests.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        wanted.push_back(std::make_pair(sku, line.quantity));
+    }
+    std::sort(wanted.begin(), wanted.end());
+    std::vector<std::pair<SkuId, int>> merged;
+    for (const auto& entry : wanted) {
+        if (!merged.empty() && merged.back().first == entry.first) {
+            merged.back().second += entry.second;
+        } else {
+            merged.push_back(entry);
+        }
+    }
+
+    std::vector<int> takenFrom(merged.size());
+    for (std::size_t i = 0; i < merged.size(); ++i) {
+        if (!takeUnits(merged[i].first, merged[i].second, takenFrom[i])) {
+            slots[static_cast<std::size_t>(merged[i].first)].shortages.fetch_add(1, std::memory_order_relaxed);
+            while (i-- > 0) {
+                putUnits(merged[i].first, merged[i].second);
+            }
+            return false;
+        }
+    }
+    reservation.owner = this;
+    reservation.held.swap(merged);
+    reservation.takenFrom.swap(takenFrom);
+    return true;
+}
+
+/**
+ * @brief Counts held units as consumed, raises the crossings they caused, and settles the reservation.
+ */
+void Inventory::commit(SupplyReservation& reservation) {
+    if (reservation.owner != this) {
+        return;
+    }
+    for (std::size_t i = 0; i < reservation.held.size(); ++i) {
+        const SkuId sku = reservation.held[i].first;
+        const int units = reservation.held[i].second;
+        slots[static_cast<std::size_t>(sku)].consumed.fetch_add(units, std::memory_order_relaxed);
+        notifyIfCrossed(sku, reservation.takenFrom[i], reservation.takenFrom[i] - units);
+        if (journal) {
+            journal->recordDelta(sku, -units);
+        }
+    }
+    reservation.owner = nullptr;
+    reservation.held.clear();
+    reservation.takenFrom.clear();
+}
+
+/**
+ * @brief Returns held units to stock and settles the reservation.
+ */
+void Inventory::release(SupplyReservation& reservation) {
+    if (reservation.owner != this) {
+        return;
+    }
+    for (const auto& entry : reservation.held) {
+        putUnits(entry.first, entry.second);
+    }
+    reservation.owner = nullptr;
+    reservation.held.clear();
+    reservation.takenFrom.clear();
+}
+
+/**
+ * @brief Releases units still held when a reservation goes out of scope.
+ */
+SupplyReservation::~SupplyReservation() {
+    if (owner) {
+        owner->release(*this);
+    }
+}
+
+/**
+ * @brief Reads a SKU slot.
+ */
+int Inventory::getQuantity(const SkuId sku) const {
+    return isValidSku(sku) ? slots[static_cast<std::size_t>(sku)].quantity.load(std::memory_order_relaxed) : -1;
+}
+
+/**
+ * @brief Sums units consumed across all SKUs.
+ */
+long long Inventory::getUnitsConsumed() const {
+    long long total = 0;
+    for (const StockSlot& slot : slots) {
+        total += slot.consumed.load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+/**
+ * @brief Sums refused deductions across all SKUs plus unknown-SKU requests.
+ */
+long long Inventory::getShortageCount() const {
+    long long total = unknownSkuRequests.load(std::memory_order_relaxed);
+    for (const StockSlot& slot : slots) {
+        total += slot.shortages.load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+/**
+ * @brief Reports how many SKUs have been registered.
+ */
+std::size_t Inventory::skuCount() const { return skus.size(); }
+
+/**
+ * @brief Reports the category of a SKU.
+ */
+InventoryCategory Inventory::skuCategory(const SkuId sku) const {
+    if (!isValidSku(sku)) {
+        throw std::out_of_range("Unknown SKU id");
+    }
+    return skus[static_cast<std::size_t>(sku)].category;
+}
+
+/**
+ * @brief Reports the item name of a SKU.
+ */
+const std::string& Inventory::skuName(const SkuId sku) const {
+    if (!isValidSku(sku)) {
+        throw std::out_of_range("Unknown SKU id");
+    }
+    return skus[static_cast<std::size_t>(sku)].name;
+}
+
+/**
+ * @brief Enumerates the items tracked for a category.
+ */
+std::vector<std::pair<std::string, int>> Inventory::listItems(const InventoryCategory category) const {
+    std::vector<std::pair<std::string, int>> items;
+    if (category == InventoryCategory::PLANT) {
+        if (const PlantStockIndex* index = plantStock()) {
+            for (const std::string& name : index->species()) {
+                items.push_back(std::make_pair(name, index->sellable(name)));
+            }
+        }
+        return items;
+    }
+    for (const auto& entry : indexForCategory(category)) {
+        items.push_back(std::make_pair(entry.first, getQuantity(entry.second)));
+    }
+    std::sort(items.begin(), items.end());
+    return items;
+}
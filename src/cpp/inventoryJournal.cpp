@@ -0,0 +1,302 @@
+/**
+ * @file inventoryJournal.cpp
+ * @brief Implements the group-committed Inventory journal and its checkpoints.
+ */
+#include "../headers/inventoryJournal.h"
+
+#include <cstring>
+#include <fcntl.h>
+#include <stdexcept>
+#include <unistd.h>
+#include <vector>
+
+namespace {
+
+constexpr char kJournalMagic[8] = {'G', 'H', 'J', 'R', 'N', 'L', '0', '1'};
+constexpr char kCheckpointMagic[8] = {'G', 'H', 'C', 'K', 'P', 'T', '0', '1'};
+constexpr std::uint32_t kJournalVersion = 2;
+/** Magic, byte-order marker, version, and generation. */
+constexpr std::size_t kJournalHeaderBytes = sizeof(kJournalMagic) + 2 * sizeof(std::uint32_t) + sizeof(std::uint64_t);
+/** Payload length and checksum preceding every frame. */
+constexpr std::size_t kFrameHeaderBytes = 2 * sizeof(std::uint32_t);
+
+/** Checksum of the SKU table following a checkpoint header. */
+constexpr std::size_t kCheckpointChecksumBytes = sizeof(std::uint32_t);
+
+/** @brief Record tags inside a journal frame. */
+enum JournalRecord : std::uint8_t { DEFINE_SKU = 1, STOCK_DELTA = 2 };
+
+/**
+ * @brief Validates a magic/byte-order/version header and returns its generation.
+ */
+std::uint64_t readHeader(ByteReader& in, const char (&magic)[8], const std::string& path) {
+    if (in.remaining() < kJournalHeaderBytes || std::memcmp(in.take(sizeof(magic)), magic, sizeof(magic)) != 0) {
+        throw std::runtime_error("Not an inventory journal file: " + path);
+    }
+    if (in.get<std::uint32_t>() != kByteOrderMarker) {
+        throw std::runtime_error("Inventory journal was written on a host with a different byte order: " + path);
+    }
+    if (in.get<std::uint32_t>() != kJournalVersion) {
+        throw std::runtime_error("Unsupported inventory journal version: " + path);
+    }
+    return in.get<std::uint64_t>();
+}
+
+/**
+ * @brief Reads a supply category byte; plants are tracked by the greenhouse, never the journal.
+ * @throws std::runtime_error With @p message when the byte names no supply category.
+ */
+InventoryCategory readSupplyCategory(ByteReader& in, const char* message) {
+    const auto category = in.getEnum(InventoryCategory::WRAPPER, message);
+    if (category == InventoryCategory::PLANT) {
+        throw std::runtime_error(message);
+    }
+    return category;
+}
+
+/**
+ * @brief Appends a magic/byte-order/version/generation header.
+ */
+void writeHeader(ByteWriter& out, const char (&magic)[8], std::uint64_t generation) {
+    out.putBytes(magic, sizeof(magic));
+    out.put(kByteOrderMarker);
+    out.put(kJournalVersion);
+    out.put(generation);
+}
+
+} // namespace
+
+/**
+ * @brief Recovers the inventory and opens the journal for appending.
+ */
+InventoryJournal::InventoryJournal(Inventory& inventory, const std::string& basePath, std::size_t commitBatch)
+    : inventory(inventory),
+      journalPath(basePath + ".journal"),
+      checkpointPath(basePath + ".checkpoint"),
+      commitBatch(commitBatch == 0 ? 1 : commitBatch) {
+    if (inventory.skuCount() != 0) {
+        throw std::logic_error("Inventory journal must recover into an empty inventory");
+    }
+    recover();
+    inventory.setJournal(this);
+}
+
+/**
+ * @brief Commits any buffered records and closes the journal.
+ */
+InventoryJournal::~InventoryJournal() {
+    inventory.setJournal(nullptr);
+    try {
+        flush();
+    } catch (...) {
+        // Destructors must not throw; unflushed records are lost like any crash.
+    }
+    if (fd >= 0) {
+        ::close(fd);
+    }
+}
+
+/**
+ * @brief Loads the checkpoint, replays the journal of the same generation, and reopens it.
+ */
+void InventoryJournal::recover() {
+    if (fileExists(checkpointPath)) {
+        const std::vector<char> image = readFileBytes(checkpointPath);
+        ByteReader in(image.data(), image.size());
+        generation = readHeader(in, kCheckpointMagic, checkpointPath);
+        const std::uint32_t expected = in.get<std::uint32_t>();
+        if (frameChecksum(image.data() + image.size() - in.remaining(), in.remaining()) != expected) {
+            throw std::runtime_error("Inventory checkpoint is corrupt: " + checkpointPath);
+        }
+        const std::uint32_t lines = in.get<std::uint32_t>();
+        for (std::uint32_t i = 0; i < lines; ++i) {
+            const auto category = readSupplyCategory(in, "Inventory checkpoint supply category is corrupt");
+            const std::string name = in.getString();
+            const std::int32_t quantity = in.get<std::int32_t>();
+            inventory.addStock(inventory.registerSku(category, name), quantity);
+        }
+        stats.checkpointLines = lines;
+    }
+
+    std::size_t validBytes = 0;
+    if (fileExists(journalPath)) {
+        const std::vector<char> image = readFileBytes(journalPath);
+        ByteReader in(image.data(), image.size());
+        if (image.size() >= kJournalHeaderBytes && readHeader(in, kJournalMagic, journalPath) == generation) {
+            validBytes = replay(image);
+        }
+    }
+    definedSkus = inventory.skuCount();
+    openJournal(validBytes);
+}
+
+/**
+ * @brief Applies every intact frame and stops at the first torn or corrupt one.
+ */
+std::size_t InventoryJournal::replay(const std::vector<char>& image) {
+    std::size_t offset = kJournalHeaderBytes;
+    while (image.size() - offset >= kFrameHeaderBytes) {
+        ByteReader frameHeader(image.data() + offset, kFrameHeaderBytes);
+        const std::uint32_t payloadBytes = frameHeader.get<std::uint32_t>();
+        const std::uint32_t expected = frameHeader.get<std::uint32_t>();
+        const char* payload = image.data() + offset + kFrameHeaderBytes;
+        if (payloadBytes > image.size() - offset - kFrameHeaderBytes || frameChecksum(payload, payloadBytes) != expected) {
+            break;
+        }
+        ByteReader in(payload, payloadBytes);
+        while (!in.atEnd()) {
+            const auto tag = in.get<std::uint8_t>();
+            const SkuId sku = in.get<std::int32_t>();
+            if (tag == DEFINE_SKU) {
+                const auto category = readSupplyCategory(in, "Inventory journal supply category is corrupt");
+                if (inventory.registerSku(category, in.getString()) != sku) {
+                    throw std::runtime_error("Inventory journal defines SKUs out of order: " + journalPath);
+                }
+            } else if (tag == STOCK_DELTA) {
+                // Deltas are journaled after the update they record, so their order may differ from the order
+                // concurrent updates applied in; only the sum is meaningful, so apply each one unchecked.
+                if (!inventory.adjustUnits(sku, in.get<std::int32_t>())) {
+                    throw std::runtime_error("Inventory journal references an undefined SKU: " + journalPath);
+                }
+                stats.replayedRecords++;
+            } else {
+                throw std::runtime_error("Unknown inventory journal record: " + journalPath);
+            }
+        }
+        offset += kFrameHeaderBytes + payloadBytes;
+    }
+    return offset;
+}
+
+/**
+ * @brief Opens the journal, keeping its valid prefix or starting a new generation file.
+ */
+void InventoryJournal::openJournal(std::size_t validBytes) {
+    if (fd >= 0) {
+        ::close(fd);
+        fd = -1;
+    }
+    if (validBytes >= kJournalHeaderBytes) {
+        fd = ::open(journalPath.c_str(), O_WRONLY);
+        if (fd < 0 || ::ftruncate(fd, static_cast<off_t>(validBytes)) != 0 ||
+            ::lseek(fd, 0, SEEK_END) < 0) {
+            throw std::runtime_error("Cannot reopen inventory journal: " + journalPath);
+        }
+        return;
+    }
+    ByteWriter header;
+    writeHeader(header, kJournalMagic, generation);
+    replaceFileDurably(journalPath, header.bytes());
+    fd = ::open(journalPath.c_str(), O_WRONLY | O_APPEND);
+    if (fd < 0) {
+        throw std::runtime_error("Cannot open inventory journal: " + journalPath);
+    }
+}
+
+/**
+ * @brief Buffers a delta and commits the batch once it is full.
+ */
+void InventoryJournal::recordDelta(SkuId sku, int delta) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (pendingRecords == 0) {
+        pending.extend(kFrameHeaderBytes);
+    }
+    if (static_cast<std::size_t>(sku) >= definedSkus) {
+        defineNewSkus();
+    }
+    pending.put(static_cast<std::uint8_t>(STOCK_DELTA));
+    pending.put(static_cast<std::int32_t>(sku));
+    pending.put(static_cast<std::int32_t>(delta));
+    pendingRecords++;
+    stats.appendedRecords++;
+    recordsSinceCheckpoint++;
+    if (pendingRecords >= commitBatch) {
+        flushLocked();
+        if (checkpointInterval != 0 && recordsSinceCheckpoint >= checkpointInterval && !inventory.isConcurrent()) {
+            checkpointLocked();
+        }
+    }
+}
+
+/**
+ * @brief Emits definitions for SKUs registered after the last one journaled.
+ */
+void InventoryJournal::defineNewSkus() {
+    const std::size_t registered = inventory.skuCount();
+    for (; definedSkus < registered; ++definedSkus) {
+        const auto sku = static_cast<SkuId>(definedSkus);
+        pending.put(static_cast<std::uint8_t>(DEFINE_SKU));
+        pending.put(static_cast<std::int32_t>(sku));
+        pending.put(static_cast<std::uint8_t>(inventory.skuCategory(sku)));
+        pending.putString(inventory.skuName(sku));
+    }
+}
+
+/**
+ * @brief Commits the pending frame.
+ */
+void InventoryJournal::flush() {
+    std::lock_guard<std::mutex> lock(mutex);
+    flushLocked();
+}
+
+/**
+ * @brief Seals the pending frame, writes it with one call, and syncs it.
+ */
+void InventoryJournal::flushLocked() {
+    if (pendingRecords == 0) {
+        return;
+    }
+    const char* payload = pending.bytes().data() + kFrameHeaderBytes;
+    const std::size_t payloadBytes = pending.size() - kFrameHeaderBytes;
+    pending.patch(0, static_cast<std::uint32_t>(payloadBytes));
+    pending.patch(sizeof(std::uint32_t), frameChecksum(payload, payloadBytes));
+    writeAllBytes(fd, pending.bytes().data(), pending.size());
+    syncFileData(fd);
+    pending.clear();
+    pendingRecords = 0;
+    stats.commits++;
+}
+
+/**
+ * @brief Writes a checkpoint and resets the journal.
+ */
+void InventoryJournal::checkpoint() {
+    std::lock_guard<std::mutex> lock(mutex);
+    checkpointLocked();
+}
+
+/**
+ * @brief Stores the SKU table under the next generation, then starts its empty journal.
+ */
+void InventoryJournal::checkpointLocked() {
+    flushLocked();
+    ByteWriter out;
+    writeHeader(out, kCheckpointMagic, generation + 1);
+    const std::size_t bodyStart = out.size() + kCheckpointChecksumBytes;
+    out.extend(kCheckpointChecksumBytes);
+    const std::size_t lines = inventory.skuCount();
+    out.put(static_cast<std::uint32_t>(lines));
+    for (std::size_t i = 0; i < lines; ++i) {
+        const auto sku = static_cast<SkuId>(i);
+        out.put(static_cast<std::uint8_t>(inventory.skuCategory(sku)));
+        out.putString(inventory.skuName(sku));
+        out.put(static_cast<std::int32_t>(inventory.getQuantity(sku)));
+    }
+    out.patch(bodyStart - kCheckpointChecksumBytes,
+              frameChecksum(out.bytes().data() + bodyStart, out.size() - bodyStart));
+    replaceFileDurably(checkpointPath, out.bytes());
+    generation++;
+    definedSkus = lines;
+    openJournal(0);
+    recordsSinceCheckpoint = 0;
+    stats.checkpoints++;
+}
+
+/**
+ * @brief Copies the activity counters.
+ */
+JournalStats InventoryJournal::getStats() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return stats;
+}
@@ -2,13 +2,29 @@
  * @file main.cpp
  * @brief Entry point launching the text user interface.
  */
+#include "../headers/plantDatabase.h"
 #include "../headers/tui.h"
 
+#include <iostream>
+#include <stdexcept>
+
 /**
  * @brief Program entry that initializes and runs the console interface.
+ *
+ * An optional first argument names a CSV plant catalog that replaces the
+ * built-in species table.
  * @return Exit status code.
  */
-int main() {
+int main(int argc, char** argv) {
+    if (argc > 1) {
+        try {
+            const std::size_t species = PlantDatabase::loadCatalog(argv[1]);
+            std::cout << "Loaded " << species << " species from " << argv[1] << "\n";
+        } catch (const std::runtime_error& error) {
+            std::cerr << error.what() << "\n";
+            return 1;
+        }
+    }
     TUI tui;
     tui.consoleLog();
     return 0;
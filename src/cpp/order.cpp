@@ -7,6 +7,7 @@
 #include "../headers/productBuilder.h"
 #include <sstream>
 #include <iostream>
+#include <unordered_set>
 /**
  * @brief Initializes an order with a cashier and customer name.
  */
@@ -59,19 +60,50 @@ void Order::updateStatus(OrderStatus s) {
 
 /**
  * @brief Builds requested products and adds them to the order.
+ *
+ * Plants are selected for every request first, then all supplies are reserved
+ * in one step; a shortage cancels the order before anything is built.
  */
 void Order::finaliseOrder(GardenComponent* greenhouse) {
+    Inventory* supplies = cashier->getInventory();
+    std::unordered_set<const Plant*> claimed;
+    std::vector<std::vector<Plant*>> plantsPerRequest;
+    std::vector<SupplyLine> needed;
+    plantsPerRequest.reserve(requests.size());
     for(const auto& req : requests) {
-        Product* product = cashier->construct(req, greenhouse);
+        plantsPerRequest.push_back(cashier->collectPlants(req, claimed));
+        std::vector<SupplyLine> lines = cashier->requiredSupplies(req, plantsPerRequest.back().size());
+        needed.insert(needed.end(), lines.begin(), lines.end());
+    }
+
+    SupplyReservation reservation;
+    if(supplies && !supplies->reserve(needed, reservation)) {
+        cashier->getConsole() << "Sorry! We are out of supplies for " << customerName << "'s order\n";
+        updateStatus(CANCELLED);
+        return;
+    }
+
+    for(std::size_t i = 0; i < requests.size(); ++i) {
+        Product* product = cashier->construct(requests[i], plantsPerRequest[i], greenhouse, nullptr);
         if(product) {
             addProduct(product);
         }else{
            // TODO error handling for product that couldn't be made
         }
     }
+    if(supplies) {
+        supplies->commit(reservation);
+    }
     updateStatus(PROCESSING);
 }
 
+/**
+ * @brief Reports the order's lifecycle state.
+ */
+OrderStatus Order::getStatus() const {
+    return status;
+}
+
 /**
  * @brief Stores a product request for later processing.
  */
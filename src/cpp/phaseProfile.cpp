@@ -0,0 +1,49 @@
+/**
+ * @file phaseProfile.cpp
+ * @brief Implements phase timers.
+ */
+#include "../headers/phaseProfile.h"
+
+thread_local PhaseCounters* activePhaseCounters = nullptr;
+
+bool allocationCountingLinked = false;
+
+const char* dayPhaseName(DayPhase phase) {
+    switch (phase) {
+        case DayPhase::SCHEDULE_MAINTENANCE:
+            return "schedule_maintenance";
+        case DayPhase::MAINTENANCE_COMMANDS:
+            return "maintenance_commands";
+        case DayPhase::CUSTOMERS:
+            return "customers";
+        case DayPhase::CUSTOMER_COMMANDS:
+            return "customer_commands";
+        case DayPhase::CLEAR_DEAD:
+            return "clear_dead";
+    }
+    return "unknown";
+}
+
+/**
+ * @brief Redirects the thread's counting to this timer.
+ */
+PhaseTimer::PhaseTimer(PhaseStats* target) : target(target), outer(activePhaseCounters) {
+    if (target) {
+        activePhaseCounters = &counted;
+        start = std::chrono::steady_clock::now();
+    }
+}
+
+/**
+ * @brief Folds the timer into its phase and hands counting back to the enclosing timer.
+ */
+PhaseTimer::~PhaseTimer() {
+    if (!target) {
+        return;
+    }
+    target->elapsedMs += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    activePhaseCounters = outer;
+    target->counters.plantsVisited += counted.plantsVisited;
+    target->counters.allocations += counted.allocations;
+    target->counters.commandsExecuted += counted.commandsExecuted;
+}
@@ -5,12 +5,27 @@
 #include <utility>
 
 #include "../headers/plant.h"
+#include "../headers/phaseProfile.h"
+#include "../headers/plantStock.h"
 #include <stdexcept>
 //planstate->plant = null;
 Plant::Plant(std::string  name , const double price , WaterLossStrategy* waterLossStrategy , SunlightStrategy* sunlightStrategy , PlantState* state) : waterLossStrategy(waterLossStrategy) , sunlightStrategy(sunlightStrategy) , location(PlantLocation::INSIDE) , name(std::move(name)) , state(state) , price(price) , waterLevel(1), age(0)  {
     state->setPlant(this);
 }
 
+Plant::Plant(const Plant& other)
+    : GardenComponent(other),
+      waterLossStrategy(createWaterLossStrategy(other.getWaterPreference())),
+      sunlightStrategy(createSunlightStrategy(other.getSunlightPreference())),
+      location(other.location),
+      name(other.name),
+      state(createPlantState(other.getLifecycle())),
+      price(other.price),
+      waterLevel(other.waterLevel),
+      age(other.age) {
+    state->setPlant(this);
+}
+
 Plant::~Plant() {
     delete waterLossStrategy;
     delete sunlightStrategy;
@@ -18,15 +33,18 @@ Plant::~Plant() {
 }
 
 void Plant::waterPlant(){
+    countPlantVisits(1);
     state->handleWaterPlant() ;
     if (waterLevel > 1.0) {
         this->setState(new DeadState(this)) ;
     }
 }
 void Plant::exposeToSunlight() {
+    countPlantVisits(1);
     state->handleExposeToSunlight() ;
 }
 void Plant::loseWater() {
+    countPlantVisits(1);
     state->handleLoseWater();
     if (waterLevel < 0.0) {
         this->setState(new DeadState(this)) ;
@@ -44,6 +62,7 @@ void Plant::addWater(const double amount) {
 }
 
 void Plant::grow() { 
+    countPlantVisits(1);
     this->age += 2;
     state->handleGrow(); 
     if (age > 60) {
@@ -70,23 +89,40 @@ void Plant::applyWaterLoss() {
 }
 
 void Plant::setState(PlantState* newState) {
+    const PlantLifecycle previous = state->lifecycle();
     delete this->state;
     this->state = newState;
+    if (stockIndex) {
+        stockIndex->lifecycleChanged(name, previous, state->lifecycle());
+    }
 }
 
-// SunlightPreference Plant::getSunlightPreference() const {
-//     if (dynamic_cast<LowSunlightStrategy*>(sunlightStrategy)) return SunlightPreference::LOW;
-//     if (dynamic_cast<MedSunlightStrategy*>(sunlightStrategy)) return SunlightPreference::MEDIUM;
-//     if (dynamic_cast<HighSunlightStrategy*>(sunlightStrategy)) return SunlightPreference::HIGH;
-//     return SunlightPreference::UNKNOWN;
-// }
+void Plant::setStockIndex(PlantStockIndex* index) {
+    if (index == stockIndex) {
+        return;
+    }
+    if (stockIndex) {
+        stockIndex->untrack(*this);
+    }
+    stockIndex = index;
+    if (stockIndex) {
+        stockIndex->track(*this);
+    }
+}
+
+SunlightPreference Plant::getSunlightPreference() const {
+    if (dynamic_cast<LowSunlightStrategy*>(sunlightStrategy)) return SunlightPreference::LOW;
+    if (dynamic_cast<MedSunlightStrategy*>(sunlightStrategy)) return SunlightPreference::MEDIUM;
+    if (dynamic_cast<HighSunlightStrategy*>(sunlightStrategy)) return SunlightPreference::HIGH;
+    return SunlightPreference::UNKNOWN;
+}
 
-// WaterPreference Plant::getWaterPreference() const {
-//     if (dynamic_cast<LowWaterLoss*>(waterLossStrategy)) return WaterPreference::LOW;
-//     if (dynamic_cast<MedWaterLoss*>(waterLossStrategy)) return WaterPreference::MEDIUM;
-//     if (dynamic_cast<HighWaterLoss*>(waterLossStrategy)) return WaterPreference::HIGH;
-//     return WaterPreference::UNKNOWN;
-// }
+WaterPreference Plant::getWaterPreference() const {
+    if (dynamic_cast<LowWaterLoss*>(waterLossStrategy)) return WaterPreference::LOW;
+    if (dynamic_cast<MedWaterLoss*>(waterLossStrategy)) return WaterPreference::MEDIUM;
+    if (dynamic_cast<HighWaterLoss*>(waterLossStrategy)) return WaterPreference::HIGH;
+    return WaterPreference::UNKNOWN;
+}
 
 void Plant::tryGrow() {
     
@@ -100,14 +136,61 @@ double Plant:: getPrice(){return price;}
 
 const std::string& Plant::getName() const { return name; }
 
-bool Plant::isMature() const { return dynamic_cast<MatureState*>(state) != nullptr; }
+bool Plant::isMature() const { return state->lifecycle() == PlantLifecycle::MATURE; }
 
-bool Plant::isDead() const { return dynamic_cast<DeadState*>(state) != nullptr; }
+bool Plant::isDead() const { return state->lifecycle() == PlantLifecycle::DEAD; }
 
 bool Plant::isLeaf() const {
     return true;
 }
 
+PlantLifecycle Plant::getLifecycle() const { return state->lifecycle(); }
+
+double Plant::getWaterLevel() const { return waterLevel; }
+
+int Plant::getAge() const { return age; }
+
+PlantLocation Plant::getLocation() const { return location; }
+
+void Plant::restoreCondition(const double water, const int plantAge, const PlantLocation plantLocation) {
+    waterLevel = water;
+    age = plantAge;
+    location = plantLocation;
+}
+
+WaterLossStrategy* createWaterLossStrategy(WaterPreference preference) {
+    switch (preference) {
+        case WaterPreference::LOW:
+            return new LowWaterLoss();
+        case WaterPreference::HIGH:
+            return new HighWaterLoss();
+        default:
+            return new MedWaterLoss();
+    }
+}
+
+SunlightStrategy* createSunlightStrategy(SunlightPreference preference) {
+    switch (preference) {
+        case SunlightPreference::LOW:
+            return new LowSunlightStrategy();
+        case SunlightPreference::HIGH:
+            return new HighSunlightStrategy();
+        default:
+            return new MedSunlightStrategy();
+    }
+}
+
+PlantState* createPlantState(PlantLifecycle lifecycle) {
+    switch (lifecycle) {
+        case PlantLifecycle::MATURE:
+            return new MatureState(nullptr);
+        case PlantLifecycle::DEAD:
+            return new DeadState(nullptr);
+        default:
+            return new SeedlingState(nullptr);
+    }
+}
+
 
 double LowWaterLoss::loseWater() { return kLossAmount; }
 
@@ -202,3 +285,9 @@ bool SeedlingState::canSell() { return false; }
 bool MatureState::canSell() { return true; }
 
 bool DeadState::canSell() { return false; }
+
+PlantLifecycle SeedlingState::lifecycle() const { return PlantLifecycle::SEEDLING; }
+
+PlantLifecycle MatureState::lifecycle() const { return PlantLifecycle::MATURE; }
+
+PlantLifecycle DeadState::lifecycle() const { return PlantLifecycle::DEAD; }
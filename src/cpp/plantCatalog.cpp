@@ -0,0 +1,213 @@
+/**
+ * @file plantCatalog.cpp
+ * @brief Implements the compiled-in and runtime plant catalogs.
+ */
+#include "../headers/plantCatalog.h"
+
+#include <stdexcept>
+
+namespace {
+
+/** @brief Compiled-in species, sorted by name. */
+constexpr PlantRecord kBuiltinPlants[] = {
+    {"aloe vera",        "succulent", SunlightPreference::HIGH,   WaterPreference::LOW,    "aloe|medicinal aloe"},
+    {"basil",            "herb",      SunlightPreference::HIGH,   WaterPreference::HIGH,   "sweet basil"},
+    {"bird of paradise", "tropical",  SunlightPreference::HIGH,   WaterPreference::MEDIUM, "strelitzia"},
+    {"cactus",           "succulent", SunlightPreference::HIGH,   WaterPreference::LOW,    "cacti"},
+    {"echeveria",        "succulent", SunlightPreference::HIGH,   WaterPreference::LOW,    "hens and chicks"},
+    {"haworthia",        "succulent", SunlightPreference::MEDIUM, WaterPreference::LOW,    "zebra plant"},
+    {"hydrangea",        "flowering", SunlightPreference::LOW,    WaterPreference::HIGH,   "hortensia"},
+    {"jade plant",       "succulent", SunlightPreference::HIGH,   WaterPreference::LOW,    "money tree|crassula"},
+    {"lavender",         "flowering", SunlightPreference::HIGH,   WaterPreference::LOW,    "lavandula"},
+    {"mint",             "herb",      SunlightPreference::MEDIUM, WaterPreference::HIGH,   "spearmint|peppermint"},
+    {"monstera",         "tropical",  SunlightPreference::MEDIUM, WaterPreference::MEDIUM, "swiss cheese plant"},
+    {"orchid",           "flowering", SunlightPreference::LOW,    WaterPreference::MEDIUM, "phalaenopsis|moth orchid"},
+    {"oregano",          "herb",      SunlightPreference::HIGH,   WaterPreference::LOW,    "wild marjoram"},
+    {"peace lily",       "tropical",  SunlightPreference::LOW,    WaterPreference::HIGH,   "spathiphyllum"},
+    {"philodendron",     "tropical",  SunlightPreference::MEDIUM, WaterPreference::MEDIUM, ""},
+    {"pothos",           "tropical",  SunlightPreference::LOW,    WaterPreference::MEDIUM, "devil's ivy|golden pothos"},
+    {"rose",             "flowering", SunlightPreference::HIGH,   WaterPreference::MEDIUM, ""},
+    {"rosemary",         "herb",      SunlightPreference::HIGH,   WaterPreference::LOW,    ""},
+    {"sunflower",        "flowering", SunlightPreference::HIGH,   WaterPreference::HIGH,   "helianthus"},
+    {"thyme",            "herb",      SunlightPreference::HIGH,   WaterPreference::LOW,    ""},
+};
+
+constexpr std::size_t kBuiltinCount = sizeof(kBuiltinPlants) / sizeof(kBuiltinPlants[0]);
+/** log2 of the slot count; at least four slots per species keeps the seed search short. */
+constexpr unsigned kSlotBits = 7;
+constexpr std::size_t kSlotCount = std::size_t(1) << kSlotBits;
+static_assert(kBuiltinCount * 4 <= kSlotCount, "Grow kSlotBits with the built-in table");
+/** Seeds tried before the compiler gives up on finding a perfect hash. */
+constexpr std::uint32_t kMaxSeed = 4096;
+
+constexpr std::size_t textLength(const char* text) {
+    return *text == '\0' ? 0 : 1 + textLength(text + 1);
+}
+
+constexpr int compareText(const char* a, const char* b) {
+    return (*a != *b || *a == '\0') ? static_cast<unsigned char>(*a) - static_cast<unsigned char>(*b)
+                                    : compareText(a + 1, b + 1);
+}
+
+constexpr bool sortedFrom(std::size_t i) {
+    return i + 1 >= kBuiltinCount ? true
+                                  : compareText(kBuiltinPlants[i].name, kBuiltinPlants[i + 1].name) < 0 &&
+                                        sortedFrom(i + 1);
+}
+static_assert(sortedFrom(0), "Built-in plants must be sorted by name without duplicates");
+
+constexpr std::uint32_t builtinHash(std::size_t i) {
+    return plantNameHash(kBuiltinPlants[i].name, textLength(kBuiltinPlants[i].name));
+}
+
+/** Multiplicative mix of a name hash and a seed into a slot index. */
+constexpr std::size_t slotFor(std::uint32_t hash, std::uint32_t seed) {
+    return static_cast<std::uint32_t>((hash ^ seed) * 2654435761u) >> (32 - kSlotBits);
+}
+
+constexpr bool distinctFrom(std::size_t i, std::size_t j, std::uint32_t seed) {
+    return j >= kBuiltinCount ? true
+                              : slotFor(builtinHash(i), seed) != slotFor(builtinHash(j), seed) &&
+                                    distinctFrom(i, j + 1, seed);
+}
+
+constexpr bool perfectFrom(std::size_t i, std::uint32_t seed) {
+    return i >= kBuiltinCount ? true : distinctFrom(i, i + 1, seed) && perfectFrom(i + 1, seed);
+}
+
+constexpr std::uint32_t findSeed(std::uint32_t seed) {
+    return seed >= kMaxSeed ? throw std::logic_error("No perfect hash seed for the built-in plants")
+                            : perfectFrom(0, seed) ? seed : findSeed(seed + 1);
+}
+
+/** Seed giving every built-in species its own slot, found by the compiler. */
+constexpr std::uint32_t kSeed = findSeed(0);
+
+constexpr std::int8_t entryForSlot(std::size_t slot, std::size_t i = 0) {
+    return i >= kBuiltinCount ? -1
+                              : slotFor(builtinHash(i), kSeed) == slot ? static_cast<std::int8_t>(i)
+                                                                        : entryForSlot(slot, i + 1);
+}
+
+template <std::size_t... I> struct IndexList {};
+template <std::size_t N, std::size_t... I> struct MakeIndexList : MakeIndexList<N - 1, N - 1, I...> {};
+template <std::size_t... I> struct MakeIndexList<0, I...> {
+    using type = IndexList<I...>;
+};
+
+/** @brief Slot-to-species table expanded at compile time; -1 marks an empty slot. */
+template <typename Slots> struct SlotTable;
+template <std::size_t... S> struct SlotTable<IndexList<S...>> {
+    static constexpr std::int8_t entries[sizeof...(S)] = {entryForSlot(S)...};
+};
+template <std::size_t... S> constexpr std::int8_t SlotTable<IndexList<S...>>::entries[sizeof...(S)];
+
+using BuiltinSlots = SlotTable<MakeIndexList<kSlotCount>::type>;
+
+} // namespace
+
+// -------------------- BuiltinPlantCatalog --------------------
+/**
+ * @brief Reports the number of compiled-in species.
+ */
+std::size_t BuiltinPlantCatalog::size() const {
+    return kBuiltinCount;
+}
+
+/**
+ * @brief Returns a compiled-in species by position.
+ */
+const PlantRecord& BuiltinPlantCatalog::record(std::size_t index) const {
+    if (index >= kBuiltinCount) {
+        throw std::out_of_range("Plant catalog index out of range");
+    }
+    return kBuiltinPlants[index];
+}
+
+/**
+ * @brief Resolves a name with one probe of the perfect hash table.
+ */
+const PlantRecord* BuiltinPlantCatalog::find(const std::string& name) const {
+    const std::int8_t entry = BuiltinSlots::entries[slotFor(plantNameHash(name.data(), name.size()), kSeed)];
+    if (entry < 0 || name != kBuiltinPlants[entry].name) {
+        return nullptr;
+    }
+    return &kBuiltinPlants[entry];
+}
+
+/**
+ * @brief Materialises the compiled-in species as a map on first use.
+ */
+const std::map<std::string, PlantInfo>& BuiltinPlantCatalog::asMap() const {
+    static const std::map<std::string, PlantInfo> plants = [] {
+        std::map<std::string, PlantInfo> built;
+        for (const PlantRecord& plant : kBuiltinPlants) {
+            built.emplace_hint(built.end(), plant.name,
+                               PlantInfo{plant.section, plant.sunlight, plant.water, plant.aliases});
+        }
+        return built;
+    }();
+    return plants;
+}
+
+// -------------------- RuntimePlantCatalog --------------------
+/**
+ * @brief Adopts the species map and builds records plus a linear-probing name table.
+ */
+RuntimePlantCatalog::RuntimePlantCatalog(std::map<std::string, PlantInfo> species) : plants(std::move(species)) {
+    records.reserve(plants.size());
+    std::size_t slotCount = 1;
+    while (slotCount < plants.size() * 2) {
+        slotCount <<= 1;
+    }
+    slots.assign(slotCount, 0);
+    const std::size_t mask = slotCount - 1;
+    for (const auto& entry : plants) {
+        records.push_back(PlantRecord{entry.first.c_str(), entry.second.section.c_str(), entry.second.sunlight,
+                                      entry.second.water, entry.second.aliases.c_str()});
+        std::size_t slot = plantNameHash(entry.first.data(), entry.first.size()) & mask;
+        while (slots[slot] != 0) {
+            slot = (slot + 1) & mask;
+        }
+        slots[slot] = static_cast<std::uint32_t>(records.size());
+    }
+}
+
+/**
+ * @brief Reports the number of loaded species.
+ */
+std::size_t RuntimePlantCatalog::size() const {
+    return records.size();
+}
+
+/**
+ * @brief Returns a loaded species by position.
+ */
+const PlantRecord& RuntimePlantCatalog::record(std::size_t index) const {
+    return records.at(index);
+}
+
+/**
+ * @brief Probes the name table until the name or an empty slot is found.
+ */
+const PlantRecord* RuntimePlantCatalog::find(const std::string& name) const {
+    if (slots.empty()) {
+        return nullptr;
+    }
+    const std::size_t mask = slots.size() - 1;
+    for (std::size_t slot = plantNameHash(name.data(), name.size()) & mask; slots[slot] != 0;
+         slot = (slot + 1) & mask) {
+        const PlantRecord& candidate = records[slots[slot] - 1];
+        if (name == candidate.name) {
+            return &candidate;
+        }
+    }
+    return nullptr;
+}
+
+/**
+ * @brief Exposes the owned species map.
+ */
+const std::map<std::string, PlantInfo>& RuntimePlantCatalog::asMap() const {
+    return plants;
+}
@@ -1,44 +1,352 @@
 /**
  * @file plantDatabase.cpp
- * @brief Defines the static plant database used for lookup.
+ * @brief Implements catalog selection, CSV loading, and the advice index.
  */
 #include "../headers/plantDatabase.h"
 
-/** @brief Static map containing predefined plant metadata. */
-static std::map<std::string, PlantInfo> PLANTS = {
-
-    // ----------------- SUCCULENTS -----------------
-    { "cactus",           { "succulent", SunlightPreference::HIGH,   WaterPreference::LOW } },
-    { "aloe vera",        { "succulent", SunlightPreference::HIGH,   WaterPreference::LOW } },
-    { "jade plant",       { "succulent", SunlightPreference::HIGH,   WaterPreference::LOW } },
-    { "haworthia",        { "succulent", SunlightPreference::MEDIUM, WaterPreference::LOW } },
-    { "echeveria",        { "succulent", SunlightPreference::HIGH,   WaterPreference::LOW } },
-
-    // ----------------- TROPICAL -----------------
-    { "monstera",         { "tropical",  SunlightPreference::MEDIUM, WaterPreference::MEDIUM } },
-    { "philodendron",     { "tropical",  SunlightPreference::MEDIUM, WaterPreference::MEDIUM } },
-    { "pothos",           { "tropical",  SunlightPreference::LOW,    WaterPreference::MEDIUM } },
-    { "bird of paradise", { "tropical",  SunlightPreference::HIGH,   WaterPreference::MEDIUM } },
-    { "peace lily",       { "tropical",  SunlightPreference::LOW,    WaterPreference::HIGH } },
-
-    // ----------------- HERBS -----------------
-    { "basil",            { "herb",      SunlightPreference::HIGH,   WaterPreference::HIGH } },
-    { "mint",             { "herb",      SunlightPreference::MEDIUM, WaterPreference::HIGH } },
-    { "rosemary",         { "herb",      SunlightPreference::HIGH,   WaterPreference::LOW } },
-    { "thyme",            { "herb",      SunlightPreference::HIGH,   WaterPreference::LOW } },
-    { "oregano",          { "herb",      SunlightPreference::HIGH,   WaterPreference::LOW } },
-
-    // ----------------- FLOWERING -----------------
-    { "rose",             { "flowering", SunlightPreference::HIGH,   WaterPreference::MEDIUM } },
-    { "lavender",         { "flowering", SunlightPreference::HIGH,   WaterPreference::LOW } },
-    { "orchid",           { "flowering", SunlightPreference::LOW,    WaterPreference::MEDIUM } },
-    { "sunflower",        { "flowering", SunlightPreference::HIGH,   WaterPreference::HIGH } },
-    { "hydrangea",        { "flowering", SunlightPreference::LOW,    WaterPreference::HIGH } }
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <utility>
+
+namespace {
+
+/** Distinct values of each preference enumeration, UNKNOWN included. */
+constexpr int kPreferenceLevels = 4;
+
+/**
+ * @brief Species lists for every (sunlight, water) combination, UNKNOWN as wildcard.
+ */
+class CareIndex {
+  public:
+    explicit CareIndex(const PlantCatalog& catalog) {
+        for (std::size_t i = 0; i < catalog.size(); ++i) {
+            const PlantRecord& plant = catalog.record(i);
+            const int sun = static_cast<int>(plant.sunlight);
+            const int water = static_cast<int>(plant.water);
+            // An exact profile is matched by its own bucket and by the wildcard buckets.
+            buckets[bucket(sun, water)].push_back(plant.name);
+            if (water != 0) {
+                buckets[bucket(sun, 0)].push_back(plant.name);
+            }
+            if (sun != 0) {
+                buckets[bucket(0, water)].push_back(plant.name);
+            }
+            if (sun != 0 && water != 0) {
+                buckets[bucket(0, 0)].push_back(plant.name);
+            }
+        }
+    }
+
+    const PlantNameList& find(SunlightPreference sunlight, WaterPreference water) const {
+        return buckets[bucket(static_cast<int>(sunlight), static_cast<int>(water))];
+    }
+
+  private:
+    static int bucket(int sun, int water) { return sun * kPreferenceLevels + water; }
+
+    PlantNameList buckets[kPreferenceLevels * kPreferenceLevels];
+};
+
+} // namespace
+
+/** @brief Installed catalog; the built-in table is used while empty. */
+static std::unique_ptr<const PlantCatalog> loadedCatalog;
+/** @brief Care index over @ref loadedCatalog. */
+static std::unique_ptr<const CareIndex> loadedCareIndex;
+/** @brief Trigram index over the active catalog, built by the first search. */
+static std::unique_ptr<const PlantNameIndex> nameIndex;
+/** @brief Guards the lazy construction of @ref nameIndex. */
+static std::mutex nameIndexMutex;
+
+namespace {
+
+/**
+ * @brief The compiled-in catalog; it holds no data, so construction is free.
+ */
+const BuiltinPlantCatalog& builtinCatalog() {
+    static const BuiltinPlantCatalog catalog;
+    return catalog;
+}
+
+/**
+ * @brief Care index over the built-in table, built on first use.
+ */
+const CareIndex& builtinCareIndex() {
+    static const CareIndex index(builtinCatalog());
+    return index;
+}
+
+/**
+ * @brief Read-only memory mapping of a whole file, unmapped on destruction.
+ */
+class MappedFile {
+  public:
+    explicit MappedFile(const std::string& path) {
+        const int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            throw std::runtime_error("Cannot open plant catalog " + path + ": " + std::strerror(errno));
+        }
+        struct stat info;
+        if (::fstat(fd, &info) != 0) {
+            const int error = errno;
+            ::close(fd);
+            throw std::runtime_error("Cannot stat plant catalog " + path + ": " + std::strerror(error));
+        }
+        size = static_cast<std::size_t>(info.st_size);
+        if (size > 0) {
+            void* mapped = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (mapped == MAP_FAILED) {
+                const int error = errno;
+                ::close(fd);
+                throw std::runtime_error("Cannot map plant catalog " + path + ": " + std::strerror(error));
+            }
+            ::madvise(mapped, size, MADV_SEQUENTIAL);
+            data = static_cast<const char*>(mapped);
+        }
+        ::close(fd);
+    }
+    ~MappedFile() {
+        if (data) {
+            ::munmap(const_cast<char*>(data), size);
+        }
+    }
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    const char* data = nullptr;
+    std::size_t size = 0;
+};
+
+/** @brief Unowned view of a field inside the mapped file. */
+struct Field {
+    const char* begin;
+    const char* end;
+
+    bool empty() const { return begin == end; }
+    std::size_t size() const { return static_cast<std::size_t>(end - begin); }
 };
 
+/**
+ * @brief Strips spaces, tabs, and carriage returns from both ends of a field.
+ */
+Field trim(Field field) {
+    while (field.begin < field.end && (*field.begin == ' ' || *field.begin == '\t')) {
+        ++field.begin;
+    }
+    while (field.end > field.begin && (field.end[-1] == ' ' || field.end[-1] == '\t' || field.end[-1] == '\r')) {
+        --field.end;
+    }
+    return field;
+}
+
+/**
+ * @brief Compares a field with a lowercase keyword, ignoring ASCII case.
+ */
+bool equalsIgnoreCase(Field field, const char* keyword) {
+    const std::size_t length = std::strlen(keyword);
+    if (field.size() != length) {
+        return false;
+    }
+    for (std::size_t i = 0; i < length; ++i) {
+        char c = field.begin[i];
+        if (c >= 'A' && c <= 'Z') {
+            c = static_cast<char>(c - 'A' + 'a');
+        }
+        if (c != keyword[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Decodes a low/medium/high/unknown level; returns false for anything else.
+ */
+template <typename Level> bool parseLevel(Field field, Level& level) {
+    if (field.empty() || equalsIgnoreCase(field, "unknown")) {
+        level = Level::UNKNOWN;
+    } else if (equalsIgnoreCase(field, "low")) {
+        level = Level::LOW;
+    } else if (equalsIgnoreCase(field, "medium")) {
+        level = Level::MEDIUM;
+    } else if (equalsIgnoreCase(field, "high")) {
+        level = Level::HIGH;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Throws the error reported for a malformed catalog line.
+ */
+[[noreturn]] void malformed(const std::string& path, std::size_t lineNumber, const std::string& reason) {
+    throw std::runtime_error("Plant catalog " + path + " line " + std::to_string(lineNumber) + ": " + reason);
+}
+
+} // namespace
+
 /**
  * @brief Provides read-only access to the plant metadata map.
  */
 const std::map<std::string, PlantInfo>& PlantDatabase::getAllPlants() {
-    return PLANTS;
+    return catalog().asMap();
+}
+
+/**
+ * @brief Returns the installed catalog or the built-in one.
+ */
+const PlantCatalog& PlantDatabase::catalog() {
+    return loadedCatalog ? *loadedCatalog : builtinCatalog();
+}
+
+/**
+ * @brief Resolves a species through the active catalog's hash table.
+ */
+const PlantRecord* PlantDatabase::find(const std::string& name) {
+    return catalog().find(name);
+}
+
+/**
+ * @brief Returns the precomputed species list for a care profile.
+ */
+const PlantNameList& PlantDatabase::findByCare(SunlightPreference sunlight, WaterPreference water) {
+    return (loadedCareIndex ? *loadedCareIndex : builtinCareIndex()).find(sunlight, water);
+}
+
+/**
+ * @brief Builds the trigram index on demand and ranks fuzzy matches.
+ */
+std::vector<PlantMatch> PlantDatabase::searchByName(const std::string& query, std::size_t limit) {
+    const PlantNameIndex* index = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(nameIndexMutex);
+        if (!nameIndex) {
+            nameIndex.reset(new PlantNameIndex(catalog()));
+        }
+        index = nameIndex.get();
+    }
+    return index->search(query, limit);
+}
+
+/**
+ * @brief Parses a memory-mapped CSV catalog and installs it as the active catalog.
+ */
+std::size_t PlantDatabase::loadCatalog(const std::string& path) {
+    MappedFile file(path);
+    std::vector<std::pair<std::string, PlantInfo>> rows;
+    rows.reserve(file.size / 32);
+    // Section names repeat on nearly every row, so each distinct one is materialised once.
+    std::vector<std::string> sections;
+
+    const char* cursor = file.data;
+    const char* const end = file.data + file.size;
+    std::size_t lineNumber = 0;
+    while (cursor < end) {
+        const char* lineEnd = static_cast<const char*>(std::memchr(cursor, '\n', static_cast<std::size_t>(end - cursor)));
+        if (lineEnd == nullptr) {
+            lineEnd = end;
+        }
+        ++lineNumber;
+        const Field line = trim(Field{cursor, lineEnd});
+        cursor = lineEnd + 1;
+        if (line.empty() || *line.begin == '#') {
+            continue;
+        }
+
+        Field fields[5];
+        std::size_t count = 0;
+        const char* start = line.begin;
+        for (const char* p = line.begin; p <= line.end; ++p) {
+            if (p == line.end || *p == ',') {
+                if (count == 5) {
+                    malformed(path, lineNumber, "expected 4 or 5 fields");
+                }
+                fields[count++] = trim(Field{start, p});
+                start = p + 1;
+            }
+        }
+        if (count < 4) {
+            malformed(path, lineNumber, "expected 4 or 5 fields");
+        }
+        if (rows.empty() && equalsIgnoreCase(fields[0], "name")) {
+            continue;
+        }
+        if (fields[0].empty() || fields[1].empty()) {
+            malformed(path, lineNumber, "name and section are required");
+        }
+
+        PlantInfo info;
+        if (!parseLevel(fields[2], info.sunlight)) {
+            malformed(path, lineNumber, "unknown sunlight level");
+        }
+        if (!parseLevel(fields[3], info.water)) {
+            malformed(path, lineNumber, "unknown water level");
+        }
+        auto section = std::find_if(sections.begin(), sections.end(), [&fields](const std::string& known) {
+            return known.size() == fields[1].size() && std::memcmp(known.data(), fields[1].begin, known.size()) == 0;
+        });
+        if (section == sections.end()) {
+            section = sections.insert(sections.end(), std::string(fields[1].begin, fields[1].end));
+        }
+        info.section = *section;
+        if (count == 5) {
+            info.aliases.assign(fields[4].begin, fields[4].end);
+        }
+        rows.emplace_back(std::string(fields[0].begin, fields[0].end), info);
+    }
+
+    if (rows.empty()) {
+        throw std::runtime_error("Plant catalog " + path + " lists no species");
+    }
+    std::sort(rows.begin(), rows.end(),
+              [](const std::pair<std::string, PlantInfo>& a, const std::pair<std::string, PlantInfo>& b) {
+                  return a.first < b.first;
+              });
+    std::map<std::string, PlantInfo> plants;
+    for (std::size_t i = 0; i < rows.size(); ++i) {
+        if (!plants.empty() && plants.rbegin()->first == rows[i].first) {
+            throw std::runtime_error("Plant catalog " + path + " repeats species " + rows[i].first);
+        }
+        // Sorted input makes every hinted insertion amortised constant time.
+        plants.emplace_hint(plants.end(), std::move(rows[i].first), std::move(rows[i].second));
+    }
+    const std::size_t species = plants.size();
+    useCatalog(std::unique_ptr<const PlantCatalog>(new RuntimePlantCatalog(std::move(plants))));
+    return species;
+}
+
+/**
+ * @brief Indexes a catalog and installs it, or reverts to the built-in table.
+ */
+void PlantDatabase::useCatalog(std::unique_ptr<const PlantCatalog> replacement) {
+    std::unique_ptr<const CareIndex> index(replacement ? new CareIndex(*replacement) : nullptr);
+    {
+        std::lock_guard<std::mutex> lock(nameIndexMutex);
+        nameIndex.reset();
+    }
+    loadedCareIndex.reset(index.release());
+    loadedCatalog.reset(replacement.release());
+}
+
+/**
+ * @brief Drops any loaded catalog so lookups use the built-in table again.
+ */
+void PlantDatabase::useBuiltinCatalog() {
+    useCatalog(nullptr);
+}
+
+/**
+ * @brief Reports whether no file catalog is loaded.
+ */
+bool PlantDatabase::isBuiltinCatalog() {
+    return !loadedCatalog;
 }
@@ -0,0 +1,209 @@
+/**
+ * @file plantSearch.cpp
+ * @brief Implements the trigram index for approximate plant-name lookup.
+ */
+#include "../headers/plantSearch.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+/**
+ * @brief Splits a '|'-separated alias list, skipping empty entries.
+ */
+std::vector<std::string> splitAliases(const char* aliases) {
+    std::vector<std::string> result;
+    if (aliases == nullptr) {
+        return result;
+    }
+    std::string current;
+    for (const char* p = aliases;; ++p) {
+        if (*p == '|' || *p == '\0') {
+            if (!current.empty()) {
+                result.push_back(current);
+                current.clear();
+            }
+            if (*p == '\0') {
+                break;
+            }
+        } else {
+            current += *p;
+        }
+    }
+    return result;
+}
+
+/** @brief Candidate term with its trigram overlap. */
+struct Scored {
+    std::uint32_t term;
+    double score;
+};
+
+} // namespace
+
+/**
+ * @brief Indexes each record's name followed by its aliases.
+ */
+PlantNameIndex::PlantNameIndex(const PlantCatalog& source) : catalog(source) {
+    std::vector<std::uint32_t> scratch;
+    terms.reserve(catalog.size());
+    for (std::size_t i = 0; i < catalog.size(); ++i) {
+        const PlantRecord& record = catalog.record(i);
+        addTerm(static_cast<std::uint32_t>(i), record.name, scratch);
+        for (const std::string& alias : splitAliases(record.aliases)) {
+            addTerm(static_cast<std::uint32_t>(i), alias, scratch);
+        }
+    }
+}
+
+/**
+ * @brief Normalises a term and appends its id to the posting list of each trigram.
+ */
+void PlantNameIndex::addTerm(std::uint32_t record, const std::string& text, std::vector<std::uint32_t>& scratch) {
+    std::string normalised = normalise(text);
+    if (normalised.empty()) {
+        return;
+    }
+    scratch.clear();
+    trigramsOf(normalised, scratch);
+    const std::uint32_t id = static_cast<std::uint32_t>(terms.size());
+    terms.push_back(Term{record, static_cast<std::uint32_t>(scratch.size()), std::move(normalised)});
+    for (std::uint32_t code : scratch) {
+        postings[code].push_back(id);
+    }
+}
+
+/**
+ * @brief Keeps lowercase letters and digits, folding any other run into one space.
+ */
+std::string PlantNameIndex::normalise(const std::string& text) {
+    std::string result;
+    result.reserve(text.size());
+    for (char c : text) {
+        if (c >= 'A' && c <= 'Z') {
+            c = static_cast<char>(c - 'A' + 'a');
+        }
+        if ((c >= 'a' && c <= 'z') || (c >= '0' && c <= '9')) {
+            result += c;
+        } else if (!result.empty() && result.back() != ' ') {
+            result += ' ';
+        }
+    }
+    if (!result.empty() && result.back() == ' ') {
+        result.pop_back();
+    }
+    return result;
+}
+
+/**
+ * @brief Packs every three-character window of "  text " into a code.
+ */
+void PlantNameIndex::trigramsOf(const std::string& text, std::vector<std::uint32_t>& codes) {
+    // Two leading blanks give the first letters their own trigrams, as in pg_trgm.
+    const std::string padded = "  " + text + " ";
+    const std::size_t first = codes.size();
+    for (std::size_t i = 0; i + 3 <= padded.size(); ++i) {
+        codes.push_back((static_cast<std::uint32_t>(static_cast<unsigned char>(padded[i])) << 16) |
+                        (static_cast<std::uint32_t>(static_cast<unsigned char>(padded[i + 1])) << 8) |
+                        static_cast<std::uint32_t>(static_cast<unsigned char>(padded[i + 2])));
+    }
+    std::sort(codes.begin() + static_cast<std::ptrdiff_t>(first), codes.end());
+    codes.erase(std::unique(codes.begin() + static_cast<std::ptrdiff_t>(first), codes.end()), codes.end());
+}
+
+/**
+ * @brief Gathers candidates from the rarest trigram lists, then scores them against all lists.
+ */
+std::vector<PlantMatch> PlantNameIndex::search(const std::string& query, std::size_t limit, double minScore) const {
+    std::vector<PlantMatch> matches;
+    const std::string normalised = normalise(query);
+    if (normalised.empty() || limit == 0) {
+        return matches;
+    }
+    std::vector<std::uint32_t> codes;
+    trigramsOf(normalised, codes);
+    const std::size_t k = codes.size();
+
+    static const std::vector<std::uint32_t> kNoTerms;
+    std::vector<const std::vector<std::uint32_t>*> lists;
+    lists.reserve(k);
+    for (std::uint32_t code : codes) {
+        const auto it = postings.find(code);
+        lists.push_back(it == postings.end() ? &kNoTerms : &it->second);
+    }
+    std::sort(lists.begin(), lists.end(),
+              [](const std::vector<std::uint32_t>* a, const std::vector<std::uint32_t>* b) {
+                  return a->size() < b->size();
+              });
+
+    // A term scoring at least minScore shares at least minShared of the k query trigrams,
+    // so it must appear in one of any (k - minShared + 1) lists; only the shortest ones seed candidates.
+    const double floor = std::max(minScore, 1e-9);
+    const std::size_t minShared = std::max<std::size_t>(1, static_cast<std::size_t>(std::ceil(floor * k - 1e-9)));
+    const std::size_t prefix = k - minShared + 1;
+
+    // Per-thread overlap counters sized to the term table; only touched entries are reset afterwards.
+    thread_local std::vector<std::uint16_t> shared;
+    thread_local std::vector<std::uint32_t> touched;
+    if (shared.size() < terms.size()) {
+        shared.assign(terms.size(), 0);
+    }
+    touched.clear();
+    for (std::size_t i = 0; i < prefix; ++i) {
+        for (std::uint32_t id : *lists[i]) {
+            if (shared[id]++ == 0) {
+                touched.push_back(id);
+            }
+        }
+    }
+    // The remaining lists only confirm existing candidates; long ones are probed instead of scanned.
+    for (std::size_t i = prefix; i < k; ++i) {
+        const std::vector<std::uint32_t>& list = *lists[i];
+        if (touched.size() * 16 < list.size()) {
+            for (std::uint32_t id : touched) {
+                shared[id] += std::binary_search(list.begin(), list.end(), id) ? 1 : 0;
+            }
+        } else {
+            for (std::uint32_t id : list) {
+                if (shared[id] != 0) {
+                    ++shared[id];
+                }
+            }
+        }
+    }
+
+    std::vector<Scored> scored;
+    for (std::uint32_t id : touched) {
+        const std::size_t overlap = shared[id];
+        shared[id] = 0;
+        const Term& term = terms[id];
+        if (overlap < minShared) {
+            continue;
+        }
+        const double score = static_cast<double>(overlap) / static_cast<double>(k + term.trigrams - overlap);
+        if (score >= minScore) {
+            scored.push_back(Scored{id, score});
+        }
+    }
+
+    std::sort(scored.begin(), scored.end(), [this](const Scored& a, const Scored& b) {
+        if (a.score != b.score) {
+            return a.score > b.score;
+        }
+        return terms[a.term].text < terms[b.term].text;
+    });
+    std::vector<std::uint32_t> seenRecords;
+    for (const Scored& entry : scored) {
+        const Term& term = terms[entry.term];
+        if (std::find(seenRecords.begin(), seenRecords.end(), term.record) != seenRecords.end()) {
+            continue;
+        }
+        seenRecords.push_back(term.record);
+        matches.push_back(PlantMatch{&catalog.record(term.record), term.text, entry.score});
+        if (matches.size() == limit) {
+            break;
+        }
+    }
+    return matches;
+}
@@ -0,0 +1,92 @@
+/**
+ * @file plantStock.cpp
+ * @brief Implements the incremental per-species plant counters.
+ */
+#include "../headers/plantStock.h"
+#include "../headers/plant.h"
+
+#include <algorithm>
+
+/**
+ * @brief Selects the counter matching a lifecycle stage.
+ */
+int& PlantStockIndex::bucket(PlantStockCounts& speciesCounts, const PlantLifecycle lifecycle) {
+    switch (lifecycle) {
+        case PlantLifecycle::SEEDLING:
+            return speciesCounts.seedling;
+        case PlantLifecycle::MATURE:
+            return speciesCounts.mature;
+        case PlantLifecycle::DEAD:
+            break;
+    }
+    return speciesCounts.dead;
+}
+
+/**
+ * @brief Adds a plant to its species and lifecycle bucket.
+ */
+void PlantStockIndex::track(const Plant& plant) {
+    bucket(counts[plant.getName()], plant.getLifecycle())++;
+    trackedPlants++;
+}
+
+/**
+ * @brief Removes a plant from its species and lifecycle bucket.
+ */
+void PlantStockIndex::untrack(const Plant& plant) {
+    const auto it = counts.find(plant.getName());
+    if (it == counts.end()) {
+        return;
+    }
+    int& count = bucket(it->second, plant.getLifecycle());
+    if (count > 0) {
+        count--;
+        trackedPlants--;
+    }
+}
+
+/**
+ * @brief Shifts one plant of a species between lifecycle buckets.
+ */
+void PlantStockIndex::lifecycleChanged(const std::string& speciesName, const PlantLifecycle from,
+                                       const PlantLifecycle to) {
+    if (from == to) {
+        return;
+    }
+    PlantStockCounts& speciesCounts = counts[speciesName];
+    int& previous = bucket(speciesCounts, from);
+    if (previous > 0) {
+        previous--;
+        bucket(speciesCounts, to)++;
+    }
+}
+
+/**
+ * @brief Finds the counts of a species.
+ */
+const PlantStockCounts* PlantStockIndex::find(const std::string& speciesName) const {
+    const auto it = counts.find(speciesName);
+    return it == counts.end() ? nullptr : &it->second;
+}
+
+/**
+ * @brief Reports how many plants of a species can be sold.
+ */
+int PlantStockIndex::sellable(const std::string& speciesName) const {
+    const PlantStockCounts* speciesCounts = find(speciesName);
+    return speciesCounts ? speciesCounts->mature : 0;
+}
+
+/**
+ * @brief Lists the species with plants present, in name order.
+ */
+std::vector<std::string> PlantStockIndex::species() const {
+    std::vector<std::string> names;
+    for (const auto& entry : counts) {
+        if (entry.second.total() > 0) {
+            names.push_back(entry.first);
+        }
+    }
+    std::sort(names.begin(), names.end());
+    return names;
+}
@@ -3,16 +3,48 @@
  * @brief Implements product builders, decorator extensions, and helpers.
  */
 #include "../headers/productBuilder.h"
+#include <random>
 #include <stdexcept>
-#include <cstdlib> // for rand
 #include <utility>
 
 
+namespace {
+
+/** Supply names the builders draw from the shared inventory. */
+const char* const kBasicSoil = "Basic Soil";
+const char* const kBasicContainer = "Basic Container";
+const char* const kBouquetContainer = "Bouquet Container";
+
+/**
+ * @brief Generator behind builder surcharges, private to each thread.
+ */
+SimulationRandom& pricingEngine() {
+    thread_local SimulationRandom engine;
+    return engine;
+}
+
+/**
+ * @brief Draws a whole surcharge in [low, high].
+ */
+int surcharge(int low, int high) {
+    return std::uniform_int_distribution<int>(low, high)(pricingEngine());
+}
+
+} // namespace
+
+void seedBuilderPricing(std::uint64_t seed) {
+    pricingEngine().seed(static_cast<SimulationRandom::result_type>(seed));
+}
+
+SimulationRandom builderPricingState() { return pricingEngine(); }
+
+void restoreBuilderPricing(const SimulationRandom& state) { pricingEngine() = state; }
+
 /**
  * @brief Constructs a bouquet builder with the plants and greenhouse context.
  */
-BouquetBuilder::BouquetBuilder(std::vector<Plant*> plants, GardenComponent* greenhouse)
-    : Bob(std::move(plants), greenhouse) {}
+BouquetBuilder::BouquetBuilder(std::vector<Plant*> plants, GardenComponent* greenhouse, Inventory* inventory)
+    : Bob(std::move(plants), greenhouse, inventory) {}
 
 /**
  * @brief Builds the bouquet chain by linking supplied plants.
@@ -22,7 +54,7 @@ Product* BouquetBuilder::addPlant() {
     if (plants.empty()) return nullptr;
 
     Plant* first = plants[0];
-    Bouquet* bouquet = new Bouquet(first, greenhouse, true);
+    Bouquet* bouquet = new Bouquet(first, greenhouse, true, inventory);
     bouquet->incPrice(first->getPrice());
     greenhouse->remove(first);
     plants[0] = nullptr;
@@ -33,7 +65,7 @@ Product* BouquetBuilder::addPlant() {
     while (node != nullptr) {
         if (node->getNext() == nullptr && i < static_cast<int>(plants.size())) {
             Plant* current = plants[i];
-            node->setNext(new Bouquet(current, greenhouse, false));  
+            node->setNext(new Bouquet(current, greenhouse, false, inventory));  
             greenhouse->remove(current);
             node = node->getNext();
             node->incPrice(current->getPrice());
@@ -54,8 +86,8 @@ Product* BouquetBuilder::setContainer(Product* product) {
     if (!product) return nullptr;
 
     if (product->getisMain()) {
-        product->incPrice(rand() % (12 - 5 + 1) + 5);
-        product->setContainer("Bouquet Container");
+        product->incPrice(surcharge(5, 12));
+        product->setContainer(kBouquetContainer);
     } else {
         product->setContainer("");
     }
@@ -74,11 +106,18 @@ Product* BouquetBuilder::getProduct() {
 
 
 
+/**
+ * @brief Lists the supplies a bouquet consumes.
+ */
+std::vector<SupplyLine> BouquetBuilder::requiredSupplies() {
+    return {SupplyLine{InventoryCategory::CONTAINER, kBouquetContainer, 1}};
+}
+
 /**
  * @brief Constructs a basic builder enforcing single-plant usage.
  */
-BasicBuilder::BasicBuilder(std::vector<Plant*> plants, GardenComponent* greenhouse)
-    : Bob(std::move(plants), greenhouse) {
+BasicBuilder::BasicBuilder(std::vector<Plant*> plants, GardenComponent* greenhouse, Inventory* inventory)
+    : Bob(std::move(plants), greenhouse, inventory) {
 
     if (plants.size() > 1) {
         throw std::logic_error("Basic Builder can only take 1 plant");
@@ -91,7 +130,7 @@ BasicBuilder::BasicBuilder(std::vector<Plant*> plants, GardenComponent* greenhou
 Product* BasicBuilder::addPlant() {
     if (plants.empty()) return nullptr;
     Plant* source = plants[0];
-    Product* product = new Product(source, greenhouse, true);
+    Product* product = new Product(source, greenhouse, true, inventory);
     if (source) {
         product->incPrice(source->getPrice());
     }
@@ -105,8 +144,8 @@ Product* BasicBuilder::addPlant() {
  */
 Product* Bob::addSoil(Product* product) {
     if (!product) return nullptr;
-    product->incPrice(rand() % (15 - 5 + 1) + 5);
-    product->setSoil("Basic Soil");
+    product->incPrice(surcharge(5, 15));
+    product->setSoil(kBasicSoil);
     return product;
 }
 
@@ -115,8 +154,8 @@ Product* Bob::addSoil(Product* product) {
  */
 Product* BasicBuilder::setContainer(Product* product) {
     if (!product) return nullptr;
-    product->incPrice(rand() % (20 - 5 + 1) + 5);
-    product->setContainer("Basic Container");
+    product->incPrice(surcharge(5, 20));
+    product->setContainer(kBasicContainer);
     return product;
 }
 
@@ -127,6 +166,14 @@ Product* BasicBuilder::getProduct() {
     return setContainer(addSoil(addPlant()));
 }
 
+/**
+ * @brief Lists the supplies a basic product consumes.
+ */
+std::vector<SupplyLine> BasicBuilder::requiredSupplies() {
+    return {SupplyLine{InventoryCategory::SOIL, kBasicSoil, 1},
+            SupplyLine{InventoryCategory::CONTAINER, kBasicContainer, 1}};
+}
+
 
 
 
@@ -145,8 +192,9 @@ void Product::setPlant(Plant* p) {
  */
 void Product::setSoil(const std::string& s) {
     soil = s;
-    
-     inventory.useItem(InventoryCategory::SOIL, s, 1);
+    if (inventory && !s.empty()) {
+        inventory->useItem(InventoryCategory::SOIL, s, 1);
+    }
 }
 
 /**
@@ -154,8 +202,9 @@ void Product::setSoil(const std::string& s) {
  */
 void Product::setContainer(const std::string& c) {
     container = c;
-  
-     inventory.useItem(InventoryCategory::CONTAINER, c, 1);
+    if (inventory && !c.empty()) {
+        inventory->useItem(InventoryCategory::CONTAINER, c, 1);
+    }
 }
 
 /**
@@ -163,7 +212,9 @@ void Product::setContainer(const std::string& c) {
  */
 void Product::setCard(const std::string& c) {
     card = c;
-     inventory.useItem(InventoryCategory::CARD, c, 1);
+    if (inventory && !c.empty()) {
+        inventory->useItem(InventoryCategory::CARD, c, 1);
+    }
 }
 
 /**
@@ -171,7 +222,9 @@ void Product::setCard(const std::string& c) {
  */
 void Product::setWrapping(const std::string& w) {
     wrapping = w;
-     inventory.useItem(InventoryCategory::WRAPPER, w, 1);
+    if (inventory && !w.empty()) {
+        inventory->useItem(InventoryCategory::WRAPPER, w, 1);
+    }
 }
 
 
@@ -196,7 +249,8 @@ float Bouquet::getPrice() {
  */
 Decorator::Decorator(Product* component)
     : Product(component ? component->getPlant() : nullptr, nullptr,
-              component ? component->getisMain() : false), component(component) {
+              component ? component->getisMain() : false,
+              component ? component->getInventory() : nullptr), component(component) {
 
     if (component && component->getPlant()) {
         this->soil = component->getSoil();
@@ -0,0 +1,143 @@
+/**
+ * @file randomStream.cpp
+ * @brief Implements xoshiro256** seeding, jumps, and stream construction.
+ */
+#include "../headers/randomStream.h"
+
+#include <istream>
+#include <ostream>
+
+namespace {
+
+/**
+ * @brief One splitmix64 step, used to expand a seed into a full state.
+ */
+std::uint64_t splitMix64(std::uint64_t& x) {
+    std::uint64_t z = (x += 0x9e3779b97f4a7c15ull);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+    return z ^ (z >> 31);
+}
+
+} // namespace
+
+// -------------------- Xoshiro256StarStar --------------------
+constexpr std::uint64_t Xoshiro256StarStar::default_seed;
+
+void Xoshiro256StarStar::seed(std::uint64_t value) {
+    for (std::uint64_t& word : state) {
+        word = splitMix64(value);
+    }
+}
+
+void Xoshiro256StarStar::jump() {
+    static const std::uint64_t kJump[4] = {0x180ec6d33cfd0abaull, 0xd5a61266f0c9392cull, 0xa9582618e03fc9aaull,
+                                           0x39abdc4529b1661cull};
+    jumpBy(kJump);
+}
+
+void Xoshiro256StarStar::longJump() {
+    static const std::uint64_t kLongJump[4] = {0x76e15d3efefdcbbfull, 0xc5004e441c522fb3ull, 0x77710069854ee241ull,
+                                               0x39109bb02acbe635ull};
+    jumpBy(kLongJump);
+}
+
+/**
+ * @brief Sums the states the generator passes through at the polynomial's set bits, which lands it that far ahead.
+ */
+void Xoshiro256StarStar::jumpBy(const std::uint64_t (&polynomial)[4]) {
+    std::uint64_t jumped[4] = {0, 0, 0, 0};
+    for (std::uint64_t word : polynomial) {
+        for (int bit = 0; bit < 64; ++bit) {
+            if (word & (std::uint64_t(1) << bit)) {
+                for (int i = 0; i < 4; ++i) {
+                    jumped[i] ^= state[i];
+                }
+            }
+            (*this)();
+        }
+    }
+    for (int i = 0; i < 4; ++i) {
+        state[i] = jumped[i];
+    }
+}
+
+std::ostream& operator<<(std::ostream& out, const Xoshiro256StarStar& generator) {
+    return out << generator.state[0] << ' ' << generator.state[1] << ' ' << generator.state[2] << ' '
+               << generator.state[3];
+}
+
+std::istream& operator>>(std::istream& in, Xoshiro256StarStar& generator) {
+    std::uint64_t words[4];
+    if (!(in >> words[0] >> words[1] >> words[2] >> words[3])) {
+        return in;
+    }
+    if ((words[0] | words[1] | words[2] | words[3]) == 0) {
+        in.setstate(std::ios::failbit);
+        return in;
+    }
+    for (int i = 0; i < 4; ++i) {
+        generator.state[i] = words[i];
+    }
+    return in;
+}
+
+// -------------------- Streams --------------------
+namespace {
+
+#ifdef GREENHOUSE_RNG_MT19937
+/**
+ * @brief Mersenne Twister has no cheap jump, so each stream is seeded from the pair (seed, stream) instead.
+ */
+void nextStream(std::mt19937& generator, std::uint64_t seed, std::uint64_t stream) {
+    std::seed_seq sequence{static_cast<std::uint32_t>(seed), static_cast<std::uint32_t>(seed >> 32),
+                           static_cast<std::uint32_t>(stream), static_cast<std::uint32_t>(stream >> 32)};
+    generator.seed(sequence);
+}
+
+/**
+ * @brief Moves a freshly seeded generator to its stream.
+ */
+void enterStream(std::mt19937& generator, std::uint64_t seed, std::uint64_t stream) {
+    if (stream > 0) {
+        nextStream(generator, seed, stream);
+    }
+}
+#else
+/**
+ * @brief Moves a generator from stream @p stream - 1 of a seed to stream @p stream.
+ */
+void nextStream(Xoshiro256StarStar& generator, std::uint64_t, std::uint64_t) { generator.jump(); }
+
+/**
+ * @brief Moves a freshly seeded generator to its stream.
+ */
+void enterStream(Xoshiro256StarStar& generator, std::uint64_t, std::uint64_t stream) {
+    for (; stream > 0; --stream) {
+        generator.jump();
+    }
+}
+#endif
+
+} // namespace
+
+SimulationRandom randomStream(std::uint64_t seed, std::uint64_t stream) {
+    SimulationRandom generator(static_cast<SimulationRandom::result_type>(seed));
+    enterStream(generator, seed, stream);
+    return generator;
+}
+
+std::vector<SimulationRandom> randomStreams(std::uint64_t seed, std::uint64_t first, std::size_t count) {
+    std::vector<SimulationRandom> streams;
+    streams.reserve(count);
+    if (count == 0) {
+        return streams;
+    }
+    streams.push_back(randomStream(seed, first));
+    for (std::size_t i = 1; i < count; ++i) {
+        SimulationRandom next = streams.back();
+        nextStream(next, seed, first + i);
+        streams.push_back(next);
+    }
+    return streams;
+}
@@ -0,0 +1,72 @@
+/**
+ * @file restockQueue.cpp
+ * @brief Implements the bounded lock-free restock event queue.
+ */
+#include "../headers/restockQueue.h"
+
+#include <stdexcept>
+
+/**
+ * @brief Allocates a power-of-two ring and marks every cell free for lap zero.
+ */
+RestockQueue::RestockQueue(std::size_t capacity) : enqueuePos(0), dequeuePos(0) {
+    if (capacity == 0) {
+        throw std::invalid_argument("Restock queue capacity must be positive");
+    }
+    std::size_t size = 1;
+    while (size < capacity) {
+        size <<= 1;
+    }
+    cells.reset(new Cell[size]);
+    mask = size - 1;
+    for (std::size_t i = 0; i < size; ++i) {
+        cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+}
+
+/**
+ * @brief Claims the next free cell and publishes the event into it.
+ */
+bool RestockQueue::tryPush(const RestockEvent& event) {
+    std::size_t pos = enqueuePos.load(std::memory_order_relaxed);
+    for (;;) {
+        Cell& cell = cells[pos & mask];
+        const std::size_t sequence = cell.sequence.load(std::memory_order_acquire);
+        const std::ptrdiff_t lag = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(pos);
+        if (lag == 0) {
+            if (enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                cell.event = event;
+                cell.sequence.store(pos + 1, std::memory_order_release);
+                return true;
+            }
+        } else if (lag < 0) {
+            // The cell still holds an event from the previous lap.
+            return false;
+        } else {
+            pos = enqueuePos.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+/**
+ * @brief Claims the oldest filled cell and frees it for the next lap.
+ */
+bool RestockQueue::tryPop(RestockEvent& event) {
+    std::size_t pos = dequeuePos.load(std::memory_order_relaxed);
+    for (;;) {
+        Cell& cell = cells[pos & mask];
+        const std::size_t sequence = cell.sequence.load(std::memory_order_acquire);
+        const std::ptrdiff_t lag = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(pos + 1);
+        if (lag == 0) {
+            if (dequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                event = cell.event;
+                cell.sequence.store(pos + mask + 1, std::memory_order_release);
+                return true;
+            }
+        } else if (lag < 0) {
+            return false;
+        } else {
+            pos = dequeuePos.load(std::memory_order_relaxed);
+        }
+    }
+}
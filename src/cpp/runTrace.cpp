@@ -0,0 +1,246 @@
+/**
+ * @file runTrace.cpp
+ * @brief Implements digests and the binary format of run traces.
+ */
+#include "../headers/runTrace.h"
+
+#include "../headers/binaryIO.h"
+
+#include <cstring>
+#include <stdexcept>
+
+namespace {
+
+constexpr char kTraceMagic[8] = {'G', 'H', 'T', 'R', 'A', 'C', 'E', '1'};
+constexpr std::uint32_t kTraceVersion = 4;
+constexpr std::uint64_t kFnvOffset = 1469598103934665603ull;
+constexpr std::uint64_t kFnvPrime = 1099511628211ull;
+
+/**
+ * @brief Folds the bytes of a value into an FNV-1a hash.
+ */
+template <typename T> void mix(std::uint64_t& hash, const T& value) {
+    unsigned char bytes[sizeof(T)];
+    std::memcpy(bytes, &value, sizeof(T));
+    for (unsigned char byte : bytes) {
+        hash = (hash ^ byte) * kFnvPrime;
+    }
+}
+
+/**
+ * @brief Reads a byte flag, rejecting anything but 0 or 1.
+ */
+bool getFlag(ByteReader& in) {
+    const std::uint8_t flag = in.get<std::uint8_t>();
+    if (flag > 1) {
+        throw std::runtime_error("Trace flag is corrupt");
+    }
+    return flag == 1;
+}
+
+/**
+ * @brief Writes a count-prefixed list of weights.
+ */
+void putWeights(ByteWriter& out, const std::vector<double>& weights) {
+    out.put(static_cast<std::uint32_t>(weights.size()));
+    out.putBytes(weights.data(), weights.size() * sizeof(double));
+}
+
+/**
+ * @brief Reads a list written by @ref putWeights.
+ */
+std::vector<double> getWeights(ByteReader& in) {
+    const std::uint32_t count = in.get<std::uint32_t>();
+    const char* bytes = in.take(count * sizeof(double));
+    std::vector<double> weights(count);
+    if (count > 0) {
+        std::memcpy(weights.data(), bytes, count * sizeof(double));
+    }
+    return weights;
+}
+
+} // namespace
+
+std::uint64_t RunTrace::digest(const DaySummary& day) {
+    std::uint64_t hash = kFnvOffset;
+    mix(hash, static_cast<std::int32_t>(day.dayIndex));
+    mix(hash, static_cast<std::int32_t>(day.businessLevel));
+    mix(hash, static_cast<std::int32_t>(day.customersServed));
+    mix(hash, static_cast<std::int32_t>(day.ordersCompleted));
+    mix(hash, static_cast<std::int32_t>(day.queriesAnswered));
+    mix(hash, static_cast<std::int32_t>(day.maintenanceCommands));
+    mix(hash, static_cast<std::int64_t>(day.suppliesConsumed));
+    mix(hash, static_cast<std::int64_t>(day.supplyShortages));
+    mix(hash, static_cast<std::int32_t>(day.restocksScheduled));
+    mix(hash, static_cast<std::int32_t>(day.restocksDelivered));
+    mix(hash, day.meanWaitMinutes);
+    mix(hash, static_cast<std::int32_t>(day.peakQueueLength));
+    return hash;
+}
+
+/**
+ * @brief Serialises the trace into one buffer and writes it out.
+ *
+ * The generator state is stored as binary words rather than its text form,
+ * which is two to three times larger.
+ */
+std::size_t RunTrace::save(const std::string& path) const {
+    const std::vector<std::uint64_t> stateWords = generatorWords(rng);
+
+    ByteWriter out;
+    out.reserve(64 + stateWords.size() * 8 + dayDigests.size() * 8);
+    out.putBytes(kTraceMagic, sizeof(kTraceMagic));
+    out.put(kByteOrderMarker);
+    out.put(kTraceVersion);
+    out.put(static_cast<std::uint32_t>(stateWords.size()));
+    out.putBytes(stateWords.data(), stateWords.size() * sizeof(std::uint64_t));
+
+    out.put(static_cast<std::int32_t>(days));
+    out.put(static_cast<std::int32_t>(employees));
+    out.put(static_cast<std::int32_t>(cashiers));
+    out.put(static_cast<std::int32_t>(managers));
+    out.put(static_cast<std::uint32_t>(sections.size()));
+    for (const SectionLayout& section : sections) {
+        out.putString(section.name);
+        out.putString(section.parent);
+    }
+    out.put(catalogSpecies);
+    out.put(static_cast<std::uint32_t>(plants.size()));
+    for (const auto& entry : plants) {
+        out.putString(entry.first);
+        out.put(static_cast<std::int32_t>(entry.second));
+    }
+    out.put(static_cast<std::uint32_t>(supplies.size()));
+    for (const SupplyLine& line : supplies) {
+        out.put(static_cast<std::uint8_t>(line.category));
+        out.putString(line.item);
+        out.put(static_cast<std::int32_t>(line.quantity));
+    }
+    out.put(static_cast<std::int32_t>(restockLowWaterMark));
+    out.put(static_cast<std::int32_t>(restockQuantity));
+    out.put(static_cast<std::uint8_t>(generatedLevels));
+    out.put(static_cast<std::uint32_t>(schedule.size()));
+    for (BusinessLevel level : schedule) {
+        out.put(static_cast<std::uint8_t>(level));
+    }
+    out.put(static_cast<std::uint8_t>(eventDriven));
+    out.put(timing.openMinute);
+    out.put(timing.closeMinute);
+    out.put(timing.meanServiceMinutes);
+    out.put(static_cast<std::int32_t>(timing.servers));
+    out.put(static_cast<std::uint8_t>(timing.spreadArrivals));
+    out.put(static_cast<std::uint8_t>(profileArrivals));
+    for (const ArrivalProfile& profile : profiles) {
+        out.putBytes(profile.customersPerHour, sizeof(profile.customersPerHour));
+    }
+    out.put(static_cast<std::uint32_t>(demand.popularity.size()));
+    for (const auto& entry : demand.popularity) {
+        out.putString(entry.first);
+        out.put(entry.second);
+    }
+    putWeights(out, demand.productsPerOrder);
+    putWeights(out, demand.plantsPerProduct);
+
+    out.put(static_cast<std::uint32_t>(customers.size()));
+    for (const TracedCustomer& customer : customers) {
+        out.putString(customer.name);
+        out.put(static_cast<std::uint8_t>(customer.wantsOrder));
+    }
+    out.put(static_cast<std::uint32_t>(dayDigests.size()));
+    out.putBytes(dayDigests.data(), dayDigests.size() * sizeof(std::uint64_t));
+
+    writeFileBytes(path, out.bytes());
+    return out.size();
+}
+
+RunTrace RunTrace::load(const std::string& path) {
+    const std::vector<char> image = readFileBytes(path);
+    ByteReader in(image.data(), image.size());
+    if (std::memcmp(in.take(sizeof(kTraceMagic)), kTraceMagic, sizeof(kTraceMagic)) != 0) {
+        throw std::runtime_error("Not a simulation trace: " + path);
+    }
+    if (in.get<std::uint32_t>() != kByteOrderMarker) {
+        throw std::runtime_error("Trace was written on a host with a different byte order");
+    }
+    if (in.get<std::uint32_t>() != kTraceVersion) {
+        throw std::runtime_error("Unsupported trace version");
+    }
+
+    RunTrace trace;
+    const std::uint32_t wordCount = in.get<std::uint32_t>();
+    if (wordCount > in.remaining() / sizeof(std::uint64_t)) {
+        throw std::runtime_error("Trace RNG state is corrupt");
+    }
+    std::vector<std::uint64_t> stateWords(wordCount);
+    for (std::uint64_t& word : stateWords) {
+        word = in.get<std::uint64_t>();
+    }
+    try {
+        trace.rng = generatorFromWords<SimulationRandom>(stateWords);
+    } catch (const std::runtime_error&) {
+        throw std::runtime_error("Trace RNG state is corrupt");
+    }
+
+    trace.days = in.get<std::int32_t>();
+    trace.employees = in.get<std::int32_t>();
+    trace.cashiers = in.get<std::int32_t>();
+    trace.managers = in.get<std::int32_t>();
+    for (std::uint32_t count = in.get<std::uint32_t>(); count > 0; --count) {
+        SectionLayout section;
+        section.name = in.getString();
+        section.parent = in.getString();
+        trace.sections.push_back(section);
+    }
+    trace.catalogSpecies = in.get<std::uint64_t>();
+    for (std::uint32_t count = in.get<std::uint32_t>(); count > 0; --count) {
+        const std::string name = in.getString();
+        trace.plants[name] = in.get<std::int32_t>();
+    }
+    for (std::uint32_t count = in.get<std::uint32_t>(); count > 0; --count) {
+        SupplyLine line;
+        line.category = in.getEnum(InventoryCategory::WRAPPER, "Trace supply category is corrupt");
+        line.item = in.getString();
+        line.quantity = in.get<std::int32_t>();
+        trace.supplies.push_back(line);
+    }
+    trace.restockLowWaterMark = in.get<std::int32_t>();
+    trace.restockQuantity = in.get<std::int32_t>();
+    trace.generatedLevels = getFlag(in);
+    for (std::uint32_t count = in.get<std::uint32_t>(); count > 0; --count) {
+        trace.schedule.push_back(in.getEnum(BusinessLevel::HIGH, "Trace business level is corrupt"));
+    }
+    trace.eventDriven = getFlag(in);
+    trace.timing.openMinute = in.get<double>();
+    trace.timing.closeMinute = in.get<double>();
+    trace.timing.meanServiceMinutes = in.get<double>();
+    trace.timing.servers = in.get<std::int32_t>();
+    trace.timing.spreadArrivals = getFlag(in);
+    trace.profileArrivals = getFlag(in);
+    for (ArrivalProfile& profile : trace.profiles) {
+        std::memcpy(profile.customersPerHour, in.take(sizeof(profile.customersPerHour)),
+                    sizeof(profile.customersPerHour));
+    }
+    for (std::uint32_t count = in.get<std::uint32_t>(); count > 0; --count) {
+        const std::string name = in.getString();
+        trace.demand.popularity[name] = in.get<double>();
+    }
+    trace.demand.productsPerOrder = getWeights(in);
+    trace.demand.plantsPerProduct = getWeights(in);
+
+    for (std::uint32_t count = in.get<std::uint32_t>(); count > 0; --count) {
+        TracedCustomer customer;
+        customer.name = in.getString();
+        customer.wantsOrder = getFlag(in);
+        trace.customers.push_back(customer);
+    }
+    const std::uint32_t digests = in.get<std::uint32_t>();
+    const char* digestBytes = in.take(digests * sizeof(std::uint64_t));
+    trace.dayDigests.resize(digests);
+    if (digests > 0) {
+        std::memcpy(trace.dayDigests.data(), digestBytes, digests * sizeof(std::uint64_t));
+    }
+    if (!in.atEnd()) {
+        throw std::runtime_error("Trace has trailing bytes");
+    }
+    return trace;
+}
@@ -4,17 +4,34 @@
  */
 #include "../headers/simulator.h"
 
+#include "../headers/checkpoint.h"
 #include "../headers/command.h"
 #include "../headers/garden.h"
+#include "../headers/greenhouseView.h"
 #include "../headers/iterator.h"
 #include "../headers/plant.h"
-#include <sstream>
+#include "../headers/productBuilder.h"
+#include "../headers/runTrace.h"
+#include <algorithm>
+#include <deque>
+#include <ostream>
+#include <set>
 #include <stdexcept>
 
 namespace {
 
 constexpr int kMaxSimulationDays = 30;
 constexpr double kDefaultPlantPrice = 15.0;
+constexpr int kDefaultSupplyQuantity = 200;
+constexpr int kDefaultRestockLowWaterMark = 20;
+constexpr std::size_t kRestockQueueCapacity = 256;
+constexpr double kMinutesPerDay = 24 * 60;
+constexpr double kOrderProbability = 0.6;
+
+/** @brief Event kinds of an event-driven day. */
+enum DayEvent : std::uint32_t { kMaintenanceEvent, kArrivalEvent, kServiceEndEvent, kPlantSweepEvent };
+/** Payload of arrivals drawn from an arrival profile; each one schedules the next. */
+constexpr std::uint32_t kSampledArrival = 1;
 
 /**
  * @brief Converts a business level into a lowercase string.
@@ -35,15 +52,38 @@ std::string toString(BusinessLevel level) {
 
 } // namespace
 
-Simulation::Simulation(int days)
+EventTiming EventTiming::dayLoop() {
+    EventTiming timing;
+    timing.meanServiceMinutes = 0.0;
+    timing.servers = 1;
+    timing.spreadArrivals = false;
+    return timing;
+}
+
+Simulation::Simulation(int days, std::ostream& console)
     : frontDesk(nullptr),
       greenhouseRoot(nullptr),
       greenhouseManager(nullptr),
+      inventory(nullptr),
+      inventoryJournal(nullptr),
+      restockQueue(nullptr),
       numDays(1),
+      restockLowWaterMark(kDefaultRestockLowWaterMark),
+      restockQuantity(kDefaultSupplyQuantity),
+      console(&console),
+      eventLog(new EventLog()),
       manualCustomerIndex(0),
       generatedCustomerCount(0) {
     customerNamePool = {"Alex", "Morgan", "Riley", "Taylor", "Jordan", "Casey",
                         "Jamie", "Dakota", "Harper", "Rowan", "Charlie", "Avery"};
+    supplySelection = {{InventoryCategory::SOIL, "Basic Soil", kDefaultSupplyQuantity},
+                       {InventoryCategory::CONTAINER, "Basic Container", kDefaultSupplyQuantity},
+                       {InventoryCategory::CONTAINER, "Bouquet Container", kDefaultSupplyQuantity},
+                       {InventoryCategory::CARD, "With love", kDefaultSupplyQuantity},
+                       {InventoryCategory::WRAPPER, "Wrapping", kDefaultSupplyQuantity}};
+    for (BusinessLevel level : {BusinessLevel::LOW, BusinessLevel::MEDIUM, BusinessLevel::HIGH}) {
+        arrivalProfiles[static_cast<int>(level)] = ArrivalProfile::typicalDay(customersForLevel(level));
+    }
     std::random_device rd;
     rng.seed(rd());
     setNumDays(days);
@@ -51,21 +91,72 @@ Simulation::Simulation(int days)
 
 Simulation::~Simulation() {
     cleanup();
+    releaseTrace();
+    delete checkpointWriter;
+    delete eventLog;
 }
 
 void Simulation::setNumDays(int days) {
     if (days < 1) {
         days = 1;
     }
-    if (days > kMaxSimulationDays) {
-        days = kMaxSimulationDays;
-    }
     numDays = days;
     if (static_cast<int>(businessSchedule.size()) > numDays) {
         businessSchedule.resize(numDays);
     }
 }
 
+void Simulation::streamDaySummaries(DaySummarySink sink, std::size_t retained) {
+    if (retained == 0) {
+        throw std::invalid_argument("Streaming must retain at least one day.");
+    }
+    daySummarySink = std::move(sink);
+    retainedDays = retained;
+}
+
+int Simulation::scheduledDays() const {
+    return daySummarySink ? numDays : std::min(numDays, kMaxSimulationDays);
+}
+
+void Simulation::useEventEngine(const EventTiming& timing) {
+    if (!(timing.openMinute >= 0.0 && timing.openMinute < timing.closeMinute && timing.closeMinute <= kMinutesPerDay)) {
+        throw std::invalid_argument("Opening hours must satisfy 0 <= open < close <= 1440 minutes.");
+    }
+    if (timing.meanServiceMinutes < 0.0) {
+        throw std::invalid_argument("Service time cannot be negative.");
+    }
+    if (timing.servers < 1) {
+        throw std::invalid_argument("The front desk needs at least one server.");
+    }
+    eventTiming = timing;
+    eventDriven = true;
+}
+
+void Simulation::useDayLoop() {
+    eventDriven = false;
+}
+
+void Simulation::setEventClock(SimulationClock* clock) {
+    eventClock = clock;
+}
+
+void Simulation::useArrivalProfiles(bool enable) {
+    profileArrivals = enable;
+}
+
+void Simulation::setArrivalProfile(BusinessLevel level, const ArrivalProfile& profile) {
+    arrivalProfiles[static_cast<int>(level)] = profile;
+    profileArrivals = true;
+}
+
+const ArrivalProfile& Simulation::getArrivalProfile(BusinessLevel level) const {
+    return arrivalProfiles[static_cast<int>(level)];
+}
+
+void Simulation::profilePhases(bool enable) {
+    phaseProfiling = enable;
+}
+
 void Simulation::configureBusinessLevels(const std::vector<BusinessLevel>& levels) {
     businessSchedule = levels;
     if (static_cast<int>(businessSchedule.size()) > numDays) {
@@ -82,34 +173,127 @@ void Simulation::configureEmployees(int totalEmployees) {
     if (totalEmployees < 3) {
         throw std::invalid_argument("Simulation requires at least 3 employees.");
     }
-    configuredEmployeeCount = totalEmployees;
+    configureStaff(1, 1, totalEmployees - 2);
+}
+
+void Simulation::configureStaff(int cashiers, int managers, int caretakers) {
+    if (cashiers < 1 || managers < 1 || caretakers < 1) {
+        throw std::invalid_argument("Simulation requires at least one cashier, manager, and caretaker.");
+    }
+    configuredCashiers = cashiers;
+    configuredManagers = managers;
+    configuredEmployeeCount = cashiers + managers + caretakers;
+}
+
+void Simulation::configureSectionLayout(const std::vector<SectionLayout>& layout) {
+    std::set<std::string> declared;
+    declared.insert("root");
+    for (const SectionLayout& section : layout) {
+        if (section.name.empty()) {
+            throw std::invalid_argument("Section names cannot be empty.");
+        }
+        if (declared.count(section.parent) == 0) {
+            throw std::invalid_argument("Parent section '" + section.parent + "' of '" + section.name +
+                                        "' must be declared first.");
+        }
+        if (!declared.insert(section.name).second) {
+            throw std::invalid_argument("Section '" + section.name + "' is declared twice.");
+        }
+    }
+    sectionLayout = layout;
 }
 
 void Simulation::configurePlantSelection(const std::map<std::string, int>& selection) {
-    const auto& database = PlantDatabase::getAllPlants();
     for (const auto& entry : selection) {
         if (entry.second < 0) {
             throw std::invalid_argument("Plant quantities cannot be negative.");
         }
-        if (database.find(entry.first) == database.end()) {
+        if (PlantDatabase::find(entry.first) == nullptr) {
             throw std::invalid_argument("Unknown plant type selected: " + entry.first);
         }
     }
     plantSelection = selection;
 }
 
+void Simulation::configureDemand(const DemandProfile& profile) {
+    profile.validate();
+    demand = profile;
+}
+
 void Simulation::setRandomSeed(unsigned int seed) {
     configuredSeed = seed;
     seedConfigured = true;
     rng.seed(seed);
 }
 
+void Simulation::setRandomStream(std::uint64_t seed, std::uint64_t stream) {
+    setRandomGenerator(randomStream(seed, stream));
+}
+
+void Simulation::setRandomGenerator(const SimulationRandom& generator) {
+    seedConfigured = true;
+    rng = generator;
+}
+
 const std::vector<DaySummary>& Simulation::getDailySummaries() const {
     return dailySummaries;
 }
 
+/**
+ * @brief Drops cached text for records no longer retained and formats records added since the last call.
+ */
 const std::vector<std::string>& Simulation::getEventLog() const {
-    return eventLog;
+    const std::uint64_t first = eventLog->begin();
+    const std::uint64_t last = eventLog->end();
+    if (first >= formattedEnd) {
+        formattedLog.clear();
+        formattedBegin = first;
+        formattedEnd = first;
+    } else if (first > formattedBegin) {
+        formattedLog.erase(formattedLog.begin(), formattedLog.begin() + static_cast<std::ptrdiff_t>(first - formattedBegin));
+        formattedBegin = first;
+    }
+    LogRecord record;
+    for (; formattedEnd < last; ++formattedEnd) {
+        if (eventLog->read(formattedEnd, record)) {
+            formattedLog.push_back(describe(record));
+        }
+    }
+    return formattedLog;
+}
+
+std::size_t Simulation::writeEventLog(std::ostream& out) const {
+    std::size_t written = 0;
+    LogRecord record;
+    for (std::uint64_t position = eventLog->begin(); position < eventLog->end(); ++position) {
+        if (eventLog->read(position, record)) {
+            out << describe(record) << '\n';
+            ++written;
+        }
+    }
+    return written;
+}
+
+const EventLog& Simulation::getEventRecords() const {
+    return *eventLog;
+}
+
+void Simulation::setEventLogCapacity(std::size_t records) {
+    EventLog* replacement = new EventLog(records);
+    delete eventLog;
+    eventLog = replacement;
+    formattedLog.clear();
+    formattedBegin = 0;
+    formattedEnd = 0;
+    dayLogStarts.clear();
+}
+
+void Simulation::publishDayEndViews(bool enable) {
+    dayEndViewsEnabled = enable;
+}
+
+std::shared_ptr<const GreenhouseView> Simulation::getDayEndView() const {
+    return std::atomic_load(&dayEndView);
 }
 
 GreenHouseManager* Simulation::getGreenHouseManager() {
@@ -117,35 +301,111 @@ GreenHouseManager* Simulation::getGreenHouseManager() {
 }
 
 void Simulation::startSimulation() {
+    if (!tracePath.empty() && (greenhouseRestored || !journalBasePath.empty())) {
+        throw std::logic_error("Runs continuing from a snapshot or journal cannot be traced.");
+    }
     ensurePrepared();
-    dailySummaries.clear();
-    eventLog.clear();
-    generatedCustomerCount = 0;
-    manualCustomerIndex = 0;
-
-    std::ostringstream oss;
-    oss << "Simulation starting for " << numDays << " day(s).";
-    log(oss.str());
-
-    for (int day = 0; day < numDays; ++day) {
+    std::unique_ptr<CheckpointState> resumed(resumeState);
+    resumeState = nullptr;
+    int firstDay = 0;
+    if (resumed) {
+        applyCheckpoint(*resumed);
+        firstDay = resumed->day;
+    } else {
+        // Product surcharges come from a per-thread generator; deriving its seed keeps seeded runs reproducible.
+        seedBuilderPricing(rng());
+        dailySummaries.clear();
+        generatedCustomerCount = 0;
+        manualCustomerIndex = 0;
+    }
+    eventLog->clear();
+    // Restored days keep their place in the retention window but have no log entries left.
+    dayLogStarts.assign(daySummarySink ? dailySummaries.size() : 0, eventLog->end());
+    delete checkpointWriter;
+    checkpointWriter = checkpointPath.empty() ? nullptr : new SimulationCheckpoint(checkpointPath);
+
+    const int days = scheduledDays();
+    // The opening entry belongs to the first day so it is dropped with it.
+    const std::uint64_t runStart = eventLog->end();
+    log(LogEvent::SimulationStarted, 0, 0, days);
+
+    for (int day = firstDay; day < days; ++day) {
+        const std::uint64_t logStart = day == firstDay ? runStart : eventLog->end();
         DaySummary summary;
         summary.dayIndex = day + 1;
-        summary.businessLevel = businessSchedule[day];
-        log("Day " + std::to_string(summary.dayIndex) + " (" + toString(summary.businessLevel) + ") begins.");
-
-        scheduleMaintenance(summary);
-        frontDesk->executeAllCommands();
-
-        runCustomersForDay(day, summary);
-        frontDesk->executeAllCommands();
+        const long long consumedBefore = inventory->getUnitsConsumed();
+        const long long shortagesBefore = inventory->getShortageCount();
+        summary.businessLevel = businessLevelForDay(day);
+        log(LogEvent::DayBegan, summary.dayIndex, 0, static_cast<std::int32_t>(summary.businessLevel));
+        deliverRestocks(summary);
+
+        if (eventDriven) {
+            runEventDay(day, summary);
+        } else {
+            {
+                PhaseTimer timer(phaseStats(summary, DayPhase::SCHEDULE_MAINTENANCE));
+                scheduleMaintenance(summary);
+            }
+            {
+                PhaseTimer timer(phaseStats(summary, DayPhase::MAINTENANCE_COMMANDS));
+                frontDesk->executeAllCommands();
+            }
+            {
+                PhaseTimer timer(phaseStats(summary, DayPhase::CUSTOMERS));
+                runCustomersForDay(day, summary);
+            }
+            PhaseTimer timer(phaseStats(summary, DayPhase::CUSTOMER_COMMANDS));
+            frontDesk->executeAllCommands();
+        }
 
         if (greenhouseManager) {
-            greenhouseManager->clearAllDead();
+            {
+                PhaseTimer timer(phaseStats(summary, DayPhase::CLEAR_DEAD));
+                greenhouseManager->clearAllDead();
+            }
+            if (dayEndViewsEnabled) {
+                std::atomic_store(&dayEndView, greenhouseManager->snapshot(summary.dayIndex));
+            }
+        }
+
+        scheduleRestocks(summary);
+        if (inventoryJournal) {
+            inventoryJournal->flush();
+        }
+        summary.suppliesConsumed = inventory->getUnitsConsumed() - consumedBefore;
+        summary.supplyShortages = inventory->getShortageCount() - shortagesBefore;
+        log(LogEvent::DayCompleted, summary.dayIndex);
+        publishDay(summary, logStart);
+        if (checkpointWriter && summary.dayIndex % checkpointInterval == 0) {
+            writeCheckpoint(summary.dayIndex);
         }
+    }
+    if (replayingTrace) {
+        releaseTrace();
+    } else if (trace) {
+        trace->save(tracePath);
+    }
+}
+
+PhaseStats* Simulation::phaseStats(DaySummary& summary, DayPhase phase) const {
+    return phaseProfiling ? &summary.phases[static_cast<int>(phase)] : nullptr;
+}
 
-        dailySummaries.push_back(summary);
-        log("Day " + std::to_string(summary.dayIndex) + " completed.");
+void Simulation::publishDay(const DaySummary& summary, std::uint64_t logStart) {
+    if (trace) {
+        traceDay(summary);
     }
+    dailySummaries.push_back(summary);
+    if (!daySummarySink) {
+        return;
+    }
+    dayLogStarts.push_back(logStart);
+    if (dailySummaries.size() > retainedDays) {
+        eventLog->discardBefore(dayLogStarts[1]);
+        dailySummaries.erase(dailySummaries.begin());
+        dayLogStarts.erase(dayLogStarts.begin());
+    }
+    daySummarySink(summary);
 }
 
 bool Simulation::addCustomer(Customer* customer) {
@@ -170,59 +430,370 @@ void Simulation::addPlant(Plant* plant, GardenSection* gardenSection) {
 }
 
 void Simulation::ensurePrepared() {
-    if (!seedConfigured) {
-        std::random_device rd;
-        rng.seed(rd());
+    if (greenhouseRestored) {
+        greenhouseRestored = false;
+        releaseStaff();
+    } else {
+        if (!seedConfigured) {
+            std::random_device rd;
+            rng.seed(rd());
+        }
+        if (!tracePath.empty() && !replayingTrace) {
+            beginTrace();
+        }
+        cleanup();
+        createGreenhouse();
+        for (const SectionLayout& section : sectionLayout) {
+            greenhouseManager->addSection(section.name, section.parent);
+        }
+        populateGreenhouse();
+        if (!journalBasePath.empty()) {
+            inventoryJournal = new InventoryJournal(*inventory, journalBasePath, journalCommitBatch);
+        }
+        if (inventory->skuCount() == 0) {
+            stockSupplies();
+        }
     }
+    armRestockAlerts();
 
-    cleanup();
-
-    greenhouseRoot = new GardenSection();
-    greenhouseManager = new GreenHouseManager(greenhouseRoot, "root");
     frontDesk = new FrontDesk();
     frontDesk->setGreenhouse(greenhouseRoot);
 
-    employeeStorage.clear();
-
-    populateGreenhouse();
     initialiseEmployees();
     buildBusinessSchedule();
+    buildDemandTables();
 }
 
-void Simulation::initialiseEmployees() {
-    ManagerFactory managerFactory;
-    CashierFactory cashierFactory;
-    CaretakerFactory caretakerFactory;
+void Simulation::createGreenhouse() {
+    greenhouseRoot = new GardenSection();
+    greenhouseManager = new GreenHouseManager(greenhouseRoot, "root");
+    inventory = new Inventory(greenhouseRoot);
+    restockQueue = new RestockQueue(kRestockQueueCapacity);
+    inventory->setRestockQueue(restockQueue);
+}
 
-    Employee* managerBase = managerFactory.createEmployee();
-    Employee* cashierBase = cashierFactory.createEmployee();
-    Manager* manager = dynamic_cast<Manager*>(managerBase);
-    Cashier* cashier = dynamic_cast<Cashier*>(cashierBase);
+void Simulation::stockSupplies() {
+    for (const SupplyLine& line : supplySelection) {
+        inventory->addStock(line.category, line.item, line.quantity);
+    }
+}
 
-    if (manager == nullptr || cashier == nullptr) {
-        delete managerBase;
-        delete cashierBase;
-        throw std::runtime_error("Failed to create manager or cashier.");
+void Simulation::configureSupplies(const std::vector<SupplyLine>& stock) {
+    for (const SupplyLine& line : stock) {
+        if (line.category == InventoryCategory::PLANT) {
+            throw std::invalid_argument("Plant stock comes from the greenhouse, not the supply configuration.");
+        }
     }
+    supplySelection = stock;
+}
 
-    manager->setGreenhouse(greenhouseRoot);
-    cashier->setGreenhouse(greenhouseRoot);
+void Simulation::configureRestockPolicy(int lowWaterMark, int quantity) {
+    if (lowWaterMark >= 0 && quantity <= 0) {
+        throw std::invalid_argument("Restock quantity must be positive.");
+    }
+    restockLowWaterMark = lowWaterMark;
+    restockQuantity = quantity;
+}
+
+void Simulation::armRestockAlerts() {
+    pendingRestocks.clear();
+    for (std::size_t sku = 0; sku < inventory->skuCount(); ++sku) {
+        const SkuId id = static_cast<SkuId>(sku);
+        inventory->setLowWaterMark(id, restockLowWaterMark);
+        // Lines that start at or below the mark never cross it, so order them up front.
+        if (restockLowWaterMark >= 0 && inventory->getQuantity(id) <= restockLowWaterMark) {
+            pendingRestocks.push_back(id);
+        }
+    }
+}
 
-    cashier->setNext(manager);
+void Simulation::scheduleRestocks(DaySummary& summary) {
+    RestockEvent event;
+    while (restockQueue->tryPop(event)) {
+        // Skip lines already on order or replenished since the crossing (e.g. a released reservation).
+        if (std::find(pendingRestocks.begin(), pendingRestocks.end(), event.sku) != pendingRestocks.end() ||
+            inventory->getQuantity(event.sku) > event.threshold) {
+            continue;
+        }
+        pendingRestocks.push_back(event.sku);
+        summary.restocksScheduled++;
+        log(LogEvent::RestockScheduled, summary.dayIndex, static_cast<std::uint32_t>(event.sku), event.quantity,
+            event.threshold, eventLog->intern(inventory->skuName(event.sku)));
+    }
+}
 
-    frontDesk->addEmployee(cashier);
-    frontDesk->addEmployee(manager);
+void Simulation::deliverRestocks(DaySummary& summary) {
+    for (SkuId sku : pendingRestocks) {
+        inventory->addStock(sku, restockQuantity);
+        summary.restocksDelivered++;
+        log(LogEvent::RestockDelivered, summary.dayIndex, static_cast<std::uint32_t>(sku), restockQuantity, 0,
+            eventLog->intern(inventory->skuName(sku)));
+    }
+    pendingRestocks.clear();
+}
 
-    employeeStorage.push_back(cashier);
-    employeeStorage.push_back(manager);
+// -------------------- Record & replay --------------------
+void Simulation::recordTrace(const std::string& path) {
+    tracePath = path;
+    if (path.empty() && !replayingTrace) {
+        releaseTrace();
+    }
+}
 
-    int caretakersToCreate = configuredEmployeeCount - 2;
+/**
+ * @brief Loads the whole trace before touching any setting, so a bad file leaves the simulation as it was.
+ */
+void Simulation::replayTrace(const std::string& path, bool fastForward) {
+    std::unique_ptr<RunTrace> loaded(new RunTrace(RunTrace::load(path)));
+    if (loaded->catalogSpecies != PlantDatabase::catalog().size()) {
+        throw std::runtime_error("Trace " + path + " was recorded with a different plant catalog.");
+    }
+    loaded->demand.validate();
+    releaseTrace();
+    setNumDays(loaded->days);
+    configureStaff(loaded->cashiers, loaded->managers, loaded->employees - loaded->cashiers - loaded->managers);
+    configureSectionLayout(loaded->sections);
+    configurePlantSelection(loaded->plants);
+    configureSupplies(loaded->supplies);
+    configureRestockPolicy(loaded->restockLowWaterMark, loaded->restockQuantity);
+    businessSchedule = loaded->schedule;
+    generateBusinessLevelsAutomatically = loaded->generatedLevels;
+    if (loaded->eventDriven) {
+        useEventEngine(loaded->timing);
+    } else {
+        useDayLoop();
+    }
+    profileArrivals = loaded->profileArrivals;
+    std::copy(loaded->profiles, loaded->profiles + 3, arrivalProfiles);
+    configureDemand(loaded->demand);
+    manualCustomers.clear();
+    for (const TracedCustomer& customer : loaded->customers) {
+        tracedCustomers.push_back(new Customer(customer.name, customer.wantsOrder));
+        manualCustomers.push_back(tracedCustomers.back());
+    }
+    rng = loaded->rng;
+    seedConfigured = true;
+    greenhouseRestored = false;
+    trace = loaded.release();
+    replayingTrace = true;
+    skipEventLog = fastForward;
+}
+
+/**
+ * @brief Captures the generator right after seeding, before the run draws from it.
+ */
+void Simulation::beginTrace() {
+    releaseTrace();
+    trace = new RunTrace();
+    trace->rng = rng;
+    trace->days = numDays;
+    trace->employees = configuredEmployeeCount;
+    trace->cashiers = configuredCashiers;
+    trace->managers = configuredManagers;
+    trace->sections = sectionLayout;
+    trace->catalogSpecies = PlantDatabase::catalog().size();
+    trace->plants = plantSelection;
+    trace->supplies = supplySelection;
+    trace->restockLowWaterMark = restockLowWaterMark;
+    trace->restockQuantity = restockQuantity;
+    trace->generatedLevels = generateBusinessLevelsAutomatically;
+    trace->schedule = businessSchedule;
+    trace->eventDriven = eventDriven;
+    trace->timing = eventTiming;
+    trace->profileArrivals = profileArrivals;
+    std::copy(arrivalProfiles, arrivalProfiles + 3, trace->profiles);
+    trace->demand = demand;
+    for (Customer* customer : manualCustomers) {
+        TracedCustomer traced;
+        traced.name = customer->getName();
+        traced.wantsOrder = customer->wantsOrder();
+        trace->customers.push_back(traced);
+    }
+}
+
+void Simulation::traceDay(const DaySummary& summary) {
+    const std::uint64_t digest = RunTrace::digest(summary);
+    if (!replayingTrace) {
+        trace->dayDigests.push_back(digest);
+        return;
+    }
+    const std::size_t index = static_cast<std::size_t>(summary.dayIndex - 1);
+    if (index < trace->dayDigests.size() && trace->dayDigests[index] != digest) {
+        throw std::runtime_error("Replay diverged from the trace on day " + std::to_string(summary.dayIndex) + ".");
+    }
+}
+
+void Simulation::releaseTrace() {
+    if (replayingTrace) {
+        manualCustomers.clear();
+        manualCustomerIndex = 0;
+    }
+    for (Customer* customer : tracedCustomers) {
+        delete customer;
+    }
+    tracedCustomers.clear();
+    delete trace;
+    trace = nullptr;
+    replayingTrace = false;
+    skipEventLog = false;
+}
+
+// -------------------- Checkpoints --------------------
+void Simulation::checkpointEvery(const std::string& path, int everyDays) {
+    if (everyDays < 1) {
+        throw std::invalid_argument("Checkpoint interval must be at least one day.");
+    }
+    checkpointPath = path;
+    checkpointInterval = everyDays;
+}
+
+/**
+ * @brief Rebuilds greenhouse and stock now; staff state is applied once the next run has created its staff.
+ */
+int Simulation::resumeFromCheckpoint(const std::string& path) {
+    cleanup();
+    createGreenhouse();
+    std::unique_ptr<CheckpointState> state;
+    try {
+        state.reset(new CheckpointState(SimulationCheckpoint::restore(path, *greenhouseManager, *inventory)));
+    } catch (...) {
+        releaseGreenhouse();
+        throw;
+    }
+    // Customers draw species from the selection, which a fresh run fills with defaults when populating.
+    applyDefaultPlantSelection();
+    rng = state->rng;
+    dailySummaries = state->summaries;
+    if (daySummarySink && dailySummaries.size() > retainedDays) {
+        dailySummaries.erase(dailySummaries.begin(), dailySummaries.end() - static_cast<std::ptrdiff_t>(retainedDays));
+    }
+    generatedCustomerCount = static_cast<int>(state->generatedCustomers);
+    manualCustomerIndex = static_cast<std::size_t>(state->manualCustomerIndex);
+    greenhouseRestored = true;
+    resumeState = state.release();
+    if (dayEndViewsEnabled) {
+        std::atomic_store(&dayEndView, greenhouseManager->snapshot(resumeState->day));
+    }
+    return resumeState->day;
+}
+
+CheckpointStats Simulation::getCheckpointStats() const {
+    return checkpointWriter ? checkpointWriter->getStats() : CheckpointStats();
+}
+
+/**
+ * @brief Captures the state that outlives a day; the front desk has executed every command by now.
+ */
+void Simulation::writeCheckpoint(int day) {
+    if (frontDesk->pendingCommands() != 0) {
+        throw std::logic_error("Checkpoints are taken between days, with no commands queued.");
+    }
+    CheckpointState state;
+    state.day = day;
+    state.rng = rng;
+    state.pricing = builderPricingState();
+    state.generatedCustomers = generatedCustomerCount;
+    state.manualCustomerIndex = manualCustomerIndex;
+    state.pendingRestocks = pendingRestocks;
+    for (Employee* employee : employeeStorage) {
+        CheckpointedEmployee staff;
+        if (Manager* manager = dynamic_cast<Manager*>(employee)) {
+            staff.complaints = manager->getComplaintCount();
+        } else if (Caretaker* caretaker = dynamic_cast<Caretaker*>(employee)) {
+            staff.homeSection = caretaker->getHomeSection();
+        }
+        state.employees.push_back(staff);
+    }
+    checkpointWriter->write(*greenhouseManager, *inventory, state, dailySummaries);
+}
+
+void Simulation::applyCheckpoint(const CheckpointState& state) {
+    if (state.employees.size() != employeeStorage.size()) {
+        throw std::runtime_error("Checkpoint was taken with a different number of employees.");
+    }
+    restoreBuilderPricing(state.pricing);
+    pendingRestocks = state.pendingRestocks;
+    for (std::size_t i = 0; i < employeeStorage.size(); ++i) {
+        if (Manager* manager = dynamic_cast<Manager*>(employeeStorage[i])) {
+            manager->setComplaintCount(state.employees[i].complaints);
+        } else if (Caretaker* caretaker = dynamic_cast<Caretaker*>(employeeStorage[i])) {
+            caretaker->setHomeSection(state.employees[i].homeSection);
+        }
+    }
+}
+
+void Simulation::setInventoryJournal(const std::string& basePath, std::size_t commitBatch) {
+    journalBasePath = basePath;
+    journalCommitBatch = commitBatch;
+}
+
+Inventory* Simulation::getInventory() {
+    return inventory;
+}
+
+SnapshotStats Simulation::saveSnapshot(const std::string& path) const {
+    if (!greenhouseManager) {
+        throw std::logic_error("No greenhouse to snapshot; run or restore a simulation first.");
+    }
+    return GreenhouseSnapshot::save(path, *greenhouseManager, inventory, &rng);
+}
+
+SnapshotStats Simulation::restoreSnapshot(const std::string& path) {
+    cleanup();
+    createGreenhouse();
+    try {
+        SnapshotStats stats = GreenhouseSnapshot::restore(path, *greenhouseManager, inventory, &rng);
+        greenhouseRestored = true;
+        return stats;
+    } catch (...) {
+        releaseGreenhouse();
+        throw;
+    }
+}
+
+void Simulation::initialiseEmployees() {
+    ManagerFactory managerFactory;
+    CashierFactory cashierFactory;
+    CaretakerFactory caretakerFactory;
+
+    std::vector<Cashier*> cashiers;
+    std::vector<Manager*> managers;
+    for (int i = 0; i < configuredCashiers + configuredManagers; ++i) {
+        const bool isCashier = i < configuredCashiers;
+        Employee* base = isCashier ? cashierFactory.createEmployee() : managerFactory.createEmployee();
+        Cashier* cashier = isCashier ? dynamic_cast<Cashier*>(base) : nullptr;
+        Manager* manager = isCashier ? nullptr : dynamic_cast<Manager*>(base);
+        if (cashier == nullptr && manager == nullptr) {
+            delete base;
+            throw std::runtime_error("Failed to create manager or cashier.");
+        }
+        base->setGreenhouse(greenhouseRoot);
+        base->setConsole(*console);
+        if (cashier != nullptr) {
+            cashier->setInventory(inventory);
+            cashiers.push_back(cashier);
+        } else {
+            managers.push_back(manager);
+        }
+        employeeStorage.push_back(base);
+    }
+    // Escalations are spread over the managers; the roster keeps cashiers ahead of managers.
+    for (std::size_t i = 0; i < cashiers.size(); ++i) {
+        cashiers[i]->setNext(managers[i % managers.size()]);
+        frontDesk->addEmployee(cashiers[i]);
+    }
+    for (Manager* manager : managers) {
+        frontDesk->addEmployee(manager);
+    }
+
+    int caretakersToCreate = configuredEmployeeCount - configuredCashiers - configuredManagers;
     for (int i = 0; i < caretakersToCreate; ++i) {
         Employee* caretakerBase = caretakerFactory.createEmployee();
         if (!caretakerBase) {
             continue;
         }
         caretakerBase->setGreenhouse(greenhouseRoot);
+        caretakerBase->setConsole(*console);
         if (Caretaker* caretakerPtr = dynamic_cast<Caretaker*>(caretakerBase)) {
             caretakerPtr->setHomeSection(greenhouseRoot);
             frontDesk->addEmployee(caretakerPtr);
@@ -231,18 +802,22 @@ void Simulation::initialiseEmployees() {
     }
 }
 
-void Simulation::populateGreenhouse() {
-    const auto& database = PlantDatabase::getAllPlants();
-
-    if (plantSelection.empty()) {
-        int count = 0;
-        for (const auto& entry : database) {
-            plantSelection[entry.first] = 2;
-            if (++count >= 5) {
-                break;
-            }
+void Simulation::applyDefaultPlantSelection() {
+    if (!plantSelection.empty()) {
+        return;
+    }
+    int count = 0;
+    for (const auto& entry : PlantDatabase::getAllPlants()) {
+        plantSelection[entry.first] = 2;
+        if (++count >= 5) {
+            break;
         }
     }
+}
+
+void Simulation::populateGreenhouse() {
+    const auto& database = PlantDatabase::getAllPlants();
+    applyDefaultPlantSelection();
 
     for (const auto& entry : plantSelection) {
         auto it = database.find(entry.first);
@@ -258,19 +833,20 @@ void Simulation::populateGreenhouse() {
 }
 
 void Simulation::buildBusinessSchedule() {
-    if (generateBusinessLevelsAutomatically || businessSchedule.size() != static_cast<std::size_t>(numDays)) {
-        businessSchedule.assign(static_cast<std::size_t>(numDays), BusinessLevel::MEDIUM);
+    // Generated levels are drawn as each day starts, so nothing here grows with the run length.
+    if (generateBusinessLevelsAutomatically) {
+        businessSchedule.clear();
     }
+}
 
+BusinessLevel Simulation::businessLevelForDay(int day) {
     if (generateBusinessLevelsAutomatically) {
         std::uniform_int_distribution<int> levelDist(0, 2);
-        for (int day = 0; day < numDays; ++day) {
-            businessSchedule[static_cast<std::size_t>(day)] =
-                static_cast<BusinessLevel>(levelDist(rng));
-        }
-    } else if (businessSchedule.size() < static_cast<std::size_t>(numDays)) {
-        businessSchedule.resize(static_cast<std::size_t>(numDays), BusinessLevel::MEDIUM);
+        return static_cast<BusinessLevel>(levelDist(rng));
     }
+    // Configured levels are used as given; days beyond them run at MEDIUM.
+    return static_cast<std::size_t>(day) < businessSchedule.size() ? businessSchedule[static_cast<std::size_t>(day)]
+                                                                     : BusinessLevel::MEDIUM;
 }
 
 void Simulation::scheduleMaintenance(DaySummary& summary) {
@@ -288,94 +864,214 @@ void Simulation::scheduleMaintenance(DaySummary& summary) {
 }
 
 void Simulation::runCustomersForDay(int /*dayIndex*/, DaySummary& summary) {
-    const int baseCustomers = customersForLevel(summary.businessLevel);
-    int manualRemaining = 0;
-    if (manualCustomerIndex < manualCustomers.size()) {
-        manualRemaining = static_cast<int>(manualCustomers.size() - manualCustomerIndex);
+    const int totalCustomers = customersDueToday(summary.businessLevel);
+    for (int i = 0; i < totalCustomers; ++i) {
+        serveNextCustomer(summary);
     }
+}
 
-    const int totalCustomers = baseCustomers + manualRemaining;
-    if (totalCustomers <= 0) {
-        return;
+void Simulation::runEventDay(int dayIndex, DaySummary& summary) {
+    EventEngine engine;
+    engine.setClock(eventClock);
+    const SimTime opening = dayIndex * kMinutesPerDay + eventTiming.openMinute;
+    const SimTime closing = dayIndex * kMinutesPerDay + eventTiming.closeMinute;
+    const double meanService = eventTiming.meanServiceMinutes;
+    std::exponential_distribution<double> serviceTime(meanService > 0.0 ? 1.0 / meanService : 1.0);
+
+    ArrivalSampler sampler(arrivalProfiles[static_cast<int>(summary.businessLevel)], dayIndex * kMinutesPerDay);
+    int busy = 0;
+    int started = 0;
+    double totalWait = 0.0;
+    std::deque<SimTime> waiting;
+    auto startService = [&](SimTime arrivedAt) {
+        totalWait += engine.now() - arrivedAt;
+        ++busy;
+        ++started;
+        serveNextCustomer(summary);
+        engine.scheduleAfter(meanService > 0.0 ? serviceTime(rng) : 0.0, kServiceEndEvent);
+    };
+
+    engine.on(kMaintenanceEvent, [&](const SimEvent&) {
+        {
+            PhaseTimer timer(phaseStats(summary, DayPhase::SCHEDULE_MAINTENANCE));
+            scheduleMaintenance(summary);
+        }
+        PhaseTimer timer(phaseStats(summary, DayPhase::MAINTENANCE_COMMANDS));
+        frontDesk->executeAllCommands();
+    });
+    // Arrivals and service ends are the customer phase, however they interleave with other events.
+    PhaseStats* const customerPhase = phaseStats(summary, DayPhase::CUSTOMERS);
+    engine.on(kArrivalEvent, [&](const SimEvent& event) {
+        PhaseTimer timer(customerPhase);
+        SimTime next = 0.0;
+        if (event.payload == kSampledArrival && sampler.next(rng, next)) {
+            engine.schedule(next, kArrivalEvent, kSampledArrival);
+        }
+        if (busy < eventTiming.servers) {
+            startService(engine.now());
+            return;
+        }
+        waiting.push_back(engine.now());
+        summary.peakQueueLength = std::max(summary.peakQueueLength, static_cast<int>(waiting.size()));
+    });
+    engine.on(kServiceEndEvent, [&](const SimEvent&) {
+        PhaseTimer timer(customerPhase);
+        --busy;
+        if (!waiting.empty()) {
+            const SimTime arrivedAt = waiting.front();
+            waiting.pop_front();
+            startService(arrivedAt);
+        }
+    });
+    engine.on(kPlantSweepEvent, [&](const SimEvent&) {
+        if (greenhouseManager) {
+            PhaseTimer timer(phaseStats(summary, DayPhase::CLEAR_DEAD));
+            greenhouseManager->clearAllDead();
+        }
+    });
+
+    // Maintenance is scheduled first so it precedes customers arriving at opening.
+    engine.schedule(opening, kMaintenanceEvent);
+    if (profileArrivals) {
+        // Manual customers are waiting at opening; sampled arrivals are generated one ahead.
+        for (int i = manualCustomersRemaining(); i > 0; --i) {
+            engine.schedule(opening, kArrivalEvent);
+        }
+        SimTime first = 0.0;
+        if (sampler.next(rng, first)) {
+            engine.schedule(first, kArrivalEvent, kSampledArrival);
+        }
+    } else {
+        const int customers = customersDueToday(summary.businessLevel);
+        engine.reserve(static_cast<std::size_t>(customers) + 2);
+        std::uniform_real_distribution<double> arrivalTime(opening, closing);
+        for (int i = 0; i < customers; ++i) {
+            engine.schedule(eventTiming.spreadArrivals ? arrivalTime(rng) : opening, kArrivalEvent);
+        }
     }
+    engine.schedule(closing, kPlantSweepEvent);
+    engine.run();
 
-    std::bernoulli_distribution orderDecision(0.6);
+    {
+        PhaseTimer timer(phaseStats(summary, DayPhase::CUSTOMER_COMMANDS));
+        frontDesk->executeAllCommands();
+    }
+    summary.meanWaitMinutes = started > 0 ? totalWait / started : 0.0;
+}
 
-    for (int i = 0; i < totalCustomers; ++i) {
-        Customer* customerPtr = nullptr;
-        bool ownsCustomer = false;
-        bool wantsOrder = false;
+int Simulation::customersDueToday(BusinessLevel level) {
+    const long long generated = profileArrivals
+                                    ? ArrivalSampler::countDay(arrivalProfiles[static_cast<int>(level)], rng)
+                                    : customersForLevel(level);
+    return static_cast<int>(std::max(0LL, generated + manualCustomersRemaining()));
+}
 
-        if (manualCustomerIndex < manualCustomers.size()) {
-            customerPtr = manualCustomers[manualCustomerIndex++];
-            wantsOrder = customerPtr ? customerPtr->wantsOrder() : false;
-        } else {
-            wantsOrder = orderDecision(rng) && !plantSelection.empty();
-            customerPtr = new Customer(generateCustomerName(), wantsOrder);
-            ownsCustomer = true;
-        }
+int Simulation::manualCustomersRemaining() const {
+    return manualCustomerIndex < manualCustomers.size() ? static_cast<int>(manualCustomers.size() - manualCustomerIndex)
+                                                        : 0;
+}
 
-        if (customerPtr == nullptr) {
+void Simulation::serveNextCustomer(DaySummary& summary) {
+    Customer* customerPtr = nullptr;
+    bool ownsCustomer = false;
+    bool wantsOrder = false;
+
+    if (manualCustomerIndex < manualCustomers.size()) {
+        customerPtr = manualCustomers[manualCustomerIndex++];
+        wantsOrder = customerPtr ? customerPtr->wantsOrder() : false;
+    } else {
+        std::bernoulli_distribution orderDecision(kOrderProbability);
+        wantsOrder = orderDecision(rng) && !plantSelection.empty();
+        customerPtr = new Customer(generateCustomerName(), wantsOrder);
+        ownsCustomer = true;
+    }
+
+    if (customerPtr == nullptr) {
+        return;
+    }
+
+    summary.customersServed++;
+    // Generated names are rebuilt from the customer number when the log is read; others are interned.
+    const std::uint32_t customerId = ownsCustomer ? static_cast<std::uint32_t>(generatedCustomerCount) : 0;
+    const std::uint32_t customerLogName = ownsCustomer ? kNoName : eventLog->intern(customerPtr->getName());
+
+    if (wantsOrder) {
+        auto requests = generateOrderRequests();
+        if (!requests.empty() && frontDesk->placeOrder(requests, customerPtr)) {
+            summary.ordersCompleted++;
+            log(LogEvent::OrderPlaced, summary.dayIndex, customerId, 0, 0, customerLogName);
+            frontDesk->pay();
             if (ownsCustomer) {
                 delete customerPtr;
             }
-            continue;
+            return;
         }
+    }
 
-        summary.customersServed++;
-
-        if (wantsOrder) {
-            auto requests = generateOrderRequests();
-            if (!requests.empty() && frontDesk->placeOrder(requests, customerPtr)) {
-                summary.ordersCompleted++;
-                log("Order placed for " + customerPtr->getName());
-                frontDesk->pay();
-                if (ownsCustomer) {
-                    delete customerPtr;
-                }
-                continue;
-            }
-            wantsOrder = false;
-        }
+    frontDesk->addCommand(new RequestCommand(generateRandomQuery()));
+    summary.queriesAnswered++;
+    log(LogEvent::AdviceRequested, summary.dayIndex, customerId, 0, 0, customerLogName);
 
-        frontDesk->addCommand(new RequestCommand(generateRandomQuery()));
-        summary.queriesAnswered++;
-        log("Advice request logged for " + customerPtr->getName());
+    if (ownsCustomer) {
+        delete customerPtr;
+    }
+}
 
-        if (ownsCustomer) {
-            delete customerPtr;
+/**
+ * @brief Rebuilds the species and order-size tables from the selection and demand profile.
+ *
+ * Runs once per run, after the default selection may have been filled in;
+ * the selection cannot change while a run is in progress.
+ */
+void Simulation::buildDemandTables() {
+    orderSpecies.clear();
+    adviceTopics.clear();
+    std::vector<double> orderWeights;
+    std::vector<double> adviceWeights;
+    double orderTotal = 0.0;
+    double adviceTotal = 0.0;
+    for (const auto& entry : plantSelection) {
+        const double weight = demand.weightOf(entry.first);
+        orderSpecies.push_back(&entry.first);
+        orderWeights.push_back(weight);
+        orderTotal += weight;
+        if (const PlantRecord* record = PlantDatabase::find(entry.first)) {
+            AdviceCriteria criteria;
+            criteria.sunlight = record->sunlight;
+            criteria.water = record->water;
+            adviceTopics.push_back(criteria);
+            adviceWeights.push_back(weight);
+            adviceTotal += weight;
         }
     }
+    if (!orderSpecies.empty() && !(orderTotal > 0.0)) {
+        throw std::invalid_argument("Demand popularity gives every selected species zero weight.");
+    }
+    orderSpeciesTable = orderSpecies.empty() ? AliasTable() : AliasTable(orderWeights);
+    // Species nobody wants are not asked about either; if only those are listed in the catalog, nothing is.
+    if (!(adviceTotal > 0.0)) {
+        adviceTopics.clear();
+    }
+    adviceTopicTable = adviceTopics.empty() ? AliasTable() : AliasTable(adviceWeights);
+    productsPerOrderTable = AliasTable(demand.productsPerOrder);
+    plantsPerProductTable = AliasTable(demand.plantsPerProduct);
 }
 
 std::vector<ProductRequest> Simulation::generateOrderRequests() {
     std::vector<ProductRequest> requests;
-    if (plantSelection.empty()) {
-        return requests;
-    }
-
-    std::vector<std::string> plantTypes;
-    plantTypes.reserve(plantSelection.size());
-    for (const auto& entry : plantSelection) {
-        plantTypes.push_back(entry.first);
-    }
-
-    if (plantTypes.empty()) {
+    if (orderSpecies.empty()) {
         return requests;
     }
 
-    std::uniform_int_distribution<int> productCountDist(1, 2);
-    std::uniform_int_distribution<int> plantIndexDist(0, static_cast<int>(plantTypes.size()) - 1);
-    std::uniform_int_distribution<int> plantsPerProductDist(1, 3);
     std::bernoulli_distribution wantsCardDist(0.35);
     std::bernoulli_distribution wantsWrapDist(0.5);
 
-    int productCount = productCountDist(rng);
-    for (int i = 0; i < productCount; ++i) {
+    const std::size_t productCount = productsPerOrderTable.sample(rng) + 1;
+    for (std::size_t i = 0; i < productCount; ++i) {
         ProductRequest request;
-        int plantsNeeded = plantsPerProductDist(rng);
-        for (int p = 0; p < plantsNeeded; ++p) {
-            const std::string& plantName = plantTypes[plantIndexDist(rng)];
+        const std::size_t plantsNeeded = plantsPerProductTable.sample(rng) + 1;
+        for (std::size_t p = 0; p < plantsNeeded; ++p) {
+            const std::string& plantName = *orderSpecies[orderSpeciesTable.sample(rng)];
             if (!hasMaturePlantAvailable(plantName)) {
                 continue;
             }
@@ -395,39 +1091,26 @@ std::vector<ProductRequest> Simulation::generateOrderRequests() {
 }
 
 RequestCommand Simulation::generateRandomQuery() {
-    const auto& database = PlantDatabase::getAllPlants();
-    if (plantSelection.empty() || database.empty()) {
+    if (plantSelection.empty() || PlantDatabase::catalog().size() == 0) {
         return RequestCommand(RequestType::COMPLAINT, "No plants available yet.");
     }
 
-    std::vector<std::string> candidates;
-    candidates.reserve(plantSelection.size());
-    for (const auto& entry : plantSelection) {
-        if (database.find(entry.first) != database.end()) {
-            candidates.push_back(entry.first);
-        }
-    }
-    if (candidates.empty()) {
+    if (adviceTopics.empty()) {
         return RequestCommand(RequestType::COMPLAINT, "No valid plants configured.");
     }
-
-    std::uniform_int_distribution<int> plantIndexDist(0, static_cast<int>(candidates.size()) - 1);
-    const std::string& chosen = candidates[plantIndexDist(rng)];
-    const PlantInfo& info = database.at(chosen);
-
-    AdviceCriteria criteria;
-    criteria.sunlight = info.sunlight;
-    criteria.water = info.water;
-    return RequestCommand(criteria);
+    return RequestCommand(adviceTopics[adviceTopicTable.sample(rng)]);
 }
 
 std::string Simulation::generateCustomerName() {
+    return customerName(++generatedCustomerCount);
+}
+
+std::string Simulation::customerName(long long ordinal) const {
     if (customerNamePool.empty()) {
-        return "Customer_" + std::to_string(++generatedCustomerCount);
+        return "Customer_" + std::to_string(ordinal);
     }
-    const std::string& base = customerNamePool[static_cast<std::size_t>(generatedCustomerCount % customerNamePool.size())];
-    ++generatedCustomerCount;
-    return base + " #" + std::to_string(generatedCustomerCount);
+    const std::string& base = customerNamePool[static_cast<std::size_t>((ordinal - 1) % customerNamePool.size())];
+    return base + " #" + std::to_string(ordinal);
 }
 
 int Simulation::customersForLevel(BusinessLevel level) const {
@@ -450,33 +1133,52 @@ Plant* Simulation::createPlantInstance(const std::string& name, const PlantInfo&
 }
 
 WaterLossStrategy* Simulation::createWaterStrategy(WaterPreference preference) {
-    switch (preference) {
-        case WaterPreference::LOW:
-            return new LowWaterLoss();
-        case WaterPreference::MEDIUM:
-            return new MedWaterLoss();
-        case WaterPreference::HIGH:
-            return new HighWaterLoss();
-        default:
-            return new MedWaterLoss();
-    }
+    return createWaterLossStrategy(preference);
 }
 
 SunlightStrategy* Simulation::createSunStrategy(SunlightPreference preference) {
-    switch (preference) {
-        case SunlightPreference::LOW:
-            return new LowSunlightStrategy();
-        case SunlightPreference::MEDIUM:
-            return new MedSunlightStrategy();
-        case SunlightPreference::HIGH:
-            return new HighSunlightStrategy();
-        default:
-            return new MedSunlightStrategy();
+    return createSunlightStrategy(preference);
+}
+
+void Simulation::log(LogEvent type, int day, std::uint32_t subject, std::int32_t value, std::int32_t extra,
+                     std::uint32_t name) {
+    if (skipEventLog) {
+        return;
     }
+    LogRecord record;
+    record.type = type;
+    record.day = static_cast<std::uint32_t>(day);
+    record.subject = subject;
+    record.name = name;
+    record.value = value;
+    record.extra = extra;
+    eventLog->append(record);
 }
 
-void Simulation::log(const std::string& entry) {
-    eventLog.push_back(entry);
+/**
+ * @brief Rebuilds the sentence the event used to be logged as.
+ */
+std::string Simulation::describe(const LogRecord& record) const {
+    const std::string day = std::to_string(record.day);
+    switch (record.type) {
+        case LogEvent::SimulationStarted:
+            return "Simulation starting for " + std::to_string(record.value) + " day(s).";
+        case LogEvent::DayBegan:
+            return "Day " + day + " (" + toString(static_cast<BusinessLevel>(record.value)) + ") begins.";
+        case LogEvent::DayCompleted:
+            return "Day " + day + " completed.";
+        case LogEvent::RestockScheduled:
+            return "Restock scheduled for " + eventLog->name(record.name) + " (" + std::to_string(record.value) +
+                   " left, low-water mark " + std::to_string(record.extra) + ").";
+        case LogEvent::RestockDelivered:
+            return "Restock delivered: " + std::to_string(record.value) + " x " + eventLog->name(record.name) + ".";
+        case LogEvent::OrderPlaced:
+        case LogEvent::AdviceRequested: {
+            const std::string who = record.name == kNoName ? customerName(record.subject) : eventLog->name(record.name);
+            return (record.type == LogEvent::OrderPlaced ? "Order placed for " : "Advice request logged for ") + who;
+        }
+    }
+    return "Unknown event on day " + day + ".";
 }
 
 std::string Simulation::businessLevelToString(BusinessLevel level) const {
@@ -487,19 +1189,42 @@ bool Simulation::hasMaturePlantAvailable(const std::string& plantName) const {
     if (!greenhouseManager) {
         return false;
     }
-    return greenhouseManager->findMature(plantName) != nullptr;
+    return greenhouseManager->countSellable(plantName) > 0;
 }
 
 void Simulation::cleanup() {
+    releaseStaff();
+    releaseGreenhouse();
+    delete resumeState;
+    resumeState = nullptr;
+}
+
+void Simulation::releaseStaff() {
     if (frontDesk) {
         delete frontDesk;
         frontDesk = nullptr;
     }
     clearEmployees();
+}
+
+void Simulation::releaseGreenhouse() {
     if (greenhouseManager) {
         delete greenhouseManager;
         greenhouseManager = nullptr;
     }
+    if (inventoryJournal) {
+        delete inventoryJournal;
+        inventoryJournal = nullptr;
+    }
+    if (inventory) {
+        delete inventory;
+        inventory = nullptr;
+    }
+    if (restockQueue) {
+        delete restockQueue;
+        restockQueue = nullptr;
+    }
+    pendingRestocks.clear();
     if (greenhouseRoot) {
         destroyGardenComponent(greenhouseRoot);
         greenhouseRoot = nullptr;
@@ -0,0 +1,308 @@
+/**
+ * @file snapshot.cpp
+ * @brief Implements binary save and restore of greenhouse state.
+ */
+#include "../headers/snapshot.h"
+
+#include "../headers/binaryIO.h"
+#include "../headers/garden.h"
+#include "../headers/greenhouseManager.h"
+#include "../headers/inventory.h"
+#include "../headers/plant.h"
+
+#include <cstdint>
+#include <sstream>
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace {
+
+constexpr char kSnapshotMagic[8] = {'G', 'H', 'S', 'N', 'A', 'P', '0', '1'};
+constexpr std::uint32_t kSnapshotVersion = 1;
+constexpr std::uint32_t kNoIndex = 0xFFFFFFFFu;
+constexpr std::size_t kPlantRecordBytes = 32;
+
+/**
+ * @brief Assigns dense ids to repeated strings such as species and section names.
+ */
+class StringTable {
+  public:
+    std::uint32_t intern(const std::string& value) {
+        const auto it = ids.find(value);
+        if (it != ids.end()) {
+            return it->second;
+        }
+        const auto id = static_cast<std::uint32_t>(values.size());
+        ids.emplace(value, id);
+        values.push_back(&ids.find(value)->first);
+        return id;
+    }
+    const std::vector<const std::string*>& entries() const { return values; }
+
+  private:
+    std::unordered_map<std::string, std::uint32_t> ids;
+    std::vector<const std::string*> values;
+};
+
+/**
+ * @brief Copies a value into a record buffer and returns the next write position.
+ */
+template <typename T> char* store(char* at, const T& value) {
+    std::memcpy(at, &value, sizeof(T));
+    return at + sizeof(T);
+}
+
+/** @brief Pre-order section entry gathered while walking the tree. */
+struct SectionEntry {
+    const GardenSection* section;
+    std::uint32_t nameId;
+    std::uint32_t parent;
+};
+
+/** @brief Plant paired with the index of the section that holds it. */
+struct PlantEntry {
+    Plant* plant;
+    std::uint32_t section;
+};
+
+} // namespace
+
+/**
+ * @brief Serialises the greenhouse into a single buffer and writes it out.
+ */
+SnapshotStats GreenhouseSnapshot::save(const std::string& path, const GreenHouseManager& greenhouse,
+                                       const Inventory* inventory, const SimulationRandom* rng) {
+    std::unordered_map<const GardenSection*, const std::string*> names;
+    for (const auto& entry : greenhouse.getSectionIndex()) {
+        names[entry.second] = &entry.first;
+    }
+
+    StringTable strings;
+    std::vector<SectionEntry> sections;
+    std::vector<PlantEntry> plants;
+
+    std::vector<std::pair<GardenSection*, std::uint32_t>> pending;
+    pending.push_back(std::make_pair(greenhouse.getRoot(), kNoIndex));
+    while (!pending.empty()) {
+        GardenSection* section = pending.back().first;
+        const std::uint32_t parent = pending.back().second;
+        pending.pop_back();
+
+        const auto nameIt = names.find(section);
+        const std::uint32_t nameId = nameIt != names.end() ? strings.intern(*nameIt->second) : kNoIndex;
+        const auto index = static_cast<std::uint32_t>(sections.size());
+        sections.push_back(SectionEntry{section, nameId, parent});
+
+        const std::vector<GardenComponent*> children = section->getChildren();
+        for (GardenComponent* child : children) {
+            if (child->isLeaf()) {
+                if (auto* plant = dynamic_cast<Plant*>(child)) {
+                    plants.push_back(PlantEntry{plant, index});
+                }
+            }
+        }
+        for (auto it = children.rbegin(); it != children.rend(); ++it) {
+            if (!(*it)->isLeaf()) {
+                if (auto* subsection = dynamic_cast<GardenSection*>(*it)) {
+                    pending.push_back(std::make_pair(subsection, index));
+                }
+            }
+        }
+    }
+
+    std::vector<std::uint32_t> plantNameIds;
+    plantNameIds.reserve(plants.size());
+    const std::string* previousName = nullptr;
+    std::uint32_t previousId = 0;
+    for (const PlantEntry& entry : plants) {
+        const std::string& name = entry.plant->getName();
+        if (previousName == nullptr || name != *previousName) {
+            previousId = strings.intern(name);
+            previousName = &name;
+        }
+        plantNameIds.push_back(previousId);
+    }
+
+    std::vector<std::pair<InventoryCategory, std::pair<std::uint32_t, int>>> stock;
+    if (inventory != nullptr) {
+        for (SkuId sku = 0; static_cast<std::size_t>(sku) < inventory->skuCount(); ++sku) {
+            stock.push_back(std::make_pair(inventory->skuCategory(sku),
+                                           std::make_pair(strings.intern(inventory->skuName(sku)), inventory->getQuantity(sku))));
+        }
+    }
+
+    std::string rngState;
+    if (rng != nullptr) {
+        std::ostringstream oss;
+        oss << *rng;
+        rngState = oss.str();
+    }
+
+    ByteWriter out;
+    out.reserve(64 + plants.size() * kPlantRecordBytes + sections.size() * 8 + rngState.size());
+    out.putBytes(kSnapshotMagic, sizeof(kSnapshotMagic));
+    out.put(kByteOrderMarker);
+    out.put(kSnapshotVersion);
+
+    out.put(static_cast<std::uint32_t>(strings.entries().size()));
+    for (const std::string* value : strings.entries()) {
+        out.putString(*value);
+    }
+
+    out.put(static_cast<std::uint32_t>(sections.size()));
+    for (const SectionEntry& entry : sections) {
+        out.put(entry.nameId);
+        out.put(entry.parent);
+    }
+
+    out.put(static_cast<std::uint64_t>(plants.size()));
+    char* record = out.extend(plants.size() * kPlantRecordBytes);
+    for (std::size_t i = 0; i < plants.size(); ++i) {
+        Plant* plant = plants[i].plant;
+        record = store(record, plantNameIds[i]);
+        record = store(record, plants[i].section);
+        record = store(record, plant->getPrice());
+        record = store(record, plant->getWaterLevel());
+        record = store(record, static_cast<std::int32_t>(plant->getAge()));
+        record = store(record, static_cast<std::uint8_t>(plant->getWaterPreference()));
+        record = store(record, static_cast<std::uint8_t>(plant->getSunlightPreference()));
+        record = store(record, static_cast<std::uint8_t>(plant->getLifecycle()));
+        record = store(record, static_cast<std::uint8_t>(plant->getLocation()));
+    }
+
+    out.put(static_cast<std::uint32_t>(stock.size()));
+    for (const auto& line : stock) {
+        out.put(static_cast<std::uint8_t>(line.first));
+        out.put(line.second.first);
+        out.put(static_cast<std::int32_t>(line.second.second));
+    }
+
+    out.putString(rngState);
+    writeFileBytes(path, out.bytes());
+
+    SnapshotStats stats;
+    stats.sections = sections.size();
+    stats.plants = plants.size();
+    stats.inventoryItems = stock.size();
+    stats.bytes = out.size();
+    return stats;
+}
+
+/**
+ * @brief Bulk-reads a snapshot and rebuilds the composite beneath the root.
+ */
+SnapshotStats GreenhouseSnapshot::restore(const std::string& path, GreenHouseManager& greenhouse,
+                                          Inventory* inventory, SimulationRandom* rng) {
+    GardenSection* root = greenhouse.getRoot();
+    if (!root->getChildren().empty()) {
+        throw std::logic_error("Snapshots can only be restored into an empty greenhouse");
+    }
+
+    const std::vector<char> image = readFileBytes(path);
+    ByteReader in(image.data(), image.size());
+
+    if (std::memcmp(in.take(sizeof(kSnapshotMagic)), kSnapshotMagic, sizeof(kSnapshotMagic)) != 0) {
+        throw std::runtime_error("Not a greenhouse snapshot: " + path);
+    }
+    if (in.get<std::uint32_t>() != kByteOrderMarker) {
+        throw std::runtime_error("Snapshot was written on a host with a different byte order");
+    }
+    if (in.get<std::uint32_t>() != kSnapshotVersion) {
+        throw std::runtime_error("Unsupported snapshot version");
+    }
+
+    const std::uint32_t stringCount = in.get<std::uint32_t>();
+    std::vector<std::string> strings;
+    strings.reserve(stringCount);
+    for (std::uint32_t i = 0; i < stringCount; ++i) {
+        strings.push_back(in.getString());
+    }
+    auto stringAt = [&strings](std::uint32_t id) -> const std::string& {
+        if (id >= strings.size()) {
+            throw std::runtime_error("Snapshot references an unknown string");
+        }
+        return strings[id];
+    };
+
+    const std::uint32_t sectionCount = in.get<std::uint32_t>();
+    std::vector<GardenSection*> sections;
+    std::vector<std::uint32_t> sectionNames;
+    sections.reserve(sectionCount);
+    sectionNames.reserve(sectionCount);
+    for (std::uint32_t i = 0; i < sectionCount; ++i) {
+        const std::uint32_t nameId = in.get<std::uint32_t>();
+        const std::uint32_t parent = in.get<std::uint32_t>();
+        sectionNames.push_back(nameId);
+        if (i == 0) {
+            sections.push_back(root);
+            continue;
+        }
+        if (parent >= sections.size()) {
+            throw std::runtime_error("Snapshot section table is corrupt");
+        }
+        GardenSection* section = nullptr;
+        if (nameId != kNoIndex && sectionNames[parent] != kNoIndex) {
+            const std::string& parentName = parent == 0 ? greenhouse.getRootName() : stringAt(sectionNames[parent]);
+            section = greenhouse.addSection(stringAt(nameId), parentName);
+        } else {
+            section = new GardenSection();
+            sections[parent]->add(section);
+        }
+        sections.push_back(section);
+    }
+    if (sections.empty()) {
+        throw std::runtime_error("Snapshot has no root section");
+    }
+
+    const std::uint64_t plantCount = in.get<std::uint64_t>();
+    if (plantCount > in.remaining() / kPlantRecordBytes) {
+        throw std::runtime_error("Binary image is truncated");
+    }
+    for (std::uint64_t i = 0; i < plantCount; ++i) {
+        const std::uint32_t nameId = in.get<std::uint32_t>();
+        const std::uint32_t sectionIndex = in.get<std::uint32_t>();
+        const double price = in.get<double>();
+        const double waterLevel = in.get<double>();
+        const std::int32_t age = in.get<std::int32_t>();
+        const auto water = in.getEnum(WaterPreference::HIGH, "Snapshot water preference is corrupt");
+        const auto sun = in.getEnum(SunlightPreference::HIGH, "Snapshot sunlight preference is corrupt");
+        const auto lifecycle = in.getEnum(PlantLifecycle::DEAD, "Snapshot lifecycle is corrupt");
+        const auto location = in.getEnum(PlantLocation::INSIDE, "Snapshot plant location is corrupt");
+        if (sectionIndex >= sections.size()) {
+            throw std::runtime_error("Snapshot plant references an unknown section");
+        }
+
+        auto* plant = new Plant(stringAt(nameId), price, createWaterLossStrategy(water),
+                                createSunlightStrategy(sun), createPlantState(lifecycle));
+        plant->restoreCondition(waterLevel, age, location);
+        sections[sectionIndex]->add(plant);
+    }
+
+    const std::uint32_t stockCount = in.get<std::uint32_t>();
+    for (std::uint32_t i = 0; i < stockCount; ++i) {
+        const auto category = in.getEnum(InventoryCategory::WRAPPER, "Snapshot supply category is corrupt");
+        const std::uint32_t nameId = in.get<std::uint32_t>();
+        const std::int32_t quantity = in.get<std::int32_t>();
+        if (inventory != nullptr) {
+            inventory->addStock(category, stringAt(nameId), quantity);
+        }
+    }
+
+    const std::string rngState = in.getString();
+    if (rng != nullptr && !rngState.empty()) {
+        std::istringstream iss(rngState);
+        iss >> *rng;
+        if (!iss || !(iss >> std::ws).eof()) {
+            throw std::runtime_error("Snapshot RNG state is corrupt");
+        }
+    }
+
+    SnapshotStats stats;
+    stats.sections = sections.size();
+    stats.plants = static_cast<std::size_t>(plantCount);
+    stats.inventoryItems = stockCount;
+    stats.bytes = image.size();
+    return stats;
+}
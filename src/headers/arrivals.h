@@ -0,0 +1,83 @@
+/**
+ * @file arrivals.h
+ * @brief Declares hourly arrival-rate profiles and the Poisson sampler drawing customer arrivals from them.
+ *
+ * A profile gives the expected customers in each hour of the day. Within an
+ * hour arrivals form a Poisson process, so gaps between customers are
+ * exponential and the hour's count is Poisson distributed. The sampler emits
+ * arrival times in increasing order one at a time, so a day of millions of
+ * customers needs neither a stored list nor a sort.
+ */
+#ifndef ARRIVALS_H
+#define ARRIVALS_H
+
+#include <random>
+
+#include "randomStream.h"
+
+/**
+ * @brief Expected customer arrivals for each hour of a day.
+ */
+struct ArrivalProfile {
+    /** Hours in a profile. */
+    static const int kHours = 24;
+    /** Expected customers per hour, indexed by hour of day; zero means closed. */
+    double customersPerHour[kHours] = {};
+
+    /**
+     * @brief Expected customers over the whole day.
+     */
+    double expectedCustomers() const;
+    /**
+     * @brief Multiplies every hourly rate by @p factor.
+     * @return This profile, for chaining.
+     * @throws std::invalid_argument When @p factor is negative.
+     */
+    ArrivalProfile& scale(double factor);
+    /**
+     * @brief Profile with the same rate every hour from @p openHour up to, but not including, @p closeHour.
+     * @throws std::invalid_argument When the hours are out of range or the rate is negative.
+     */
+    static ArrivalProfile uniform(double customersPerHour, int openHour = 9, int closeHour = 17);
+    /**
+     * @brief Typical greenhouse day (09:00-17:00) with a late-morning and an after-lunch peak.
+     * @param expectedCustomers Expected customers over the day.
+     */
+    static ArrivalProfile typicalDay(double expectedCustomers);
+};
+
+/**
+ * @brief Draws the arrival times of one day from a profile, in increasing order.
+ */
+class ArrivalSampler {
+  public:
+    /**
+     * @brief Prepares to sample the day starting at @p dayStartMinute.
+     * @param profile Hourly rates; copied.
+     * @param dayStartMinute Simulated minute at which hour 0 of the day begins.
+     */
+    ArrivalSampler(const ArrivalProfile& profile, double dayStartMinute);
+    /**
+     * @brief Draws the next arrival.
+     * @param rng Random source.
+     * @param minute Receives the arrival time in simulated minutes.
+     * @return False once the day has no further arrivals.
+     */
+    bool next(SimulationRandom& rng, double& minute);
+    /**
+     * @brief Draws how many customers arrive over a whole day, without their times.
+     */
+    static long long countDay(const ArrivalProfile& profile, SimulationRandom& rng);
+
+  private:
+    /** Rates of the sampled day. */
+    ArrivalProfile profile;
+    /** Minute at which hour 0 begins. */
+    double dayStart;
+    /** Hour the sampler is currently in. */
+    int hour = 0;
+    /** Time of the previous arrival, or the start of the current hour. */
+    double current;
+};
+
+#endif
@@ -0,0 +1,404 @@
+/**
+ * @file batchRunner.h
+ * @brief Declares the non-interactive simulation driver used by `bin/batch`.
+ *
+ * A @ref BatchConfig is filled from `key=value` settings given as command-line
+ * flags or read from a config file. @ref BatchRunner runs one
+ * @ref Simulation from it with the staff's console chatter discarded and writes the daily
+ * summaries plus wall-clock timing as JSON or CSV. Days are streamed out of the
+ * simulation as they complete, so runs are not limited to 30 days.
+ * @ref MonteCarloRunner repeats the same scenario with many seeds across a
+ * pool of threads and reports per-day distributions.
+ */
+#ifndef BATCHRUNNER_H
+#define BATCHRUNNER_H
+
+#include <cstdint>
+#include <functional>
+#include <istream>
+#include <map>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "simulator.h"
+
+/**
+ * @brief Settings for one unattended simulation run.
+ *
+ * Recognised keys: `days`, `seed`, `stream` (random stream of the seed; Monte
+ * Carlo run i uses stream `stream + i`), `employees`, `plants`
+ * (`name=count,name=count`), `schedule` (`low,medium,high,...`), `catalog`
+ * (CSV plant catalog path), `format` (`json` or `csv`), `output` (file path;
+ * empty for standard output), `verbose` (`true` keeps simulation output),
+ * `runs` (independent seeded runs; more than 1 selects a Monte Carlo report),
+ * `threads` (worker threads for Monte Carlo runs; 0 uses every hardware thread),
+ * `engine` (`loop` or `events`), `servers` (front-desk servers for the event
+ * engine), `service` (mean service minutes for the event engine), `record`
+ * (trace file to record runs to), `replay` (trace file to replay instead of
+ * the scenario), `fast_forward` (`true` skips the event log while replaying),
+ * `checkpoint` (file checkpointed at day boundaries), `checkpoint_every` (days
+ * between checkpoints), `resume` (`true` continues from the checkpoint
+ * file when it exists), `profile_phases` (`true` reports the time and
+ * work of each phase of every day), `popularity` (`name=weight,...`; unlisted
+ * species weigh 1), `products_per_order` (weights of 1, 2, ... products), and
+ * `plants_per_product` (weights of 1, 2, ... plants), `cashiers`, `managers`, and
+ * `caretakers` (employees per role; `employees` sets one cashier, one manager,
+ * and the rest caretakers), `arrivals_low`, `arrivals_medium`, and
+ * `arrivals_high` (`typical N` customers, `uniform R [open close]` customers
+ * per hour, or 24 comma-separated hourly rates), and `sections`
+ * (`name=parent,...`, created in order before plants are placed).
+ *
+ * Files may also group entries under INI-style headers: `[scenario]` takes
+ * the keys above, `[plants]` and `[popularity]` take one `name = value` per
+ * line, `[employees]` takes `cashiers`, `managers`, and `caretakers`,
+ * `[arrivals]` takes `low`, `medium`, and `high`, and `[sections]` takes
+ * `name = parent` in creation order.
+ */
+struct BatchConfig {
+    /** Days to simulate. */
+    int days = 1;
+    /** Whether @ref seed was given. */
+    bool seeded = false;
+    /** RNG seed for reproducible runs; any 64-bit value. */
+    std::uint64_t seed = 0;
+    /** Random stream of @ref seed the run draws from. */
+    std::uint64_t stream = 0;
+    /** Employees to schedule across every role (at least 3). */
+    int employees = 3;
+    /** Cashiers among @ref employees. */
+    int cashiers = 1;
+    /** Managers among @ref employees. */
+    int managers = 1;
+    /** Sections created before plants are placed. */
+    std::vector<SectionLayout> sections;
+    /** Arrival profile per business level; levels not listed keep the simulation default. */
+    std::map<BusinessLevel, ArrivalProfile> arrivals;
+    /** Plants per species; empty uses the simulation default. */
+    std::map<std::string, int> plants;
+    /** Business level per day; empty generates one randomly. */
+    std::vector<BusinessLevel> schedule;
+    /** Plant catalog to load before running; empty keeps the active one. */
+    std::string catalog;
+    /** Report format, "json" or "csv". */
+    std::string format = "json";
+    /** Report destination; empty for standard output. */
+    std::string output;
+    /** Keeps the simulation's console output instead of discarding it. */
+    bool verbose = false;
+    /** Independent runs of the scenario; run i draws from stream @ref stream + i of @ref seed. */
+    int runs = 1;
+    /** Worker threads for Monte Carlo runs; 0 uses std::thread::hardware_concurrency. */
+    int threads = 0;
+    /** Runs days through the discrete-event engine instead of the day loop. */
+    bool eventDriven = false;
+    /** Day shape for the event engine. */
+    EventTiming timing;
+    /** Trace file the run is recorded to; Monte Carlo run i writes `<record>.<i>`. Empty disables recording. */
+    std::string record;
+    /** Trace replayed instead of the configured scenario; empty runs the scenario. */
+    std::string replay;
+    /** Skips the event log while replaying. */
+    bool fastForward = false;
+    /** Checkpoint file written during the run; Monte Carlo run i writes `<checkpoint>.<i>`. Empty disables checkpoints. */
+    std::string checkpoint;
+    /** Completed days between checkpoints. */
+    int checkpointEvery = 1;
+    /** Continues from @ref checkpoint when the file exists; only the resumed days are reported. */
+    bool resume = false;
+    /** Reports @ref DaySummary::phases for every day and in the totals. */
+    bool profilePhases = false;
+    /** Species popularity and order shape. */
+    DemandProfile demand;
+    /** Scenario files given as plain arguments; each is run on top of the other settings by a @ref ScenarioSweep. */
+    std::vector<std::string> scenarios;
+    /** Whether `--help` was given; the driver prints usage instead of running. */
+    bool help = false;
+
+    /**
+     * @brief Applies one setting.
+     * @param key Setting name, without leading dashes.
+     * @param value Setting value.
+     * @throws std::invalid_argument For unknown keys or malformed values.
+     */
+    void set(const std::string& key, const std::string& value);
+    /**
+     * @brief Applies one entry of an INI section, e.g. `rose = 4` under `[plants]`.
+     * @param section Section name without brackets; empty or "scenario" for plain settings.
+     * @throws std::invalid_argument For unknown sections or keys and malformed values.
+     */
+    void set(const std::string& section, const std::string& key, const std::string& value);
+    /**
+     * @brief Applies every `key=value` line of a scenario file in order.
+     *
+     * Blank lines and lines starting with `#` or `;` are skipped, and
+     * `[section]` headers select the section later lines belong to.
+     * @throws std::runtime_error When the file cannot be read.
+     * @throws std::invalid_argument For malformed lines or settings, naming the file and line.
+     */
+    void loadFile(const std::string& path);
+    /**
+     * @brief Applies scenario text as @ref loadFile does; @p source names it in errors.
+     */
+    void load(std::istream& in, const std::string& source);
+    /**
+     * @brief Builds a configuration from `--key=value` / `--key value` flags.
+     *
+     * `--config <path>` applies a file at that point, so later flags override it.
+     * A bare `--verbose` means `--verbose=true`. Arguments without dashes are
+     * collected into @ref scenarios. `--help` or `-h` sets @ref help and stops
+     * parsing.
+     * @throws std::invalid_argument For unknown or malformed flags.
+     */
+    static BatchConfig fromArguments(int argc, char** argv);
+};
+
+/**
+ * @brief Outcome of one batch run.
+ */
+struct BatchResult {
+    /** Summary of every simulated day; empty after @ref BatchRunner::stream. */
+    std::vector<DaySummary> days;
+    /** Milliseconds from the start of the run until each day in @ref days completed. */
+    std::vector<double> elapsedMs;
+    /** Counters summed over every simulated day. */
+    DaySummary totals;
+    /** Number of simulated days. */
+    int daysRun = 0;
+    /** Wall-clock time of @ref Simulation::startSimulation in milliseconds. */
+    double runMs = 0.0;
+    /** Wall-clock time spent configuring the simulation (and loading a catalog) in milliseconds. */
+    double setupMs = 0.0;
+};
+
+/**
+ * @brief Runs a configured simulation without user interaction and reports on it.
+ */
+class BatchRunner {
+  public:
+    /**
+     * @brief Stores the configuration for @ref run.
+     */
+    explicit BatchRunner(const BatchConfig& config);
+    /**
+     * @brief Configures and runs the simulation, discarding its console output unless verbose.
+     * @return Every daily summary, totals, and timing.
+     * @throws std::invalid_argument When the configuration is rejected by the simulation.
+     */
+    BatchResult run() const;
+    /**
+     * @brief Runs like @ref run but writes each day to @p out as soon as it completes.
+     *
+     * Produces the same report as @ref writeReport without keeping the days,
+     * so memory use does not grow with the run length.
+     * @return Totals and timing; @ref BatchResult::days stays empty.
+     */
+    BatchResult stream(std::ostream& out) const;
+    /**
+     * @brief Writes the configuration, timing, and daily summaries as one JSON object.
+     */
+    void writeJson(std::ostream& out, const BatchResult& result) const;
+    /**
+     * @brief Writes one CSV row per day with a header row; `elapsed_ms` is the time since the run started.
+     */
+    void writeCsv(std::ostream& out, const BatchResult& result) const;
+    /**
+     * @brief Writes the report in the configured format.
+     */
+    void writeReport(std::ostream& out, const BatchResult& result) const;
+
+  private:
+    /** Receives each completed day with the milliseconds elapsed since the run started. */
+    using DayCallback = std::function<void(const DaySummary&, double)>;
+
+    /** Runs the configured simulation, filling totals and timing and passing each day to @p onDay. */
+    void execute(BatchResult& result, const DayCallback& onDay) const;
+    /** Opens the JSON report up to the days array. */
+    void writeJsonHeader(std::ostream& out) const;
+    /** Appends one day to the JSON days array. */
+    void writeJsonDay(std::ostream& out, const DaySummary& day, double elapsedMs, bool first) const;
+    /** Closes the JSON days array and adds timing and totals. */
+    void writeJsonFooter(std::ostream& out, const BatchResult& result) const;
+    /** Writes the CSV header row. */
+    void writeCsvHeader(std::ostream& out) const;
+    /** Writes one CSV day row. */
+    void writeCsvRow(std::ostream& out, const DaySummary& day, double elapsedMs) const;
+
+    /** Settings of the run. */
+    BatchConfig config;
+};
+
+/**
+ * @brief Spread of one counter across runs.
+ */
+struct Distribution {
+    double mean = 0.0;
+    /** Sample standard deviation; 0 for a single run. */
+    double stddev = 0.0;
+    double min = 0.0;
+    /** 5th percentile, linearly interpolated between ranks. */
+    double p05 = 0.0;
+    /** Median. */
+    double p50 = 0.0;
+    /** 95th percentile, linearly interpolated between ranks. */
+    double p95 = 0.0;
+    double max = 0.0;
+
+    /**
+     * @brief Summarises a set of samples.
+     * @param samples Values to summarise; reordered in place.
+     */
+    static Distribution of(std::vector<double>& samples);
+};
+
+/**
+ * @brief Distributions of the daily counters for one day across all runs.
+ */
+struct DayDistribution {
+    int dayIndex = 0;
+    Distribution customersServed;
+    Distribution ordersCompleted;
+    Distribution queriesAnswered;
+    Distribution suppliesConsumed;
+    Distribution supplyShortages;
+    /** Front-desk waiting time; zero unless the event engine is used. */
+    Distribution meanWaitMinutes;
+};
+
+/**
+ * @brief Outcome of a Monte Carlo batch.
+ */
+struct MonteCarloResult {
+    /** Seed shared by every run. */
+    std::uint64_t seed = 0;
+    /** Random stream of run 0; run i draws from stream `firstStream + i`. */
+    std::uint64_t firstStream = 0;
+    /** Daily summaries of each run, by run index. */
+    std::vector<std::vector<DaySummary>> runs;
+    /** Per-day distributions across the runs. */
+    std::vector<DayDistribution> days;
+    /** Worker threads used. */
+    unsigned int threads = 0;
+    /** Wall-clock time of the whole batch in milliseconds. */
+    double wallMs = 0.0;
+    /** Sum of the individual run times in milliseconds. */
+    double runMsTotal = 0.0;
+};
+
+/**
+ * @brief Runs independent seeded copies of a scenario across a thread pool.
+ *
+ * Run i always draws from stream `stream + i` of the configured seed (or a
+ * random one), and its results are stored by index, so every run and every
+ * aggregate is the same whatever the thread count or scheduling. Streams
+ * never overlap, unlike the sequences of consecutive seeds.
+ * Simulations share no mutable state: each owns its greenhouse, inventory,
+ * and generator, and product surcharges use per-thread generators seeded by
+ * the simulation.
+ */
+class MonteCarloRunner {
+  public:
+    /**
+     * @brief Stores the scenario; @ref BatchConfig::runs and @ref BatchConfig::threads size the batch.
+     * @throws std::invalid_argument When fewer than one run is requested or the thread count is negative.
+     */
+    explicit MonteCarloRunner(const BatchConfig& scenario);
+    /**
+     * @brief Runs every seed and aggregates the per-day statistics.
+     * @throws std::invalid_argument When the scenario is rejected by the simulation.
+     */
+    MonteCarloResult run() const;
+    /**
+     * @brief Writes the configuration, timing, and per-day distributions as one JSON object.
+     */
+    void writeJson(std::ostream& out, const MonteCarloResult& result) const;
+    /**
+     * @brief Writes one CSV row per day and counter.
+     */
+    void writeCsv(std::ostream& out, const MonteCarloResult& result) const;
+    /**
+     * @brief Writes the report in the configured format.
+     */
+    void writeReport(std::ostream& out, const MonteCarloResult& result) const;
+    /**
+     * @brief Trace or checkpoint file of run @p run when writing to @p base.
+     */
+    static std::string tracePathForRun(const std::string& base, std::size_t run);
+
+  private:
+    /** Scenario shared by every run. */
+    BatchConfig scenario;
+};
+
+/**
+ * @brief Outcome of one scenario file in a sweep.
+ */
+struct SweepEntry {
+    /** Scenario file. */
+    std::string path;
+    /** Totals and timing; @ref BatchResult::days is left empty. */
+    BatchResult result;
+    /** Milliseconds spent reading and parsing the file. */
+    double parseMs = 0.0;
+    /** Why the scenario was rejected or failed; empty when it ran. */
+    std::string error;
+};
+
+/**
+ * @brief Outcome of a sweep over many scenario files.
+ */
+struct SweepResult {
+    /** One entry per file, in the order the files were given. */
+    std::vector<SweepEntry> scenarios;
+    /** Scenarios that were rejected or failed. */
+    std::size_t failed = 0;
+    /** Worker threads used. */
+    unsigned int threads = 0;
+    /** Wall-clock time of the whole sweep in milliseconds. */
+    double wallMs = 0.0;
+};
+
+/**
+ * @brief Runs many scenario files once each across a thread pool and reports their totals.
+ *
+ * Every file is applied on top of a copy of the base settings, so flags act
+ * as defaults the files override. A file that fails to parse or run is
+ * reported and skipped; the rest of the sweep carries on. The plant catalog
+ * is global, so it is taken from the base settings only, and a file naming a
+ * different catalog or more than one run is rejected.
+ */
+class ScenarioSweep {
+  public:
+    /**
+     * @brief Stores the base settings and files; @ref BatchConfig::threads sizes the pool.
+     * @throws std::invalid_argument When no files are given or the thread count is negative.
+     */
+    ScenarioSweep(const BatchConfig& base, const std::vector<std::string>& paths);
+    /**
+     * @brief Parses and runs every file.
+     */
+    SweepResult run() const;
+    /**
+     * @brief Writes the sweep timing and one object per scenario as JSON.
+     */
+    void writeJson(std::ostream& out, const SweepResult& result) const;
+    /**
+     * @brief Writes one CSV row per scenario.
+     */
+    void writeCsv(std::ostream& out, const SweepResult& result) const;
+    /**
+     * @brief Writes the report in the base format.
+     */
+    void writeReport(std::ostream& out, const SweepResult& result) const;
+
+  private:
+    /** Parses and runs one file into @p entry. */
+    void runOne(SweepEntry& entry) const;
+
+    /** Settings every file starts from. */
+    BatchConfig base;
+    /** Scenario files in report order. */
+    std::vector<std::string> paths;
+};
+
+#endif
@@ -0,0 +1,209 @@
+/**
+ * @file binaryIO.h
+ * @brief Declares small helpers for building and parsing binary files.
+ *
+ * Values are encoded in host byte order; callers record a byte-order marker
+ * in their headers so files from an incompatible host are rejected.
+ */
+#ifndef BINARYIO_H
+#define BINARYIO_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+/** @brief Marker written into binary headers to detect byte-order mismatches. */
+constexpr std::uint32_t kByteOrderMarker = 0x01020304u;
+
+/**
+ * @brief Append-only byte buffer used to assemble a binary file in memory.
+ */
+class ByteWriter {
+  public:
+    /**
+     * @brief Appends the raw bytes of a trivially copyable value.
+     * @param value Value to append.
+     */
+    template <typename T> void put(const T& value) {
+        const std::size_t at = buffer.size();
+        buffer.resize(at + sizeof(T));
+        std::memcpy(&buffer[at], &value, sizeof(T));
+    }
+    /**
+     * @brief Appends a length-prefixed string.
+     * @param value String to append; must be shorter than 4 GiB.
+     */
+    void putString(const std::string& value) {
+        put(static_cast<std::uint32_t>(value.size()));
+        buffer.insert(buffer.end(), value.begin(), value.end());
+    }
+    /**
+     * @brief Appends raw bytes without a length prefix.
+     */
+    void putBytes(const void* data, std::size_t size) {
+        if (size == 0) {
+            return;
+        }
+        std::memcpy(extend(size), data, size);
+    }
+    /**
+     * @brief Grows the buffer and returns the start of the new region.
+     * @param count Number of bytes to append; the caller fills them in.
+     */
+    char* extend(std::size_t count) {
+        const std::size_t at = buffer.size();
+        buffer.resize(at + count);
+        return &buffer[at];
+    }
+    /**
+     * @brief Overwrites a previously appended value at an absolute offset.
+     */
+    template <typename T> void patch(std::size_t offset, const T& value) {
+        std::memcpy(&buffer[offset], &value, sizeof(T));
+    }
+    /**
+     * @brief Pre-allocates capacity for the expected file size.
+     */
+    void reserve(std::size_t bytes) { buffer.reserve(bytes); }
+    /**
+     * @brief Current number of bytes written.
+     */
+    std::size_t size() const { return buffer.size(); }
+    /**
+     * @brief Provides the assembled bytes.
+     */
+    const std::vector<char>& bytes() const { return buffer; }
+    /**
+     * @brief Discards the buffered bytes while keeping capacity.
+     */
+    void clear() { buffer.clear(); }
+
+  private:
+    /** Bytes assembled so far. */
+    std::vector<char> buffer;
+};
+
+/**
+ * @brief Bounds-checked cursor over an in-memory binary image.
+ */
+class ByteReader {
+  public:
+    /**
+     * @brief Creates a reader over an externally owned byte range.
+     * @param data First byte of the image.
+     * @param size Number of bytes in the image.
+     */
+    ByteReader(const char* data, std::size_t size) : data(data), size(size), offset(0) {}
+    /**
+     * @brief Reads a trivially copyable value.
+     * @throws std::runtime_error When the image is truncated.
+     */
+    template <typename T> T get() {
+        T value;
+        std::memcpy(&value, take(sizeof(T)), sizeof(T));
+        return value;
+    }
+    /**
+     * @brief Reads a one-byte enumerator, rejecting values past @p last.
+     * @throws std::runtime_error With @p message when the byte names no enumerator.
+     */
+    template <typename Enum> Enum getEnum(Enum last, const char* message) {
+        const std::uint8_t value = get<std::uint8_t>();
+        if (value > static_cast<std::uint8_t>(last)) {
+            throw std::runtime_error(message);
+        }
+        return static_cast<Enum>(value);
+    }
+    /**
+     * @brief Reads a length-prefixed string.
+     * @throws std::runtime_error When the image is truncated.
+     */
+    std::string getString() {
+        const std::uint32_t length = get<std::uint32_t>();
+        const char* raw = take(length);
+        return std::string(raw, length);
+    }
+    /**
+     * @brief Returns a pointer to the next @p count bytes and advances past them.
+     * @throws std::runtime_error When the image is truncated.
+     */
+    const char* take(std::size_t count) {
+        if (count > size - offset) {
+            throw std::runtime_error("Binary image is truncated");
+        }
+        const char* at = data + offset;
+        offset += count;
+        return at;
+    }
+    /**
+     * @brief Indicates whether every byte has been consumed.
+     */
+    bool atEnd() const { return offset == size; }
+    /**
+     * @brief Number of bytes not yet consumed.
+     */
+    std::size_t remaining() const { return size - offset; }
+
+  private:
+    /** Start of the image. */
+    const char* data;
+    /** Total image size. */
+    std::size_t size;
+    /** Current read position. */
+    std::size_t offset;
+};
+
+/**
+ * @brief Reads an entire file with a single bulk read.
+ * @param path File to read.
+ * @return File contents.
+ * @throws std::runtime_error When the file cannot be opened or read.
+ */
+std::vector<char> readFileBytes(const std::string& path);
+
+/**
+ * @brief Writes a byte buffer to a file, replacing any previous contents.
+ * @param path Destination file.
+ * @param bytes Data to write.
+ * @throws std::runtime_error When the file cannot be written.
+ */
+void writeFileBytes(const std::string& path, const std::vector<char>& bytes);
+
+/**
+ * @brief FNV-1a checksum guarding a frame against torn writes.
+ */
+std::uint32_t frameChecksum(const char* data, std::size_t size);
+
+/**
+ * @brief Writes an entire buffer to a file descriptor, retrying short writes.
+ * @throws std::runtime_error When the write fails.
+ */
+void writeAllBytes(int fd, const char* data, std::size_t size);
+
+/**
+ * @brief Flushes file data to stable storage (fsync where fdatasync is unavailable).
+ * @throws std::runtime_error When the sync fails.
+ */
+void syncFileData(int fd);
+
+/**
+ * @brief Replaces a file atomically: write a sibling, sync it, then rename over the target.
+ * @throws std::runtime_error When the file cannot be written or renamed.
+ */
+void replaceFileDurably(const std::string& path, const std::vector<char>& bytes);
+
+/**
+ * @brief Appends bytes to an existing file and syncs them before returning.
+ * @throws std::runtime_error When the file cannot be opened or written.
+ */
+void appendFileDurably(const std::string& path, const std::vector<char>& bytes);
+
+/**
+ * @brief Indicates whether a file can be opened for reading.
+ */
+bool fileExists(const std::string& path);
+
+#endif
@@ -0,0 +1,153 @@
+/**
+ * @file checkpoint.h
+ * @brief Declares incremental mid-run checkpoints from which a simulation resumes.
+ *
+ * A checkpoint file starts with a full frame holding the section tree, every
+ * section's plants, and the run state at a day boundary. Later checkpoints
+ * append delta frames holding the run state and only the sections whose
+ * contents changed, so checkpointing every day stays cheap. Each frame is
+ * checksummed and synced; restoring applies the intact frames and ignores a
+ * torn one at the end.
+ */
+#ifndef CHECKPOINT_H
+#define CHECKPOINT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "inventory.h"
+#include "randomStream.h"
+#include "simulator.h"
+
+class GardenSection;
+class GreenHouseManager;
+
+/**
+ * @brief Mutable state of one employee that outlives a day.
+ */
+struct CheckpointedEmployee {
+    /** Complaints a manager has processed. */
+    int complaints = 0;
+    /** Section a caretaker is assigned to; nullptr for other roles. */
+    GardenSection* homeSection = nullptr;
+};
+
+/**
+ * @brief Run state captured at a day boundary, besides the greenhouse and stock.
+ */
+struct CheckpointState {
+    /** Days completed when the checkpoint was taken. */
+    int day = 0;
+    /** Simulation generator. */
+    SimulationRandom rng;
+    /** Builder-pricing generator of the simulating thread. */
+    SimulationRandom pricing;
+    /** Customers generated so far. */
+    std::int64_t generatedCustomers = 0;
+    /** Manual customers already served. */
+    std::uint64_t manualCustomerIndex = 0;
+    /** SKUs due for delivery at the start of the next day. */
+    std::vector<SkuId> pendingRestocks;
+    /** Employee state in roster order. */
+    std::vector<CheckpointedEmployee> employees;
+    /** Completed days retained by the simulation; filled by @ref SimulationCheckpoint::restore. */
+    std::vector<DaySummary> summaries;
+};
+
+/**
+ * @brief Counts describing the checkpoints written during a run.
+ */
+struct CheckpointStats {
+    /** Frames holding the whole greenhouse. */
+    std::size_t fullFrames = 0;
+    /** Frames holding only changed sections. */
+    std::size_t deltaFrames = 0;
+    /** Sections encoded into frames. */
+    std::size_t sectionsWritten = 0;
+    /** Sections left out of delta frames because they had not changed. */
+    std::size_t sectionsSkipped = 0;
+    /** Bytes written across all frames. */
+    std::size_t bytes = 0;
+    /** Size of the latest frame in bytes, header included. */
+    std::size_t lastFrameBytes = 0;
+};
+
+/**
+ * @brief Writes incremental checkpoints of a running simulation to one file.
+ *
+ * Layout (host byte order, guarded by a byte-order marker): header, then
+ * frames of payload length, checksum, and payload. The first frame is full;
+ * the file is rewritten with a new full frame when the section tree changes or
+ * the deltas since the last full frame reach several times its size, which
+ * bounds both the file and the work of a restore.
+ *
+ * A section is rehashed only when its revision stamp moved, and encoded only
+ * when its contents hash differently from the last ones written; daily
+ * maintenance touches every section even when no plant ends up different.
+ */
+class SimulationCheckpoint {
+  public:
+    /**
+     * @brief Creates a writer; the file is first written by @ref write.
+     * @param path Checkpoint file, replaced by the first frame.
+     */
+    explicit SimulationCheckpoint(const std::string& path);
+    SimulationCheckpoint(const SimulationCheckpoint&) = delete;
+    SimulationCheckpoint& operator=(const SimulationCheckpoint&) = delete;
+
+    /**
+     * @brief Appends a checkpoint of the greenhouse, stock, and run state.
+     * @param greenhouse Manager owning the section tree.
+     * @param inventory Shared supply stock.
+     * @param state Run state at the day boundary; its summaries are ignored.
+     * @param summaries Completed days retained by the simulation; frames store the days not yet written.
+     * @throws std::runtime_error When the file cannot be written.
+     */
+    void write(const GreenHouseManager& greenhouse, const Inventory& inventory, const CheckpointState& state,
+               const std::vector<DaySummary>& summaries);
+    /**
+     * @brief Counters of the frames written so far.
+     */
+    const CheckpointStats& getStats() const { return stats; }
+
+    /**
+     * @brief Rebuilds the greenhouse and stock of the latest intact checkpoint.
+     * @param path Checkpoint file produced by @ref write.
+     * @param greenhouse Manager with an empty root section to populate.
+     * @param inventory Empty inventory that receives the stock lines.
+     * @return Run state of the latest checkpoint, with the summaries of every checkpointed day.
+     * @throws std::runtime_error When the file is missing, incompatible, or has no intact full frame.
+     * @throws std::logic_error When the greenhouse root already has children.
+     */
+    static CheckpointState restore(const std::string& path, GreenHouseManager& greenhouse, Inventory& inventory);
+
+  private:
+    /** Writes a frame holding every section and resets the delta baseline. */
+    void writeFull(const GreenHouseManager& greenhouse, const Inventory& inventory, const CheckpointState& state,
+                   const std::vector<DaySummary>& summaries);
+
+    /** Checkpoint file. */
+    std::string path;
+    /** Sections of the last frame in pre-order. */
+    std::vector<const GardenSection*> sections;
+    /** Names of @ref sections; empty for unnamed sections. */
+    std::vector<std::string> sectionNames;
+    /** Parent index of each of @ref sections. */
+    std::vector<std::uint32_t> sectionParents;
+    /** Revision of each section when it was last encoded. */
+    std::vector<std::uint64_t> revisions;
+    /** Hash of each section's contents when last written. */
+    std::vector<std::uint64_t> hashes;
+    /** Last day whose summary was written. */
+    int lastSummaryDay = 0;
+    /** Size of the last full frame. */
+    std::size_t fullFrameBytes = 0;
+    /** Bytes of delta frames appended since the last full frame. */
+    std::size_t deltaBytes = 0;
+    /** Frame counters. */
+    CheckpointStats stats;
+};
+
+#endif
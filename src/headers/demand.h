@@ -0,0 +1,88 @@
+/**
+ * @file demand.h
+ * @brief Declares weighted customer demand and the alias tables that sample it.
+ *
+ * A @ref DemandProfile says how popular each species is and how many products
+ * and plants a typical order holds. The simulation turns it into
+ * @ref AliasTable "alias tables" once per run, so each customer draws from
+ * them in constant time without rebuilding candidate lists or allocating.
+ */
+#ifndef DEMAND_H
+#define DEMAND_H
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "randomStream.h"
+
+/**
+ * @brief Walker/Vose alias table drawing an index in proportion to fixed weights.
+ *
+ * Building is linear in the number of weights. A draw takes two 32-bit
+ * generator outputs: one picks a column by fixed-point multiplication and the
+ * other decides between the column and its alias against an integer
+ * threshold. Neither needs floating point, so draws are cheap and do not
+ * depend on how the standard library implements its distributions.
+ */
+class AliasTable {
+  public:
+    /**
+     * @brief Creates an empty table; @ref sample must not be called on it.
+     */
+    AliasTable() = default;
+    /**
+     * @brief Builds the table for a set of relative weights.
+     * @param weights Non-negative weights, at least one of them positive.
+     * @throws std::invalid_argument When a weight is negative or not finite, or none is positive.
+     */
+    explicit AliasTable(const std::vector<double>& weights);
+
+    /**
+     * @brief Draws an index with probability proportional to its weight.
+     */
+    std::size_t sample(SimulationRandom& rng) const {
+        const std::uint64_t column = (static_cast<std::uint64_t>(randomBits32(rng)) * keep.size()) >> 32;
+        return static_cast<std::uint64_t>(randomBits32(rng)) < keep[column] ? column : alias[column];
+    }
+    /**
+     * @brief Number of weights the table was built from.
+     */
+    std::size_t size() const { return keep.size(); }
+    /**
+     * @brief Whether the table was built from no weights.
+     */
+    bool empty() const { return keep.empty(); }
+
+  private:
+    /** Chance, scaled by 2^32, that a draw landing in a column keeps it rather than taking its alias. */
+    std::vector<std::uint64_t> keep;
+    /** Index a column hands its remaining share to. */
+    std::vector<std::uint32_t> alias;
+};
+
+/**
+ * @brief Relative popularity of species and the shape of customer orders.
+ */
+struct DemandProfile {
+    /** Relative popularity by species name; selected species not listed weigh 1. */
+    std::map<std::string, double> popularity;
+    /** Relative weight of an order holding 1, 2, ... products. */
+    std::vector<double> productsPerOrder = std::vector<double>(2, 1.0);
+    /** Relative weight of a product holding 1, 2, ... plants. */
+    std::vector<double> plantsPerProduct = std::vector<double>(3, 1.0);
+
+    /**
+     * @brief Checks every weight list without building tables.
+     * @throws std::invalid_argument When a weight is negative or not finite, or a size list has no positive weight.
+     */
+    void validate() const;
+    /**
+     * @brief Popularity of a species, defaulting to 1.
+     */
+    double weightOf(const std::string& species) const;
+};
+
+#endif
@@ -7,6 +7,7 @@
  */
 #pragma once
 #include <string>
+#include <unordered_set>
 #include <vector>
 #include <iostream>
 #include "command.h"
@@ -42,7 +43,7 @@ public:
         } else if (nextHandler) {
             nextHandler->handleRequest(cmd);
         } else {
-            std::cout << "No employee could handle this command.\n";
+            getConsole() << "No employee could handle this command.\n";
             //error handling
         }
     }
@@ -78,6 +79,14 @@ public:
      * @brief Retrieves the greenhouse reference.
      */
     GardenComponent* getGreenhouse() const { return greenhouse; }
+    /**
+     * @brief Directs the employee's console messages to @p out.
+     */
+    void setConsole(std::ostream& out) { console = &out; }
+    /**
+     * @brief Stream receiving the employee's console messages.
+     */
+    std::ostream& getConsole() const { return *console; }
 
 protected:
     /** Descriptive role label (e.g., cashier, manager). */
@@ -90,6 +99,8 @@ protected:
 private:
     /** Next link in the chain of responsibility. */
     Employee* nextHandler = nullptr;
+    /** Destination of console messages, not owned. */
+    std::ostream* console = &std::cout;
     
 };
 
@@ -114,7 +125,29 @@ public:
      * @param req Product specification.
      * @param greenhouse Greenhouse composite for plant lookup.
      */
-    Product* construct(const ProductRequest& req, GardenComponent* greenhouse);//called from Order
+    Product* construct(const ProductRequest& req, GardenComponent* greenhouse);
+    /**
+     * @brief Builds a product from plants already selected for the request.
+     * @param req Product specification.
+     * @param plants Plants to include; an empty list yields nullptr.
+     * @param greenhouse Greenhouse composite the plants are taken from.
+     * @param supplies Inventory debited per item, or nullptr when the order holds a reservation.
+     */
+    Product* construct(const ProductRequest& req, const std::vector<Plant*>& plants,
+                       GardenComponent* greenhouse, Inventory* supplies);//called from Order
+    /**
+     * @brief Selects sellable plants for a request without removing them.
+     * @param req Product specification naming the plants.
+     * @param claimed Plants already promised to this order; selected plants are added.
+     * @return Plants found, possibly fewer than requested.
+     */
+    std::vector<Plant*> collectPlants(const ProductRequest& req, std::unordered_set<const Plant*>& claimed);
+    /**
+     * @brief Lists the supplies a request consumes.
+     * @param req Product specification.
+     * @param plantCount Number of plants the product will actually contain.
+     */
+    std::vector<SupplyLine> requiredSupplies(const ProductRequest& req, std::size_t plantCount) const;
     /**
      * @brief Adds a product to the current order.
      */
@@ -123,11 +156,22 @@ public:
      * @brief Removes a product from the current order.
      */
     void removeItem(Product* product);
+    /**
+     * @brief Sets the shared supply store that constructed products draw from.
+     * @param inventoryPtr Store owned by the simulation, or nullptr for no deductions.
+     */
+    void setInventory(Inventory* inventoryPtr) { inventory = inventoryPtr; }
+    /**
+     * @brief Retrieves the shared supply store.
+     */
+    Inventory* getInventory() const { return inventory; }
 
 
 private:
     /** Concrete builder used for assembling products. */
     Bob* builder;
+    /** Shared supply store; not owned. */
+    Inventory* inventory = nullptr;
     /** Order currently being fulfilled. */
     Order* order;
     /**
@@ -198,6 +242,14 @@ public:
      * @brief Deals with escalated customer requests.
      */
     void handleEscalation();
+    /**
+     * @brief Number of complaints processed so far.
+     */
+    int getComplaintCount() const { return numComplaints; }
+    /**
+     * @brief Restores the complaint count, e.g. when resuming from a checkpoint.
+     */
+    void setComplaintCount(int count) { numComplaints = count; }
 
 private:
     /** Number of complaints processed. */
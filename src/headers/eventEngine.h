@@ -0,0 +1,170 @@
+/**
+ * @file eventEngine.h
+ * @brief Declares the discrete-event core: timestamped events, a pluggable clock, and the dispatch loop.
+ *
+ * Events are small records (time, kind, payload) kept in a binary heap.
+ * Ties are broken by scheduling order, so a run is fully determined by the
+ * order in which events are scheduled. The engine knows nothing about the
+ * greenhouse; callers register one handler per event kind.
+ */
+#ifndef EVENTENGINE_H
+#define EVENTENGINE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <vector>
+
+/** @brief Simulated time in minutes since the simulation started. */
+using SimTime = double;
+
+/**
+ * @brief One scheduled occurrence.
+ */
+struct SimEvent {
+    /** When the event happens. */
+    SimTime time;
+    /** Scheduling order; breaks ties between events at the same time. */
+    std::uint64_t sequence;
+    /** Caller-defined event type used to pick the handler. */
+    std::uint32_t kind;
+    /** Caller-defined argument, e.g. a customer or section index. */
+    std::uint32_t payload;
+};
+
+/**
+ * @brief Source of simulated time that the engine advances to each event.
+ */
+class SimulationClock {
+  public:
+    virtual ~SimulationClock() = default;
+    /**
+     * @brief Moves the clock forward to @p time before an event at that time is handled.
+     */
+    virtual void advanceTo(SimTime time) = 0;
+    /**
+     * @brief Current simulated time.
+     */
+    SimTime now() const { return current; }
+
+  protected:
+    /** Time of the event being handled. */
+    SimTime current = 0.0;
+};
+
+/**
+ * @brief Clock that jumps straight to each event; runs as fast as the handlers allow.
+ */
+class VirtualClock : public SimulationClock {
+  public:
+    void advanceTo(SimTime time) override { current = time; }
+};
+
+/**
+ * @brief Clock that paces simulated time against the wall clock, e.g. for live dashboards.
+ */
+class PacedClock : public SimulationClock {
+  public:
+    /**
+     * @param minutesPerSecond Simulated minutes that pass per wall-clock second.
+     * @throws std::invalid_argument When the rate is not positive.
+     */
+    explicit PacedClock(double minutesPerSecond);
+    /**
+     * @brief Sleeps until the wall clock reaches the moment matching @p time.
+     */
+    void advanceTo(SimTime time) override;
+
+  private:
+    /** Simulated minutes per wall-clock second. */
+    double rate;
+    /** Whether the wall-clock origin has been taken. */
+    bool started = false;
+    /** Simulated time at the wall-clock origin. */
+    SimTime origin = 0.0;
+    /** Wall-clock origin in seconds since the steady clock's epoch. */
+    double wallOrigin = 0.0;
+};
+
+/**
+ * @brief Priority queue of timestamped events with per-kind handlers.
+ */
+class EventEngine {
+  public:
+    /** @brief Reacts to one event; may schedule further events. */
+    using Handler = std::function<void(const SimEvent&)>;
+
+    /**
+     * @brief Creates an empty engine driven by a built-in @ref VirtualClock.
+     */
+    EventEngine();
+    /**
+     * @brief Replaces the clock advanced before each event.
+     * @param clock Clock to use, not owned; nullptr restores the built-in virtual clock.
+     */
+    void setClock(SimulationClock* clock);
+    /**
+     * @brief Registers the handler for an event kind, replacing any previous one.
+     */
+    void on(std::uint32_t kind, Handler handler);
+    /**
+     * @brief Schedules an event at an absolute time.
+     * @throws std::invalid_argument When @p time lies before the current time.
+     */
+    void schedule(SimTime time, std::uint32_t kind, std::uint32_t payload = 0);
+    /**
+     * @brief Schedules an event @p delay minutes after the current time.
+     */
+    void scheduleAfter(SimTime delay, std::uint32_t kind, std::uint32_t payload = 0);
+    /**
+     * @brief Handles events in time order until none is due at or before @p until.
+     * @return Number of events handled.
+     * @throws std::logic_error When an event has no registered handler.
+     */
+    std::size_t run(SimTime until = std::numeric_limits<SimTime>::infinity());
+    /**
+     * @brief Handles the earliest event, if any.
+     * @return False when the queue was empty.
+     */
+    bool step();
+    /**
+     * @brief Reserves room for @p events pending events.
+     */
+    void reserve(std::size_t events);
+    /**
+     * @brief Drops every pending event; the clock is left where it is.
+     */
+    void clear();
+    /**
+     * @brief Time of the event handled last.
+     */
+    SimTime now() const;
+    /**
+     * @brief Number of events waiting to be handled.
+     */
+    std::size_t pending() const { return queue.size(); }
+    /**
+     * @brief Number of events handled since construction.
+     */
+    std::uint64_t processed() const { return handled; }
+
+  private:
+    /** Removes the earliest event and dispatches it. */
+    void dispatchNext();
+
+    /** Min-heap on (time, sequence). */
+    std::vector<SimEvent> queue;
+    /** Handlers by event kind. */
+    std::vector<Handler> handlers;
+    /** Default clock used when none is supplied. */
+    VirtualClock virtualClock;
+    /** Clock advanced before each event. */
+    SimulationClock* clock;
+    /** Sequence number given to the next scheduled event. */
+    std::uint64_t nextSequence = 0;
+    /** Events handled so far. */
+    std::uint64_t handled = 0;
+};
+
+#endif
@@ -0,0 +1,159 @@
+/**
+ * @file eventLog.h
+ * @brief Declares the structured simulation event log kept in a fixed-capacity ring.
+ *
+ * Each significant event is stored as a small fixed-size record (type, day,
+ * ids, numeric payload) instead of a formatted sentence, so logging an order
+ * costs a few stores and no allocation. Text is produced only when the log is
+ * read. Once the ring is full, the oldest records are overwritten.
+ */
+#ifndef EVENTLOG_H
+#define EVENTLOG_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+/**
+ * @brief Kinds of event recorded by the simulation.
+ */
+enum class LogEvent : std::uint32_t {
+    SimulationStarted,
+    DayBegan,
+    DayCompleted,
+    RestockScheduled,
+    RestockDelivered,
+    OrderPlaced,
+    AdviceRequested
+};
+
+/** Marks a record without an interned name. */
+constexpr std::uint32_t kNoName = 0xFFFFFFFFu;
+
+/**
+ * @brief One logged event; the meaning of the numeric fields depends on @ref type.
+ */
+struct LogRecord {
+    /** What happened. */
+    LogEvent type = LogEvent::SimulationStarted;
+    /** Day index the event belongs to; 0 before the first day. */
+    std::uint32_t day = 0;
+    /** Main id, e.g. a generated customer's number or a SKU. */
+    std::uint32_t subject = 0;
+    /** Interned name from @ref EventLog::intern, or @ref kNoName. */
+    std::uint32_t name = kNoName;
+    /** First numeric payload, e.g. a quantity or business level. */
+    std::int32_t value = 0;
+    /** Second numeric payload, e.g. a low-water mark. */
+    std::int32_t extra = 0;
+};
+
+/**
+ * @brief Fixed-capacity ring of structured log records with one writer.
+ *
+ * Records are numbered from zero in the order they are appended. The writer
+ * fills the slot, then publishes the new end position. A reader copies a slot
+ * and keeps the copy only if the writer has not started to overwrite it, so
+ * neither side ever waits. Record fields are relaxed atomics fenced like a
+ * seqlock, which makes reading from another thread race-free. Interned names
+ * are never moved once stored and are published through an atomic count, so
+ * @ref name may also be called from a reader. Appending on a full ring
+ * overwrites the oldest record.
+ */
+class EventLog {
+  public:
+    /**
+     * @brief Creates an empty log.
+     * @param capacity Minimum number of records retained; rounded up to one less than a power of two.
+     * @throws std::invalid_argument When @p capacity is zero.
+     */
+    explicit EventLog(std::size_t capacity = 65535);
+    EventLog(const EventLog&) = delete;
+    EventLog& operator=(const EventLog&) = delete;
+
+    /**
+     * @brief Appends a record, overwriting the oldest one when the ring is full.
+     */
+    void append(const LogRecord& record);
+    /**
+     * @brief Copies the record at @p position.
+     * @return False when the record is not yet written, was discarded, or was overwritten.
+     */
+    bool read(std::uint64_t position, LogRecord& record) const;
+    /**
+     * @brief Position of the oldest retained record.
+     */
+    std::uint64_t begin() const;
+    /**
+     * @brief Position one past the newest record.
+     */
+    std::uint64_t end() const { return head.load(std::memory_order_acquire); }
+    /**
+     * @brief Drops every record before @p position.
+     */
+    void discardBefore(std::uint64_t position);
+    /**
+     * @brief Drops every record; positions keep counting up.
+     */
+    void clear() { discardBefore(end()); }
+    /**
+     * @brief Number of records the ring retains.
+     */
+    std::size_t capacity() const { return mask; }
+    /**
+     * @brief Number of records lost because the ring was full.
+     */
+    std::uint64_t overwritten() const;
+
+    /**
+     * @brief Returns a stable id for @p name, adding it on first use.
+     *
+     * Used for names that cannot be rebuilt from an id, such as SKU and
+     * manually added customer names. Called by the writer only.
+     * @throws std::length_error When every name id is in use.
+     */
+    std::uint32_t intern(const std::string& name);
+    /**
+     * @brief Name interned under @p id.
+     * @throws std::out_of_range For an unknown id.
+     */
+    const std::string& name(std::uint32_t id) const;
+
+  private:
+    /** @brief Ring slot holding one record as relaxed atomic fields. */
+    struct Slot {
+        std::atomic<std::uint32_t> type;
+        std::atomic<std::uint32_t> day;
+        std::atomic<std::uint32_t> subject;
+        std::atomic<std::uint32_t> name;
+        std::atomic<std::int32_t> value;
+        std::atomic<std::int32_t> extra;
+    };
+
+    /** Name segments; segment k holds kFirstNameSegment << k names, so the table grows without moving any. */
+    static constexpr std::size_t kNameSegments = 27;
+    /** Names held by the first segment. */
+    static constexpr std::size_t kFirstNameSegment = 16;
+    /** Locates the segment and offset of name @p id. */
+    static void locateName(std::uint32_t id, std::size_t& segment, std::size_t& offset);
+
+    /** Ring storage. */
+    std::unique_ptr<Slot[]> slots;
+    /** Capacity minus one, used to wrap positions. */
+    std::size_t mask;
+    /** Position of the next record to write. */
+    std::atomic<std::uint64_t> head;
+    /** Records before this position were discarded. */
+    std::atomic<std::uint64_t> floor;
+    /** Interned names by id, allocated a segment at a time. */
+    std::unique_ptr<std::string[]> nameSegments[kNameSegments];
+    /** Number of interned names; stored after the name itself so readers see it complete. */
+    std::atomic<std::uint32_t> nameCount;
+    /** Ids of interned names; touched by the writer only. */
+    std::unordered_map<std::string, std::uint32_t> nameIds;
+};
+
+#endif
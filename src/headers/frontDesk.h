@@ -8,6 +8,7 @@
 #ifndef FRONTDESK_H
 #define FRONTDESK_H
 
+#include <cstddef>
 #include <string>
 #include <vector>
 #include "command.h"
@@ -64,6 +65,10 @@ public:
      * @brief Executes all queued commands using available employees.
      */
     void executeAllCommands();
+    /**
+     * @brief Number of commands queued and not yet executed.
+     */
+    std::size_t pendingCommands() const { return commands.size(); }
     /**
      * @brief Sets the greenhouse root component for operations.
      * @param root Composite root node.
@@ -91,7 +96,7 @@ public:
      * @brief Places an order based on customer product requests.
      * @param reqs Collection of requested products.
      * @param c Customer initiating the order.
-     * @return True if order creation succeeds.
+     * @return True if order creation succeeds; false when it is cancelled for lack of supplies.
      */
     bool placeOrder(std::vector<ProductRequest>& reqs, Customer* c);
 
@@ -8,10 +8,13 @@
 #ifndef GARDEN_H
 #define GARDEN_H
 
+#include <cstdint>
+#include <memory>
 #include <vector>
 
 template <typename T> class Iterator;
 class PlantOnlyIterator;
+class PlantStockIndex;
 
 /**
  * @brief Abstract component in the greenhouse composite structure.
@@ -68,6 +71,11 @@ class GardenComponent {
      * @brief Identifies whether the component is a leaf node.
      */
     virtual bool isLeaf() const = 0;
+    /**
+     * @brief Attaches the component, and any descendants, to a plant stock index.
+     * @param index Index to report to, or nullptr to detach.
+     */
+    virtual void setStockIndex(PlantStockIndex* index) = 0;
 };
 
 /**
@@ -75,6 +83,14 @@ class GardenComponent {
  */
 class GardenSection : public GardenComponent { ///TODO THIS IS JUST HERE FOR TESTING PLEASE CHANGE!!!!!!!!!!! 
   public:
+    /**
+     * @brief Creates an empty section with a fresh revision stamp.
+     */
+    GardenSection();
+    /**
+     * @brief Releases the stock index when this section owns it; children are not deleted.
+     */
+    ~GardenSection() override;
     /**
      * @brief Waters all child components.
      */
@@ -108,7 +124,7 @@ class GardenSection : public GardenComponent { ///TODO THIS IS JUST HERE FOR TES
      */
     std::vector<GardenComponent*> getChildren() const override;
     /**
-     * @brief Removes a child component from the section.
+     * @brief Removes a component from the section or, failing that, from the first subsection holding it.
      */
     void remove(GardenComponent* param) override;
     /**
@@ -119,10 +135,48 @@ class GardenSection : public GardenComponent { ///TODO THIS IS JUST HERE FOR TES
      * @brief Returns false because sections are composite nodes.
      */
     bool isLeaf() const override;
+    /**
+     * @brief Returns a stamp that changes whenever the section or its plants are mutated.
+     *
+     * Stamps are drawn from a process-wide counter, so a new section never
+     * reuses the stamp of a destroyed one.
+     */
+    std::uint64_t getRevision() const { return revision; }
+    /**
+     * @brief Records an external mutation of a plant held directly by this section.
+     */
+    void markChanged();
+    /**
+     * @brief Attaches the section and its subtree to a stock index, dropping any index it owned.
+     */
+    void setStockIndex(PlantStockIndex* index) override;
+    /**
+     * @brief Returns the stock index the section reports to, or nullptr.
+     */
+    PlantStockIndex* getStockIndex() const { return stockIndex; }
+    /**
+     * @brief Returns the section's stock index, creating and owning one for the subtree if needed.
+     *
+     * Creation counts the subtree once; afterwards additions, removals, and
+     * lifecycle changes keep the counts current.
+     */
+    PlantStockIndex& ensureStockIndex();
 
   private:
+    /**
+     * @brief Removes a component from this subtree.
+     * @return True when the component was found and removed.
+     */
+    bool removeFromSubtree(GardenComponent* param);
+
     /** Child components contained within the section. */
     std::vector<GardenComponent*> children;
+    /** Revision stamp updated on every mutation. */
+    std::uint64_t revision;
+    /** Stock index plants in this subtree report to; not owned unless equal to @ref ownedIndex. */
+    PlantStockIndex* stockIndex = nullptr;
+    /** Index created by @ref ensureStockIndex when this section is the indexed root. */
+    std::unique_ptr<PlantStockIndex> ownedIndex;
 };
 
 #endif
@@ -8,11 +8,15 @@
 #ifndef GREENHOUSEMANAGER_H
 #define GREENHOUSEMANAGER_H
 
+#include <memory>
 #include <string>
 #include <unordered_map>
 
 class GardenSection;
+class GreenhouseView;
 class Plant;
+class PlantStockIndex;
+struct SectionView;
 
 /**
  * @brief Maintains indexing and operations for greenhouse sections and plants.
@@ -60,6 +64,24 @@ class GreenHouseManager {
      * @return Pointer when a mature plant is found.
      */
     Plant* findMature(const std::string& name) const;
+    /**
+     * @brief Finds a plant by exact name, or else by the closest catalog name or alias in stock.
+     *
+     * Names of listed species are only matched exactly, so a sold-out species
+     * is never replaced by a similar one.
+     * @param name Plant name, possibly misspelt (e.g. "monstra").
+     * @return Plant of the best-ranked species present in the greenhouse, or nullptr.
+     */
+    Plant* findClosest(const std::string& name) const;
+    /**
+     * @brief Per-species plant counts kept current as plants are added, change stage, or leave.
+     */
+    const PlantStockIndex& getPlantStock() const;
+    /**
+     * @brief Number of mature plants of a species available for sale, in O(1).
+     * @param name Plant name.
+     */
+    int countSellable(const std::string& name) const;
     /**
      * @brief Removes a plant from its section.
      * @param plant Plant pointer to remove.
@@ -76,6 +98,31 @@ class GreenHouseManager {
      * @brief Removes all dead plants from the greenhouse.
      */
     void clearAllDead();
+    /**
+     * @brief Retrieves a section by name.
+     * @param sectionName Name of the section; empty resolves to the root.
+     * @return Section pointer, or nullptr when unknown.
+     */
+    GardenSection* getSection(const std::string& sectionName) const;
+    /**
+     * @brief Provides the name-to-section index, including the root entry.
+     */
+    const std::unordered_map<std::string, GardenSection*>& getSectionIndex() const;
+    /**
+     * @brief Returns the friendly name of the root section.
+     */
+    const std::string& getRootName() const;
+    /**
+     * @brief Captures an immutable view of the greenhouse for reporting.
+     *
+     * Sections whose revision is unchanged since the previous capture, and
+     * whose children are likewise unchanged, are shared with the previous
+     * view instead of being copied. Must be called while no other thread is
+     * mutating the greenhouse; the returned view may then be read freely.
+     * @param dayIndex Day index recorded on the view.
+     * @return Shared, read-only view of the current state.
+     */
+    std::shared_ptr<const GreenhouseView> snapshot(int dayIndex = 0);
 
   private:
     /**
@@ -98,6 +145,12 @@ class GreenHouseManager {
      * @brief Removes a plant from a target section.
      */
     bool removePlantFromSection(GardenSection* section, Plant* plant);
+    /**
+     * @brief Captures a section view, reusing the cached node when nothing changed.
+     */
+    std::shared_ptr<const SectionView> captureSection(
+        GardenSection* section, const std::unordered_map<const GardenSection*, const std::string*>& names,
+        std::unordered_map<const GardenSection*, std::shared_ptr<const SectionView>>& nextCache);
 
     /** Root section pointer for greenhouse structure. */
     GardenSection* root;
@@ -105,6 +158,8 @@ class GreenHouseManager {
     std::unordered_map<std::string, GardenSection*> sectionIndex;
     /** Friendly name for the root section. */
     std::string rootName;
+    /** Section views from the previous capture, keyed by live section. */
+    std::unordered_map<const GardenSection*, std::shared_ptr<const SectionView>> viewCache;
 };
 
 #endif
@@ -0,0 +1,89 @@
+/**
+ * @file greenhouseView.h
+ * @brief Declares immutable greenhouse views used for concurrent reporting.
+ *
+ * A @ref GreenhouseView is a frozen copy of the section tree taken at a day
+ * boundary. Views share unchanged @ref SectionView nodes with earlier views,
+ * so capturing one only copies the sections mutated since the last capture.
+ * Views are never modified after construction and may be read from any
+ * thread while the live greenhouse keeps changing.
+ */
+#ifndef GREENHOUSEVIEW_H
+#define GREENHOUSEVIEW_H
+
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+#include "plant.h"
+
+/**
+ * @brief Frozen copy of the reportable state of one plant.
+ */
+struct PlantView {
+    std::string name;
+    double price;
+    double waterLevel;
+    int age;
+    PlantLifecycle lifecycle;
+    PlantLocation location;
+};
+
+/**
+ * @brief Immutable node of a greenhouse view; shared between views while unchanged.
+ */
+struct SectionView {
+    /** Section name, or empty for sections not indexed by the manager. */
+    std::string name;
+    /** Revision of the live section when this node was captured. */
+    std::uint64_t revision;
+    /** Plants held directly by the section. */
+    std::vector<PlantView> plants;
+    /** Child section nodes. */
+    std::vector<std::shared_ptr<const SectionView>> children;
+};
+
+/**
+ * @brief Consistent read-only view of the whole greenhouse at one point in time.
+ */
+class GreenhouseView {
+  public:
+    /**
+     * @brief Wraps a captured section tree.
+     * @param root Root node of the captured tree.
+     * @param dayIndex Simulation day the view was captured after (0 when unknown).
+     */
+    GreenhouseView(std::shared_ptr<const SectionView> root, int dayIndex);
+    /**
+     * @brief Root node of the captured tree.
+     */
+    const std::shared_ptr<const SectionView>& getRoot() const { return root; }
+    /**
+     * @brief Day index the view was captured after.
+     */
+    int getDayIndex() const { return dayIndex; }
+    /**
+     * @brief Total number of plants in the view.
+     */
+    std::size_t plantCount() const;
+    /**
+     * @brief Counts plants per section, including plants in nested unnamed sections.
+     * @return Plant counts keyed by section name.
+     */
+    std::map<std::string, std::size_t> stockBySection() const;
+    /**
+     * @brief Builds a histogram of plant water levels.
+     * @param buckets Number of equal-width buckets spanning [0, 1]; levels outside are clamped.
+     * @return Plant counts per bucket.
+     */
+    std::vector<std::size_t> waterDistribution(std::size_t buckets) const;
+
+  private:
+    /** Root node of the captured tree. */
+    std::shared_ptr<const SectionView> root;
+    /** Day the view belongs to. */
+    int dayIndex;
+};
+
+#endif
@@ -3,16 +3,43 @@
  * @brief Declares the inventory subsystem tracking greenhouse supplies.
  *
  * Provides an @ref Inventory facade that manages granular categories used for
- * building customer orders and fulfilling plant care requirements.
+ * building customer orders and fulfilling plant care requirements. Each
+ * (category, item) stock line is registered once as a dense SKU id and its
+ * quantity lives in a flat array, so id-based operations are plain array
+ * accesses and the string API is a thin lookup in front of them.
+ *
+ * In concurrent mode the SKU registry is frozen and each quantity is an atomic
+ * counter aligned to its own cache line: lookups are plain reads of immutable
+ * indices and deductions use a compare-and-swap loop that never goes below
+ * zero, so several cashiers can check out at once without a lock.
+ *
+ * Whole orders reserve every supply they need in one step through
+ * @ref Inventory::reserve and then either commit or release the hold, so a
+ * shortage never leaves a partial deduction behind.
+ *
+ * A SKU may carry a low-water mark. The deduction that takes its quantity from
+ * above the mark to at or below it pushes one @ref RestockEvent onto the
+ * attached @ref RestockQueue; the check compares the counts before and after
+ * that single deduction, so it costs O(1) and never scans other SKUs. A
+ * reservation raises its crossings when committed, so a hold that is rolled
+ * back or released never asks for a restock.
  */
 #ifndef INVENTORY_H
 #define INVENTORY_H
 
+#include <atomic>
+#include <cstdint>
+#include <new>
 #include <string>
-#include <map>
 #include <stdexcept>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 class GardenComponent;
+class InventoryJournal;
+class PlantStockIndex;
+class RestockQueue;
 
 enum class InventoryCategory{
     PLANT,
@@ -22,6 +49,53 @@ enum class InventoryCategory{
     WRAPPER,
 };
 
+/** @brief Dense identifier of a registered (category, item) stock line. */
+using SkuId = int;
+
+/** @brief Sentinel returned when a stock line is not registered. */
+constexpr SkuId kInvalidSku = -1;
+
+/**
+ * @brief One (category, item, quantity) supply requirement or stock line.
+ */
+struct SupplyLine {
+    InventoryCategory category;
+    std::string item;
+    int quantity;
+};
+
+class Inventory;
+
+/**
+ * @brief Supplies held back from stock for one order until committed or released.
+ *
+ * Releases any still-held units on destruction.
+ */
+class SupplyReservation {
+    public:
+        SupplyReservation() = default;
+        SupplyReservation(const SupplyReservation&) = delete;
+        SupplyReservation& operator=(const SupplyReservation&) = delete;
+        ~SupplyReservation();
+        /**
+         * @brief Indicates whether units are currently held.
+         */
+        bool isActive() const { return owner != nullptr; }
+        /**
+         * @brief Held units per SKU, ordered by SKU id.
+         */
+        const std::vector<std::pair<SkuId, int>>& getHeld() const { return held; }
+
+    private:
+        friend class Inventory;
+        /** Inventory holding the units, or nullptr once settled. */
+        Inventory* owner = nullptr;
+        /** (SKU id, units) pairs, one per distinct SKU. */
+        std::vector<std::pair<SkuId, int>> held;
+        /** Quantity each hold was taken from, parallel to @ref held, for low-water checks on commit. */
+        std::vector<int> takenFrom;
+};
+
 /**
  * @brief Central store managing counts of greenhouse supplies by category.
  */
@@ -32,7 +106,8 @@ class Inventory {
          * @param category Inventory bucket to update.
          * @param item Descriptive key for the stock line.
          * @param quantity Number of units to increase.
-         * @return True if the addition succeeded.
+         * @return True if the addition succeeded; always false for PLANT, whose
+         *         stock enters by adding plants to the greenhouse.
          */
         bool addStock(InventoryCategory category, const std::string& item, int quantity);
         /**
@@ -41,6 +116,7 @@ class Inventory {
          * @param item Item identifier to reduce stock for.
          * @param quantity Units requested.
          * @return True when the requested quantity was available and deducted.
+         *         For PLANT, sells (removes and deletes) that many mature plants.
          */
         bool useItem(InventoryCategory category, const std::string& item, int quantity);
         /**
@@ -54,9 +130,132 @@ class Inventory {
          * @brief Returns remaining quantity for an inventory item.
          * @param category Inventory bucket to inspect.
          * @param item Item identifier to inspect.
-         * @return Current quantity, or zero when absent.
+         * @return Current quantity, or -1 when the item is not tracked. For PLANT,
+         *         the number of sellable plants, read from the greenhouse's
+         *         per-species counters in O(1).
          */
         int getQuantity(InventoryCategory category, const std::string& item) const;
+        /**
+         * @brief Lists every tracked item and its quantity within a category.
+         * @param category Inventory bucket to enumerate.
+         * @return Item/quantity pairs ordered by item name.
+         */
+        std::vector<std::pair<std::string, int>> listItems(InventoryCategory category) const;
+        /**
+         * @brief Resolves a stock line to its SKU id without registering it.
+         * @param category Inventory bucket of the item.
+         * @param item Item identifier.
+         * @return SKU id, or @ref kInvalidSku when the line is unknown.
+         */
+        SkuId findSku(InventoryCategory category, const std::string& item) const;
+        /**
+         * @brief Resolves a stock line to its SKU id, registering it with zero stock if new.
+         * @param category Inventory bucket of the item.
+         * @param item Item identifier.
+         * @return Dense SKU id.
+         * @throws std::logic_error When a new line is registered in concurrent mode.
+         */
+        SkuId registerSku(InventoryCategory category, const std::string& item);
+        /**
+         * @brief Adds units to a registered SKU.
+         * @return True when the SKU is valid and the quantity non-negative.
+         */
+        bool addStock(SkuId sku, int quantity);
+        /**
+         * @brief Deducts units from a registered SKU when enough are available.
+         * @return True when the requested quantity was available and deducted.
+         */
+        bool useItem(SkuId sku, int quantity);
+        /**
+         * @brief Returns the quantity held for a registered SKU.
+         * @return Current quantity, or -1 for an invalid SKU.
+         */
+        int getQuantity(SkuId sku) const;
+        /**
+         * @brief Number of registered SKUs; valid ids are [0, skuCount()).
+         */
+        std::size_t skuCount() const;
+        /**
+         * @brief Category of a registered SKU.
+         */
+        InventoryCategory skuCategory(SkuId sku) const;
+        /**
+         * @brief Item name of a registered SKU.
+         */
+        const std::string& skuName(SkuId sku) const;
+        /**
+         * @brief Holds every supply line of an order, or none of them.
+         *
+         * Lines are resolved in one batch, merged per SKU, and applied in SKU
+         * id order. Held units leave the available quantity immediately but are
+         * only counted as consumed on @ref commit.
+         * @param lines Supplies required by the order; duplicates are merged.
+         * @param reservation Inactive reservation receiving the held units.
+         * @return False, leaving stock untouched, when any line is unknown or short.
+         * @throws std::logic_error When @p reservation is already active.
+         */
+        bool reserve(const std::vector<SupplyLine>& lines, SupplyReservation& reservation);
+        /**
+         * @brief Consumes the units held by a reservation and raises any low-water crossings it caused.
+         */
+        void commit(SupplyReservation& reservation);
+        /**
+         * @brief Returns the units held by a reservation to stock.
+         */
+        void release(SupplyReservation& reservation);
+        /**
+         * @brief Total units successfully deducted since construction.
+         */
+        long long getUnitsConsumed() const;
+        /**
+         * @brief Number of deductions refused for unknown items or insufficient stock.
+         */
+        long long getShortageCount() const;
+        /**
+         * @brief Switches between single-threaded and concurrent stock updates.
+         *
+         * While enabled, @ref registerSku refuses new stock lines and stock
+         * updates are atomic. Must not be toggled while other threads use the
+         * inventory.
+         * @param enabled True to freeze the registry and use atomic counters.
+         */
+        void setConcurrent(bool enabled) { concurrent = enabled; }
+        /**
+         * @brief Indicates whether concurrent mode is enabled.
+         */
+        bool isConcurrent() const { return concurrent; }
+        /**
+         * @brief Routes every successful supply mutation to a write-ahead journal.
+         * @param journalPtr Journal receiving deltas, or nullptr to stop journaling.
+         */
+        void setJournal(InventoryJournal* journalPtr) { journal = journalPtr; }
+        /**
+         * @brief Subscribes a SKU to low-stock notifications.
+         * @param sku Registered SKU to watch.
+         * @param threshold Quantity at or below which a restock is wanted; negative unsubscribes.
+         * @return False when @p sku is not registered.
+         */
+        bool setLowWaterMark(SkuId sku, int threshold);
+        /**
+         * @brief Subscribes a stock line to low-stock notifications by name.
+         * @return False when the line is not registered.
+         * @throws std::invalid_argument For PLANT, which has no supply stock.
+         */
+        bool setLowWaterMark(InventoryCategory category, const std::string& item, int threshold);
+        /**
+         * @brief Low-water mark of a SKU.
+         * @return Threshold, or -1 when the SKU is unwatched or invalid.
+         */
+        int getLowWaterMark(SkuId sku) const;
+        /**
+         * @brief Directs low-water crossings to a queue.
+         * @param queue Queue receiving @ref RestockEvent entries, or nullptr to stop notifying; not owned.
+         */
+        void setRestockQueue(RestockQueue* queue) { restockQueue = queue; }
+        /**
+         * @brief Number of crossings lost because the restock queue was full.
+         */
+        long long getDroppedRestockEvents() const { return droppedRestockEvents.load(std::memory_order_relaxed); }
         /**
          * @brief Binds the inventory to the greenhouse composite for lookups.
          * @param plants Root component of the greenhouse composite.
@@ -64,18 +263,118 @@ class Inventory {
         explicit Inventory(GardenComponent* plants) ;
 
     private:
+        friend class InventoryJournal;
+        /** Number of categories, used to size the per-category indices. */
+        static constexpr int kCategoryCount = 5;
+        /** Bytes each stock slot occupies, matching a typical cache line. */
+        static constexpr std::size_t kCacheLineSize = 64;
+        /**
+         * @brief Retrieves the modifiable name index for a stock category.
+         * @throws std::invalid_argument When the category has no supply stock.
+         */
+        std::unordered_map<std::string, SkuId>& indexForCategory(InventoryCategory category);
+        /**
+         * @brief Retrieves the read-only name index for a stock category.
+         * @throws std::invalid_argument When the category has no supply stock.
+         */
+        const std::unordered_map<std::string, SkuId>& indexForCategory(InventoryCategory category) const;
+        /** Indicates whether @p sku refers to a registered stock line. */
+        bool isValidSku(SkuId sku) const;
+        /**
+         * @brief Stock index of the bound section, or nullptr when it has none.
+         *
+         * Never creates one: attaching an index rewires the whole subtree, which a
+         * const read must not do while other threads walk it. @ref GreenHouseManager
+         * indexes its root on construction.
+         */
+        PlantStockIndex* plantStock() const;
+        /** Removes and deletes @p quantity mature plants named @p item, or none. */
+        bool sellPlants(const std::string& item, int quantity);
+        /**
+         * @brief Deducts units from a slot without touching counters or notifying.
+         * @param before Receives the quantity the deduction was applied to.
+         */
+        bool takeUnits(SkuId sku, int quantity, int& before);
+        /** Adds units back to a slot. */
+        void putUnits(SkuId sku, int quantity);
+        /**
+         * @brief Applies a journaled signed delta as recorded, for recovery.
+         *
+         * Concurrent updates journal their deltas after the atomic update, so a
+         * deduction can appear before the addition it depended on. Replaying it
+         * through @ref useItem would refuse it, so this never refuses, counts,
+         * or notifies; the count may dip below zero until the addition follows.
+         * @return False when @p sku is not registered.
+         */
+        bool adjustUnits(SkuId sku, int delta);
+        /** Queues a restock event when a deduction from @p before crossed the slot's mark. */
+        void notifyIfCrossed(SkuId sku, int before, int after);
+
+        /** @brief Registry entry describing one stock line. */
+        struct SkuInfo {
+            InventoryCategory category;
+            std::string name;
+        };
+        /** Item name to SKU id, one index per category. */
+        std::unordered_map<std::string, SkuId> skuIndex[kCategoryCount];
         /**
-         * @brief Retrieves a modifiable reference to the map for a category.
-         * @throws std::out_of_range When the category is invalid.
+         * @brief Per-SKU counters, aligned to a cache line so hot SKUs do not share one.
+         *
+         * Copying is only used while the vector grows during registration, which
+         * concurrent mode forbids.
          */
-        std::map<std::string, int>& mapForCategory(InventoryCategory category);
+        struct alignas(kCacheLineSize) StockSlot {
+            std::atomic<long long> consumed;
+            std::atomic<long long> shortages;
+            std::atomic<int> quantity;
+            /** Low-water mark; negative when unwatched. */
+            std::atomic<int> lowWaterMark;
+
+            StockSlot() : consumed(0), shortages(0), quantity(0), lowWaterMark(-1) {}
+            StockSlot(const StockSlot& other)
+                : consumed(other.consumed.load(std::memory_order_relaxed)),
+                  shortages(other.shortages.load(std::memory_order_relaxed)),
+                  quantity(other.quantity.load(std::memory_order_relaxed)),
+                  lowWaterMark(other.lowWaterMark.load(std::memory_order_relaxed)) {}
+        };
         /**
-         * @brief Retrieves a read-only reference to the map for a category.
-         * @throws std::out_of_range When the category is invalid.
+         * @brief Allocator placing every block on a cache-line boundary.
+         *
+         * C++11 operator new only guarantees fundamental alignment, so each block
+         * is over-allocated, aligned by hand, and prefixed with the raw pointer.
          */
-        const std::map<std::string, int>& mapForCategory(InventoryCategory category) const;
-        /** Container inventory keyed by item name. */
-        std::map<std::string, int> containers, soil, wrappers, cards;
+        template <typename T> struct CacheLineAllocator {
+            using value_type = T;
+
+            CacheLineAllocator() = default;
+            template <typename U> CacheLineAllocator(const CacheLineAllocator<U>&) {}
+
+            T* allocate(std::size_t count) {
+                char* raw = static_cast<char*>(::operator new(count * sizeof(T) + sizeof(void*) + kCacheLineSize - 1));
+                const std::uintptr_t start = reinterpret_cast<std::uintptr_t>(raw + sizeof(void*));
+                void** aligned = reinterpret_cast<void**>((start + kCacheLineSize - 1) & ~(kCacheLineSize - 1));
+                aligned[-1] = raw;
+                return reinterpret_cast<T*>(aligned);
+            }
+            void deallocate(T* block, std::size_t) { ::operator delete(reinterpret_cast<void**>(block)[-1]); }
+
+            template <typename U> bool operator==(const CacheLineAllocator<U>&) const { return true; }
+            template <typename U> bool operator!=(const CacheLineAllocator<U>&) const { return false; }
+        };
+        /** Registered stock lines indexed by SKU id. */
+        std::vector<SkuInfo> skus;
+        /** Stock counters indexed by SKU id, each starting on its own cache line. */
+        std::vector<StockSlot, CacheLineAllocator<StockSlot>> slots;
+        /** Refused @ref useItem calls for unknown SKUs. */
+        std::atomic<long long> unknownSkuRequests{0};
+        /** Whether the registry is frozen and updates are atomic. */
+        bool concurrent = false;
+        /** Journal notified of committed deltas; not owned. */
+        InventoryJournal* journal = nullptr;
+        /** Queue receiving low-water crossings; not owned. */
+        RestockQueue* restockQueue = nullptr;
+        /** Crossings refused by a full @ref restockQueue. */
+        std::atomic<long long> droppedRestockEvents{0};
         /**
          * @brief Head of the greenhouse composite for iterating plant stock.
          */
@@ -0,0 +1,136 @@
+/**
+ * @file inventoryJournal.h
+ * @brief Declares the write-ahead journal that makes Inventory stock crash-safe.
+ *
+ * Every successful stock mutation is appended to an in-memory batch as a
+ * (SKU, delta) record. When the batch reaches the configured group size it is
+ * written to the journal file as one checksummed frame with a single
+ * `write` followed by one `fdatasync`. Periodic checkpoints store the whole
+ * SKU table compactly under one checksum and start a fresh journal, so recovery loads the last
+ * checkpoint and replays only the frames written after it.
+ */
+#ifndef INVENTORYJOURNAL_H
+#define INVENTORYJOURNAL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+
+#include "binaryIO.h"
+#include "inventory.h"
+
+/**
+ * @brief Counters describing journal activity since it was opened.
+ */
+struct JournalStats {
+    /** Stock lines loaded from the checkpoint during recovery. */
+    std::size_t checkpointLines = 0;
+    /** Delta records replayed from the journal during recovery. */
+    std::size_t replayedRecords = 0;
+    /** Delta records appended since the journal was opened. */
+    std::size_t appendedRecords = 0;
+    /** Group commits (one write plus one data sync each). */
+    std::size_t commits = 0;
+    /** Checkpoints written. */
+    std::size_t checkpoints = 0;
+};
+
+/**
+ * @brief Append-only, group-committed journal of Inventory deltas with checkpoints.
+ *
+ * Files are `<basePath>.journal` and `<basePath>.checkpoint`. Both carry a
+ * generation number; a journal is replayed only on top of the checkpoint of
+ * the same generation, so a crash between writing a checkpoint and resetting
+ * the journal never applies a delta twice. Units held by an uncommitted
+ * @ref SupplyReservation are not journaled and return to stock on recovery.
+ */
+class InventoryJournal {
+  public:
+    /**
+     * @brief Recovers @p inventory from disk, then journals its future mutations.
+     * @param inventory Inventory with no registered SKUs; receives the recovered stock.
+     * @param basePath Path prefix of the journal and checkpoint files.
+     * @param commitBatch Records buffered per group commit; 1 syncs every mutation.
+     * @throws std::logic_error When @p inventory already has SKUs.
+     * @throws std::runtime_error When the files are unreadable, incompatible, or the checkpoint is corrupt.
+     */
+    InventoryJournal(Inventory& inventory, const std::string& basePath, std::size_t commitBatch = 64);
+    /**
+     * @brief Commits buffered records and detaches from the inventory.
+     */
+    ~InventoryJournal();
+    InventoryJournal(const InventoryJournal&) = delete;
+    InventoryJournal& operator=(const InventoryJournal&) = delete;
+
+    /**
+     * @brief Buffers one stock change; called by @ref Inventory after a successful mutation.
+     * @param sku SKU whose quantity changed.
+     * @param delta Units added (positive) or consumed (negative).
+     */
+    void recordDelta(SkuId sku, int delta);
+    /**
+     * @brief Writes and syncs every buffered record as one frame.
+     */
+    void flush();
+    /**
+     * @brief Writes a compacted checkpoint of the SKU table and starts an empty journal.
+     *
+     * In concurrent mode the inventory must be quiescent while this runs.
+     */
+    void checkpoint();
+    /**
+     * @brief Sets how many records may accumulate before an automatic checkpoint.
+     * @param records Record count; 0 disables automatic checkpoints.
+     *
+     * Automatic checkpoints are skipped while the inventory is in concurrent mode.
+     */
+    void setCheckpointInterval(std::size_t records) { checkpointInterval = records; }
+    /**
+     * @brief Returns recovery and activity counters.
+     */
+    JournalStats getStats() const;
+
+  private:
+    /** Loads the checkpoint and replays the matching journal into the inventory. */
+    void recover();
+    /** Replays complete frames and returns the byte length of the valid journal prefix. */
+    std::size_t replay(const std::vector<char>& image);
+    /** Opens the journal for appending, truncated to @p validBytes or newly created. */
+    void openJournal(std::size_t validBytes);
+    /** Appends DEFINE records for SKUs registered since the last definition. */
+    void defineNewSkus();
+    /** Writes and syncs the pending frame; the caller holds @ref mutex. */
+    void flushLocked();
+    /** Writes the checkpoint; the caller holds @ref mutex. */
+    void checkpointLocked();
+
+    /** Journaled inventory. */
+    Inventory& inventory;
+    /** Path of the journal file. */
+    std::string journalPath;
+    /** Path of the checkpoint file. */
+    std::string checkpointPath;
+    /** Records per group commit. */
+    std::size_t commitBatch;
+    /** Records between automatic checkpoints. */
+    std::size_t checkpointInterval = 100000;
+    /** Generation shared by the current checkpoint and journal. */
+    std::uint64_t generation = 0;
+    /** Open journal descriptor. */
+    int fd = -1;
+    /** Records of the frame being assembled. */
+    ByteWriter pending;
+    /** Delta records in @ref pending. */
+    std::size_t pendingRecords = 0;
+    /** SKUs already defined in the current journal. */
+    std::size_t definedSkus = 0;
+    /** Records appended since the last checkpoint. */
+    std::size_t recordsSinceCheckpoint = 0;
+    /** Activity counters. */
+    JournalStats stats;
+    /** Serialises appends, commits, and checkpoints. */
+    mutable std::mutex mutex;
+};
+
+#endif
@@ -52,8 +52,15 @@ class Order {
          * @param s New status value.
          */
         void updateStatus(OrderStatus s);
+        /**
+         * @brief Returns the current order status.
+         */
+        OrderStatus getStatus() const;
         /**
          * @brief Finalizes the order by building requested products.
+         *
+         * Supplies for the whole order are reserved up front; on a shortage the
+         * order is cancelled and nothing is built or deducted.
          * @param greenhouse Greenhouse composite for resource lookup.
          */
         void finaliseOrder(GardenComponent* greenhouse);
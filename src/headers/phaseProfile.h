@@ -0,0 +1,120 @@
+/**
+ * @file phaseProfile.h
+ * @brief Declares the per-phase timers and counters of a simulated day.
+ *
+ * A @ref PhaseTimer brackets one phase of a day. While it is alive, the
+ * calling thread's plant visits, heap allocations, and executed commands are
+ * counted into it; when it ends, they and the elapsed time are added to the
+ * phase's @ref PhaseStats. Without a timer the counting sites only test a
+ * thread-local pointer, so runs that do not profile pay next to nothing.
+ * Allocations are only counted in executables that link the replacement
+ * operator new in src/profile/allocationCounter.cpp.
+ */
+#ifndef PHASEPROFILE_H
+#define PHASEPROFILE_H
+
+#include <chrono>
+
+/** @brief Phases of a simulated day, in the order they run. */
+enum class DayPhase {
+    /** Queueing watering and moving commands for every section. */
+    SCHEDULE_MAINTENANCE = 0,
+    /** Executing the queued maintenance commands. */
+    MAINTENANCE_COMMANDS = 1,
+    /** Serving customers. */
+    CUSTOMERS = 2,
+    /** Executing the requests customers left at the front desk. */
+    CUSTOMER_COMMANDS = 3,
+    /** Removing dead plants. */
+    CLEAR_DEAD = 4
+};
+
+/** @brief Number of @ref DayPhase values. */
+constexpr int kDayPhaseCount = 5;
+
+/**
+ * @brief Name of a phase as used in reports, e.g. "schedule_maintenance".
+ */
+const char* dayPhaseName(DayPhase phase);
+
+/**
+ * @brief Work counted on one thread while a phase runs.
+ */
+struct PhaseCounters {
+    /** Plants whose state was read or updated. */
+    long long plantsVisited = 0;
+    /** Calls to the global operator new; stays 0 unless @ref allocationCountingLinked. */
+    long long allocations = 0;
+    /** Front-desk commands executed. */
+    long long commandsExecuted = 0;
+};
+
+/**
+ * @brief Time and work spent in one phase of a day.
+ */
+struct PhaseStats {
+    /** Wall-clock milliseconds spent in the phase. */
+    double elapsedMs = 0.0;
+    /** Work counted while the phase ran. */
+    PhaseCounters counters;
+};
+
+/** @brief Counters of the phase running on this thread, or nullptr when none is timed. */
+extern thread_local PhaseCounters* activePhaseCounters;
+
+/**
+ * @brief Whether the allocation-counting operator new is linked into this executable.
+ *
+ * Set during static initialisation by src/profile/allocationCounter.cpp, which
+ * only the benchmark and batch executables link. Reports show allocations as
+ * unavailable while it is false.
+ */
+extern bool allocationCountingLinked;
+
+/** @brief Counts plants visited by the current phase. */
+inline void countPlantVisits(long long plants) {
+    if (PhaseCounters* counters = activePhaseCounters) {
+        counters->plantsVisited += plants;
+    }
+}
+
+/** @brief Counts one command executed by the current phase. */
+inline void countCommandExecuted() {
+    if (PhaseCounters* counters = activePhaseCounters) {
+        counters->commandsExecuted++;
+    }
+}
+
+/**
+ * @brief Times one phase and counts its work for as long as it is in scope.
+ *
+ * Timers nest: an inner timer counts into its own phase only, and the outer
+ * one resumes counting when it ends. The outer phase's elapsed time still
+ * includes the inner one.
+ */
+class PhaseTimer {
+  public:
+    /**
+     * @brief Starts timing.
+     * @param target Phase the time and counters are added to; nullptr disables the timer.
+     */
+    explicit PhaseTimer(PhaseStats* target);
+    /**
+     * @brief Adds the elapsed time and counters to the target phase.
+     */
+    ~PhaseTimer();
+    PhaseTimer(const PhaseTimer&) = delete;
+    PhaseTimer& operator=(const PhaseTimer&) = delete;
+
+  private:
+    /** Phase being timed, or nullptr. */
+    PhaseStats* target;
+    /** Counters of the enclosing timer, restored on exit. */
+    PhaseCounters* outer;
+    /** Work counted by this timer. */
+    PhaseCounters counted;
+    /** When the timer started. */
+    std::chrono::steady_clock::time_point start;
+};
+
+#endif
@@ -20,6 +20,11 @@ class PlantState;
  */
 enum class PlantLocation { OUTSIDE, GREENHOUSE, INSIDE };
 
+/**
+ * @brief Enumerates the lifecycle stages modelled by the plant state machine.
+ */
+enum class PlantLifecycle { SEEDLING, MATURE, DEAD };
+
 /**
  * @brief Strategy interface controlling how plants lose water over time.
  */
@@ -145,9 +150,12 @@ class Plant : public GardenComponent {
         Plant(std::string name , double price , WaterLossStrategy* waterLossStrategy , SunlightStrategy* sunlightStrategy , PlantState* state) ;
         /**
          * @brief Copy constructor for duplicating plants.
+         *
+         * Strategies and state are recreated rather than shared, and the copy
+         * starts detached from any stock index.
          * @param other Plant to copy from.
          */
-        Plant(const Plant& other) = default;//TODO add to UML. changeeeeeee
+        Plant(const Plant& other);//TODO add to UML. changeeeeeee
         /**
          * @brief Destroys the plant and associated strategy/state objects.
          */
@@ -243,6 +251,34 @@ class Plant : public GardenComponent {
          * @brief Attempts to advance growth based on current resources.
          */
         void tryGrow();
+        /**
+         * @brief Reports the lifecycle stage of the current state object.
+         */
+        PlantLifecycle getLifecycle() const;
+        /**
+         * @brief Accessor for the current water level.
+         */
+        double getWaterLevel() const;
+        /**
+         * @brief Accessor for the number of growth cycles completed.
+         */
+        int getAge() const;
+        /**
+         * @brief Accessor for the location chosen by the sunlight strategy.
+         */
+        PlantLocation getLocation() const;
+        /**
+         * @brief Reinstates previously captured condition values without triggering transitions.
+         * @param water Water level to restore.
+         * @param plantAge Growth cycles to restore.
+         * @param plantLocation Location to restore.
+         */
+        void restoreCondition(double water, int plantAge, PlantLocation plantLocation);
+        /**
+         * @brief Moves the plant's count to another stock index.
+         * @param index Index to report lifecycle changes to, or nullptr.
+         */
+        void setStockIndex(PlantStockIndex* index) override;
 
     private:
         /** Strategy controlling water dehydration. */
@@ -261,6 +297,8 @@ class Plant : public GardenComponent {
         double waterLevel;
         /** Number of growth cycles completed. */
         int age;
+        /** Stock index counting this plant while it sits in an indexed greenhouse. */
+        PlantStockIndex* stockIndex = nullptr;
         
 };
 
@@ -309,6 +347,10 @@ class PlantState {
      * @brief Processes water loss behavior for the state.
      */
     virtual void handleLoseWater() = 0;
+    /**
+     * @brief Identifies the lifecycle stage this state represents.
+     */
+    virtual PlantLifecycle lifecycle() const = 0;
 
   protected:
     /** Plant that owns this state instance. */
@@ -345,6 +387,10 @@ class SeedlingState : public PlantState {
      * @copydoc PlantState::handleLoseWater()
      */
     void handleLoseWater() override;
+    /**
+     * @copydoc PlantState::lifecycle()
+     */
+    PlantLifecycle lifecycle() const override;
 };
 
 /**
@@ -377,6 +423,10 @@ class MatureState : public PlantState {
      * @copydoc PlantState::handleLoseWater()
      */
     void handleLoseWater() override;
+    /**
+     * @copydoc PlantState::lifecycle()
+     */
+    PlantLifecycle lifecycle() const override;
 };
 
 /**
@@ -409,6 +459,26 @@ class DeadState : public PlantState {
      * @copydoc PlantState::handleLoseWater()
      */
     void handleLoseWater() override;
+    /**
+     * @copydoc PlantState::lifecycle()
+     */
+    PlantLifecycle lifecycle() const override;
 };
 
+/**
+ * @brief Creates the water-loss strategy matching a watering preference.
+ * @param preference Desired watering profile; UNKNOWN maps to medium loss.
+ */
+WaterLossStrategy* createWaterLossStrategy(WaterPreference preference);
+/**
+ * @brief Creates the sunlight strategy matching a sunlight preference.
+ * @param preference Desired sunlight profile; UNKNOWN maps to medium light.
+ */
+SunlightStrategy* createSunlightStrategy(SunlightPreference preference);
+/**
+ * @brief Creates an unbound state object for the given lifecycle stage.
+ * @param lifecycle Stage the state should represent.
+ */
+PlantState* createPlantState(PlantLifecycle lifecycle);
+
 #endif
@@ -0,0 +1,126 @@
+/**
+ * @file plantCatalog.h
+ * @brief Declares the species catalogs that back @ref PlantDatabase.
+ *
+ * A catalog exposes its species as fixed-layout @ref PlantRecord entries in
+ * name order plus a by-name lookup. The built-in catalog is a `constexpr`
+ * table with a perfect hash computed by the compiler, so it needs no static
+ * initialisation and finds a name with a single probe. File catalogs keep
+ * their strings in memory and use an open-addressed table with the same hash.
+ */
+#ifndef PLANTCATALOG_H
+#define PLANTCATALOG_H
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "command.h"
+
+/**
+ * @brief Stores metadata about a plant entry in the database.
+ */
+struct PlantInfo {
+    std::string section;
+    SunlightPreference sunlight;
+    WaterPreference water;
+    /** Alternative names separated by '|', or empty. */
+    std::string aliases;
+    // ... other members
+};
+
+/**
+ * @brief Literal description of one species; strings are owned by the catalog.
+ */
+struct PlantRecord {
+    const char* name;
+    const char* section;
+    SunlightPreference sunlight;
+    WaterPreference water;
+    /** Alternative names separated by '|'; empty when there are none. */
+    const char* aliases;
+};
+
+/**
+ * @brief Read-only set of species addressable by index (name order) or by name.
+ */
+class PlantCatalog {
+  public:
+    virtual ~PlantCatalog() {}
+    /**
+     * @brief Number of species.
+     */
+    virtual std::size_t size() const = 0;
+    /**
+     * @brief Species at @p index in name order.
+     * @param index Position in [0, size()).
+     */
+    virtual const PlantRecord& record(std::size_t index) const = 0;
+    /**
+     * @brief Looks a species up by exact name.
+     * @return Matching record, or nullptr when the name is not listed.
+     */
+    virtual const PlantRecord* find(const std::string& name) const = 0;
+    /**
+     * @brief Species as a name-keyed map, for callers that enumerate entries.
+     */
+    virtual const std::map<std::string, PlantInfo>& asMap() const = 0;
+};
+
+/**
+ * @brief The compiled-in species table with a compile-time perfect hash.
+ *
+ * The map view is built on the first @ref asMap call; record and find never
+ * allocate.
+ */
+class BuiltinPlantCatalog : public PlantCatalog {
+  public:
+    std::size_t size() const override;
+    const PlantRecord& record(std::size_t index) const override;
+    const PlantRecord* find(const std::string& name) const override;
+    const std::map<std::string, PlantInfo>& asMap() const override;
+};
+
+/**
+ * @brief Catalog built at runtime, e.g. from a catalog file.
+ */
+class RuntimePlantCatalog : public PlantCatalog {
+  public:
+    /**
+     * @brief Takes ownership of the species map and indexes it by name hash.
+     * @param plants Species keyed by name.
+     */
+    explicit RuntimePlantCatalog(std::map<std::string, PlantInfo> plants);
+    RuntimePlantCatalog(const RuntimePlantCatalog&) = delete;
+    RuntimePlantCatalog& operator=(const RuntimePlantCatalog&) = delete;
+
+    std::size_t size() const override;
+    const PlantRecord& record(std::size_t index) const override;
+    const PlantRecord* find(const std::string& name) const override;
+    const std::map<std::string, PlantInfo>& asMap() const override;
+
+  private:
+    /** Owned species data; records point into its keys and sections. */
+    std::map<std::string, PlantInfo> plants;
+    /** Records in name order. */
+    std::vector<PlantRecord> records;
+    /** Open-addressed hash slots holding record index + 1, 0 when empty. */
+    std::vector<std::uint32_t> slots;
+};
+
+/**
+ * @brief FNV-1a hash of a species name, usable in constant expressions.
+ * @param text Characters to hash.
+ * @param length Number of characters.
+ * @param hash Running hash value.
+ */
+constexpr std::uint32_t plantNameHash(const char* text, std::size_t length, std::uint32_t hash = 2166136261u) {
+    return length == 0 ? hash
+                       : plantNameHash(text + 1, length - 1,
+                                       (hash ^ static_cast<unsigned char>(*text)) * 16777619u);
+}
+
+#endif
@@ -1,24 +1,26 @@
 /**
  * @file plantDatabase.h
  * @brief Declares the static plant database used for lookup and seeding.
+ *
+ * The database starts with a built-in table of common species. A larger
+ * catalog can replace it at startup with @ref PlantDatabase::loadCatalog,
+ * which memory-maps a CSV file and parses it in place. Every catalog comes
+ * with a (sunlight, water) index so care-based advice is a single lookup.
+ * The active catalog is a @ref PlantCatalog; the default is the compiled-in
+ * @ref BuiltinPlantCatalog.
  */
 #pragma once
+#include <cstddef>
+#include <memory>
 #include <vector>
 #include <string>
 #include <map>
 #include "command.h"
+#include "plantCatalog.h"
+#include "plantSearch.h"
 
-enum class SunlightPreference;
-enum class WaterPreference;
-/**
- * @brief Stores metadata about a plant entry in the database.
- */
-struct PlantInfo {
-    std::string section;
-    SunlightPreference sunlight;
-    WaterPreference water;
-    // ... other members
-};
+/** @brief Species names in name order; each points into the active catalog. */
+using PlantNameList = std::vector<const char*>;
 
 /**
  * @brief Static repository of plant information for greenhouse setup.
@@ -30,4 +32,66 @@ public:
      * @return Map keyed by plant name.
      */
     static const std::map<std::string , PlantInfo>& getAllPlants();
+    /**
+     * @brief Active species catalog.
+     */
+    static const PlantCatalog& catalog();
+    /**
+     * @brief Looks a species up in the active catalog without walking a tree.
+     * @param name Exact species name.
+     * @return Matching record, or nullptr when the species is not listed.
+     */
+    static const PlantRecord* find(const std::string& name);
+    /**
+     * @brief Lists species matching a care profile in O(1).
+     *
+     * UNKNOWN acts as a wildcard for either preference. The lists for all 16
+     * combinations are precomputed when a catalog is installed, so the
+     * returned list is shared and stays valid until the catalog changes.
+     * @param sunlight Required sunlight, or UNKNOWN for any.
+     * @param water Required watering, or UNKNOWN for any.
+     * @return Matching species names in name order.
+     */
+    static const PlantNameList& findByCare(SunlightPreference sunlight, WaterPreference water);
+    /**
+     * @brief Ranks species whose name or alias resembles a possibly misspelt query.
+     *
+     * Uses a trigram index over the active catalog, built on the first search
+     * after the catalog changes.
+     * @param query Name as typed by a customer.
+     * @param limit Maximum number of matches.
+     * @return Matches ordered by descending similarity.
+     */
+    static std::vector<PlantMatch> searchByName(const std::string& query, std::size_t limit = 5);
+    /**
+     * @brief Replaces the active catalog with the species listed in a CSV file.
+     *
+     * Each non-empty line holds `name,section,sunlight,water[,aliases]`. Sunlight
+     * and water are `low`, `medium`, `high`, or `unknown` (any case; empty means
+     * unknown); the optional aliases are separated by `|`.
+     * Fields are trimmed and may not contain commas. Lines starting with `#`
+     * and a leading `name,...` header are skipped. The file is memory-mapped
+     * and parsed without copying fields; only names and distinct section names
+     * become strings. References returned by @ref getAllPlants before the call
+     * are invalidated.
+     * @param path CSV file to load.
+     * @return Number of species loaded.
+     * @throws std::runtime_error When the file cannot be read, has a malformed
+     *         line, repeats a name, or lists no species. The active catalog is
+     *         left unchanged.
+     */
+    static std::size_t loadCatalog(const std::string& path);
+    /**
+     * @brief Makes a catalog the active one and indexes it for advice.
+     * @param replacement Catalog to install; nullptr selects the built-in table.
+     */
+    static void useCatalog(std::unique_ptr<const PlantCatalog> replacement);
+    /**
+     * @brief Switches back to the built-in species table.
+     */
+    static void useBuiltinCatalog();
+    /**
+     * @brief Indicates whether the built-in table is the active catalog.
+     */
+    static bool isBuiltinCatalog();
 };
@@ -0,0 +1,89 @@
+/**
+ * @file plantSearch.h
+ * @brief Declares the trigram index answering approximate plant-name queries.
+ *
+ * Every species name and alias is split into overlapping three-letter
+ * fragments (trigrams) and each trigram lists the names containing it. A
+ * query only visits the names sharing its rarest trigrams, then ranks them by
+ * trigram overlap, so typos such as "monstra" or "peace lilly" resolve
+ * without comparing the query against the whole catalog.
+ */
+#ifndef PLANTSEARCH_H
+#define PLANTSEARCH_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "plantCatalog.h"
+
+/**
+ * @brief One ranked answer to an approximate name query.
+ */
+struct PlantMatch {
+    /** Matched species. */
+    const PlantRecord* plant;
+    /** Name or alias of @ref plant that matched best. */
+    std::string term;
+    /** Trigram similarity in (0, 1]; 1 for an exact match. */
+    double score;
+};
+
+/**
+ * @brief Inverted trigram index over the names and aliases of a catalog.
+ */
+class PlantNameIndex {
+  public:
+    /**
+     * @brief Indexes every name and alias of @p catalog.
+     * @param catalog Catalog whose records the matches point into; must outlive the index.
+     */
+    explicit PlantNameIndex(const PlantCatalog& catalog);
+    /**
+     * @brief Ranks species whose name or an alias resembles @p query.
+     *
+     * Matching ignores case and punctuation. Similarity is the Jaccard
+     * overlap of trigram sets; each species appears at most once, under its
+     * best-matching term.
+     * @param query Name typed by a customer.
+     * @param limit Maximum number of matches.
+     * @param minScore Minimum similarity a match must reach.
+     * @return Matches ordered by descending score, then name.
+     */
+    std::vector<PlantMatch> search(const std::string& query, std::size_t limit = 5, double minScore = 0.3) const;
+    /**
+     * @brief Number of indexed names and aliases.
+     */
+    std::size_t termCount() const { return terms.size(); }
+    /**
+     * @brief Lowercases letters and digits and collapses everything else to single spaces.
+     */
+    static std::string normalise(const std::string& text);
+
+  private:
+    /** @brief Indexed name or alias. */
+    struct Term {
+        /** Position of the species in the catalog. */
+        std::uint32_t record;
+        /** Distinct trigrams in the normalised text. */
+        std::uint32_t trigrams;
+        /** Normalised text. */
+        std::string text;
+    };
+
+    /** Appends the sorted distinct trigram codes of normalised @p text. */
+    static void trigramsOf(const std::string& text, std::vector<std::uint32_t>& codes);
+    /** Indexes one name or alias of the record at @p record. */
+    void addTerm(std::uint32_t record, const std::string& text, std::vector<std::uint32_t>& scratch);
+
+    /** Indexed catalog. */
+    const PlantCatalog& catalog;
+    /** Indexed terms by id. */
+    std::vector<Term> terms;
+    /** Trigram code to ascending term ids. */
+    std::unordered_map<std::uint32_t, std::vector<std::uint32_t>> postings;
+};
+
+#endif
@@ -0,0 +1,80 @@
+/**
+ * @file plantStock.h
+ * @brief Declares the per-species plant counters kept up to date by the greenhouse.
+ *
+ * A @ref PlantStockIndex is attached to a section tree. Sections report plants
+ * entering and leaving the tree and plants report lifecycle transitions, so
+ * stock queries such as "how many sellable roses" are a single hash lookup
+ * instead of a composite traversal.
+ */
+#ifndef PLANTSTOCK_H
+#define PLANTSTOCK_H
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class Plant;
+enum class PlantLifecycle;
+
+/**
+ * @brief Plant counts for one species, split by lifecycle stage.
+ */
+struct PlantStockCounts {
+    int seedling = 0;
+    int mature = 0;
+    int dead = 0;
+
+    /** @brief Every plant of the species currently in the greenhouse. */
+    int total() const { return seedling + mature + dead; }
+};
+
+/**
+ * @brief Incrementally maintained plant counts keyed by species name.
+ */
+class PlantStockIndex {
+  public:
+    /**
+     * @brief Counts a plant that entered the indexed tree.
+     */
+    void track(const Plant& plant);
+    /**
+     * @brief Stops counting a plant that left the indexed tree.
+     */
+    void untrack(const Plant& plant);
+    /**
+     * @brief Moves a tracked plant between lifecycle buckets.
+     * @param species Plant name.
+     * @param from Lifecycle before the transition.
+     * @param to Lifecycle after the transition.
+     */
+    void lifecycleChanged(const std::string& species, PlantLifecycle from, PlantLifecycle to);
+    /**
+     * @brief Looks up the counts of a species.
+     * @return Counts, or nullptr when no plant of the species was ever tracked.
+     */
+    const PlantStockCounts* find(const std::string& species) const;
+    /**
+     * @brief Number of mature, sellable plants of a species.
+     */
+    int sellable(const std::string& species) const;
+    /**
+     * @brief Number of plants of any stage currently tracked.
+     */
+    int plantCount() const { return trackedPlants; }
+    /**
+     * @brief Lists every species that currently has at least one plant.
+     */
+    std::vector<std::string> species() const;
+
+  private:
+    /** Bucket for a lifecycle stage within a species' counts. */
+    static int& bucket(PlantStockCounts& counts, PlantLifecycle lifecycle);
+
+    /** Counts keyed by species name. */
+    std::unordered_map<std::string, PlantStockCounts> counts;
+    /** Plants tracked across all species. */
+    int trackedPlants = 0;
+};
+
+#endif
@@ -8,11 +8,13 @@
 #ifndef PRODUCTBUILDER_H
 #define PRODUCTBUILDER_H
 
+#include <cstdint>
 #include <vector>
 #include <string>
 #include "plant.h"
 #include "inventory.h"
 #include "garden.h"
+#include "randomStream.h"
 
 class GardenComponent; // forward declaration for pointer usage in Product
 class Product;  // forward declaration for pointer usage in Bob
@@ -32,7 +34,8 @@ protected:
     std::string card;
     /** Optional wrapping material. */
     std::string wrapping;
-    Inventory inventory; // CHANGED: lowercase 'i' to avoid naming conflict
+    /** Shared supply store debited by the setters; may be null for stock-free products. */
+    Inventory* inventory;
     /** Total price of the product. */
     float price;
     /** Flags whether this is the primary item in a bouquet chain. */
@@ -56,11 +59,12 @@ public:
     /**
      * @brief Constructs a product from a plant within a greenhouse context.
      * @param plant Core plant for the product.
-     * @param greenhouse Greenhouse composite for inventory interaction.
+     * @param greenhouse Greenhouse composite the plant was taken from.
      * @param isMain Indicates if this is the main product in a chain.
+     * @param inventory Shared supply store debited when supplies are assigned.
      */
-    Product(Plant* plant, GardenComponent* greenhouse, bool isMain) 
-        : plant(plant), inventory(greenhouse), isMain(isMain) {
+    Product(Plant* plant, GardenComponent* greenhouse, bool isMain, Inventory* inventory = nullptr)
+        : plant(plant), inventory(inventory), isMain(isMain) {
         soil = "";
         container = "";
         card = "";
@@ -72,6 +76,10 @@ public:
      * @brief Indicates if the product is the main bouquet component.
      */
     bool getisMain() const { return isMain; }
+    /**
+     * @brief Returns the shared supply store this product draws from.
+     */
+    Inventory* getInventory() const { return inventory; }
 
     /**
      * @brief Replaces the product's plant.
@@ -130,6 +138,26 @@ public:
     void incPrice(float amount) { price += amount; }
 };
 
+/**
+ * @brief Reseeds the calling thread's generator for builder surcharges.
+ *
+ * Soil and container surcharges are drawn from a per-thread generator, so
+ * simulations running on different threads never share random state and a
+ * seeded simulation prices its products the same way on every run.
+ * @param seed New seed for the calling thread.
+ */
+void seedBuilderPricing(std::uint64_t seed);
+
+/**
+ * @brief Copies the calling thread's builder-pricing generator, e.g. for a checkpoint.
+ */
+SimulationRandom builderPricingState();
+
+/**
+ * @brief Restores the calling thread's builder-pricing generator from @ref builderPricingState.
+ */
+void restoreBuilderPricing(const SimulationRandom& state);
+
 /**
  * @brief Abstract builder responsible for constructing products.
  */
@@ -138,10 +166,11 @@ public:
     /**
      * @brief Stores plants and greenhouse reference for construction.
      * @param plant Collection of plants for the product.
-     * @param greenhouse Greenhouse used for inventory access.
+     * @param greenhouse Greenhouse the plants are taken from.
+     * @param inventory Shared supply store handed to every product built.
      */
-    Bob(std::vector<Plant*> plant, GardenComponent* greenhouse) 
-        : plants(plant), greenhouse(greenhouse) {};
+    Bob(std::vector<Plant*> plant, GardenComponent* greenhouse, Inventory* inventory = nullptr)
+        : plants(plant), greenhouse(greenhouse), inventory(inventory) {};
     /**
      * @brief Adds a plant to the product.
      */
@@ -166,6 +195,8 @@ protected:
     std::vector<Plant*> plants;
     /** Greenhouse context used during construction. */
     GardenComponent* greenhouse;
+    /** Shared supply store handed to constructed products. */
+    Inventory* inventory;
 };
 
 /**
@@ -173,7 +204,7 @@ protected:
  */
 class BouquetBuilder : public Bob {
 public:
-    BouquetBuilder(std::vector<Plant*> plant, GardenComponent* greenhouse);
+    BouquetBuilder(std::vector<Plant*> plant, GardenComponent* greenhouse, Inventory* inventory = nullptr);
     /**
      * @brief Constructs the bouquet chain from the supplied plants.
      */
@@ -186,6 +217,10 @@ public:
      * @brief Returns the completed bouquet product.
      */
     Product* getProduct();
+    /**
+     * @brief Supplies consumed by one bouquet, regardless of its plant count.
+     */
+    static std::vector<SupplyLine> requiredSupplies();
 };
 
 /**
@@ -193,7 +228,7 @@ public:
  */
 class BasicBuilder : public Bob {
 public:
-    BasicBuilder(std::vector<Plant*> plants, GardenComponent* greenhouse);
+    BasicBuilder(std::vector<Plant*> plants, GardenComponent* greenhouse, Inventory* inventory = nullptr);
     /**
      * @brief Builds the base product using a single plant.
      */
@@ -206,6 +241,10 @@ public:
      * @brief Returns the assembled basic product.
      */
     Product* getProduct();
+    /**
+     * @brief Supplies consumed by one basic potted product.
+     */
+    static std::vector<SupplyLine> requiredSupplies();
 };
 
 /**
@@ -213,8 +252,8 @@ public:
  */
 class BouquetProduct : public Product {
 public:
-    BouquetProduct(Plant* plant, GardenComponent* greenhouse, bool isMain) 
-        : Product(plant, greenhouse, isMain) {}
+    BouquetProduct(Plant* plant, GardenComponent* greenhouse, bool isMain, Inventory* inventory = nullptr)
+        : Product(plant, greenhouse, isMain, inventory) {}
 };
 
 /**
@@ -222,8 +261,8 @@ public:
  */
 class Bouquet : public BouquetProduct {
 public:
-    Bouquet(Plant* plant, GardenComponent* greenhouse, bool isMain) 
-        : BouquetProduct(plant, greenhouse, isMain), bouquet(nullptr) {}
+    Bouquet(Plant* plant, GardenComponent* greenhouse, bool isMain, Inventory* inventory = nullptr)
+        : BouquetProduct(plant, greenhouse, isMain, inventory), bouquet(nullptr) {}
         
     /**
      * @brief Returns the next bouquet element in the chain.
@@ -0,0 +1,170 @@
+/**
+ * @file randomStream.h
+ * @brief Declares the simulation's random generator and its independent streams.
+ *
+ * Simulations draw from @ref SimulationRandom, which is xoshiro256** unless the
+ * build defines GREENHOUSE_RNG_MT19937. A seed names a family of streams:
+ * stream k starts 2^128 steps after stream k - 1, so parallel runs given
+ * consecutive streams of one seed never overlap, and any single run can be
+ * reproduced from the seed and its stream index alone.
+ */
+#ifndef RANDOMSTREAM_H
+#define RANDOMSTREAM_H
+
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+/**
+ * @brief xoshiro256** by Blackman and Vigna: 256 bits of state, 64 bits per draw.
+ *
+ * Meets the standard's UniformRandomBitGenerator requirements, so it works
+ * with the distributions in <random>. Seeding expands a 64-bit value with
+ * splitmix64, which never yields the all-zero state.
+ */
+class Xoshiro256StarStar {
+  public:
+    using result_type = std::uint64_t;
+
+    /** @brief Seed used by the default constructor. */
+    static constexpr std::uint64_t default_seed = 5489u;
+
+    /**
+     * @brief Creates a generator seeded with @ref default_seed.
+     */
+    Xoshiro256StarStar() { seed(default_seed); }
+    /**
+     * @brief Creates a generator seeded with @p value.
+     */
+    explicit Xoshiro256StarStar(std::uint64_t value) { seed(value); }
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return ~result_type(0); }
+
+    /**
+     * @brief Resets the state from a 64-bit seed.
+     */
+    void seed(std::uint64_t value);
+    /**
+     * @brief Returns the next 64 random bits.
+     */
+    result_type operator()() {
+        const std::uint64_t result = rotl(state[1] * 5, 7) * 9;
+        const std::uint64_t shifted = state[1] << 17;
+        state[2] ^= state[0];
+        state[3] ^= state[1];
+        state[1] ^= state[2];
+        state[0] ^= state[3];
+        state[2] ^= shifted;
+        state[3] = rotl(state[3], 45);
+        return result;
+    }
+    /**
+     * @brief Advances the state by @p count draws.
+     */
+    void discard(unsigned long long count) {
+        for (; count > 0; --count) {
+            (*this)();
+        }
+    }
+    /**
+     * @brief Advances the state by 2^128 draws, the distance between streams.
+     */
+    void jump();
+    /**
+     * @brief Advances the state by 2^192 draws.
+     */
+    void longJump();
+
+    friend bool operator==(const Xoshiro256StarStar& lhs, const Xoshiro256StarStar& rhs) {
+        return lhs.state[0] == rhs.state[0] && lhs.state[1] == rhs.state[1] && lhs.state[2] == rhs.state[2] &&
+               lhs.state[3] == rhs.state[3];
+    }
+    friend bool operator!=(const Xoshiro256StarStar& lhs, const Xoshiro256StarStar& rhs) { return !(lhs == rhs); }
+    /**
+     * @brief Writes the four state words as space-separated decimals.
+     */
+    friend std::ostream& operator<<(std::ostream& out, const Xoshiro256StarStar& generator);
+    /**
+     * @brief Reads state written by operator<<; fails the stream on an all-zero state.
+     */
+    friend std::istream& operator>>(std::istream& in, Xoshiro256StarStar& generator);
+
+  private:
+    static std::uint64_t rotl(std::uint64_t value, int bits) { return (value << bits) | (value >> (64 - bits)); }
+    /** Applies a jump polynomial to the state. */
+    void jumpBy(const std::uint64_t (&polynomial)[4]);
+
+    /** Generator state; never all zero. */
+    std::uint64_t state[4];
+};
+
+#ifdef GREENHOUSE_RNG_MT19937
+/** @brief Generator behind every simulation draw. */
+using SimulationRandom = std::mt19937;
+#else
+/** @brief Generator behind every simulation draw. */
+using SimulationRandom = Xoshiro256StarStar;
+#endif
+
+/**
+ * @brief Draws 32 random bits, taking the stronger high half of a 64-bit output.
+ */
+inline std::uint32_t randomBits32(Xoshiro256StarStar& generator) { return static_cast<std::uint32_t>(generator() >> 32); }
+/**
+ * @brief Draws 32 random bits.
+ */
+inline std::uint32_t randomBits32(std::mt19937& generator) { return static_cast<std::uint32_t>(generator()); }
+
+/**
+ * @brief Generator seeded with @p seed and moved to stream @p stream.
+ *
+ * Stream 0 equals a generator seeded directly with @p seed. This walks
+ * @p stream jumps; use @ref randomStreams for many consecutive streams.
+ */
+SimulationRandom randomStream(std::uint64_t seed, std::uint64_t stream);
+/**
+ * @brief Streams @p first to @p first + @p count - 1 of @p seed, each one jump past the previous.
+ */
+std::vector<SimulationRandom> randomStreams(std::uint64_t seed, std::uint64_t first, std::size_t count);
+
+/**
+ * @brief Generator state as the words of its text form, for binary files.
+ */
+template <typename Generator>
+std::vector<std::uint64_t> generatorWords(const Generator& generator) {
+    std::ostringstream text;
+    text << generator;
+    std::istringstream in(text.str());
+    std::vector<std::uint64_t> words;
+    std::uint64_t word = 0;
+    while (in >> word) {
+        words.push_back(word);
+    }
+    return words;
+}
+
+/**
+ * @brief Rebuilds a generator from @ref generatorWords.
+ * @throws std::runtime_error When the words are not exactly one state of @p Generator.
+ */
+template <typename Generator>
+Generator generatorFromWords(const std::vector<std::uint64_t>& words) {
+    std::ostringstream text;
+    for (std::size_t i = 0; i < words.size(); ++i) {
+        text << (i == 0 ? "" : " ") << words[i];
+    }
+    Generator generator;
+    std::istringstream in(text.str());
+    in >> generator;
+    if (!in || !(in >> std::ws).eof()) {
+        throw std::runtime_error("Generator state is corrupt");
+    }
+    return generator;
+}
+
+#endif
@@ -0,0 +1,86 @@
+/**
+ * @file restockQueue.h
+ * @brief Declares the lock-free queue carrying low-stock notifications.
+ *
+ * @ref Inventory pushes a @ref RestockEvent when a deduction takes a SKU from
+ * above its low-water mark to at or below it; the simulation pops the events
+ * to schedule deliveries, so no one has to poll every stock line.
+ */
+#ifndef RESTOCKQUEUE_H
+#define RESTOCKQUEUE_H
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+
+#include "inventory.h"
+
+/**
+ * @brief Notification that a SKU fell to or below its low-water mark.
+ */
+struct RestockEvent {
+    /** SKU whose stock crossed the mark. */
+    SkuId sku = kInvalidSku;
+    /** Quantity left right after the crossing deduction. */
+    int quantity = 0;
+    /** Low-water mark that was crossed. */
+    int threshold = 0;
+};
+
+/**
+ * @brief Bounded multi-producer, multi-consumer queue of restock events.
+ *
+ * Each cell carries a sequence number telling producers and consumers whether
+ * it is free or filled for their lap around the ring, so a push or pop is one
+ * compare-and-swap on a position counter and never blocks. A full queue
+ * refuses the push instead of waiting.
+ */
+class RestockQueue {
+  public:
+    /**
+     * @brief Creates an empty queue.
+     * @param capacity Minimum number of events held; rounded up to a power of two.
+     * @throws std::invalid_argument When @p capacity is zero.
+     */
+    explicit RestockQueue(std::size_t capacity = 256);
+    RestockQueue(const RestockQueue&) = delete;
+    RestockQueue& operator=(const RestockQueue&) = delete;
+
+    /**
+     * @brief Appends an event when a cell is free.
+     * @return False when the queue is full.
+     */
+    bool tryPush(const RestockEvent& event);
+    /**
+     * @brief Removes the oldest event when one is available.
+     * @return False when the queue is empty.
+     */
+    bool tryPop(RestockEvent& event);
+    /**
+     * @brief Number of events the queue can hold.
+     */
+    std::size_t capacity() const { return mask + 1; }
+
+  private:
+    /** Bytes reserved per position counter so producers and consumers do not share a line. */
+    static constexpr std::size_t kCacheLineSize = 64;
+
+    /** @brief Ring slot pairing an event with its lap sequence number. */
+    struct Cell {
+        std::atomic<std::size_t> sequence;
+        RestockEvent event;
+    };
+
+    /** Ring storage. */
+    std::unique_ptr<Cell[]> cells;
+    /** Capacity minus one, used to wrap positions. */
+    std::size_t mask;
+    char producerPadding[kCacheLineSize];
+    /** Next position to fill. */
+    std::atomic<std::size_t> enqueuePos;
+    char consumerPadding[kCacheLineSize - sizeof(std::atomic<std::size_t>)];
+    /** Next position to drain. */
+    std::atomic<std::size_t> dequeuePos;
+};
+
+#endif
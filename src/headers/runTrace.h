@@ -0,0 +1,100 @@
+/**
+ * @file runTrace.h
+ * @brief Declares the binary trace that lets a simulation run be replayed exactly.
+ *
+ * Every random draw in a run comes from the simulation's generator, and
+ * product surcharges come from a per-thread generator seeded from it. A trace
+ * therefore captures the draws by storing the generator state at the start of
+ * the run. It also stores the configuration and the manually added customers
+ * that shaped the run, plus a digest of every completed day. A replay restores
+ * all of it and checks each day against its digest.
+ */
+#ifndef RUNTRACE_H
+#define RUNTRACE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "randomStream.h"
+#include "simulator.h"
+
+/**
+ * @brief Customer added with @ref Simulation::addCustomer, as captured in a trace.
+ */
+struct TracedCustomer {
+    /** Customer name. */
+    std::string name;
+    /** Whether the customer wants to order rather than ask for advice. */
+    bool wantsOrder = false;
+};
+
+/**
+ * @brief Inputs and per-day digests of one recorded simulation run.
+ *
+ * Layout (host byte order, guarded by a byte-order marker): header, generator
+ * state as 64-bit words, run settings, manual customers, and one 64-bit digest
+ * per completed day.
+ */
+struct RunTrace {
+    /** Simulation generator state at the start of the run. */
+    SimulationRandom rng;
+    /** Days scheduled. */
+    int days = 1;
+    /** Employees configured across every role. */
+    int employees = 3;
+    /** Cashiers among @ref employees. */
+    int cashiers = 1;
+    /** Managers among @ref employees. */
+    int managers = 1;
+    /** Sections declared before stocking, in order. */
+    std::vector<SectionLayout> sections;
+    /** Species in the plant catalog the run used; checked before replaying. */
+    std::uint64_t catalogSpecies = 0;
+    /** Plants stocked per species. */
+    std::map<std::string, int> plants;
+    /** Supply stock placed in the inventory. */
+    std::vector<SupplyLine> supplies;
+    /** Restock low-water mark; negative disables restocking. */
+    int restockLowWaterMark = 0;
+    /** Units delivered per restock. */
+    int restockQuantity = 0;
+    /** Whether business levels were drawn at random. */
+    bool generatedLevels = true;
+    /** Configured business level per day when not generated. */
+    std::vector<BusinessLevel> schedule;
+    /** Whether days ran through the discrete-event engine. */
+    bool eventDriven = false;
+    /** Day shape for the event engine. */
+    EventTiming timing;
+    /** Whether customers were drawn from arrival profiles. */
+    bool profileArrivals = false;
+    /** Arrival profile of each business level. */
+    ArrivalProfile profiles[3];
+    /** Species popularity and order shape. */
+    DemandProfile demand;
+    /** Manually added customers, in serving order. */
+    std::vector<TracedCustomer> customers;
+    /** Digest of each completed day, by day index minus one. */
+    std::vector<std::uint64_t> dayDigests;
+
+    /**
+     * @brief FNV-1a digest of every field of a day summary, doubles included bit for bit.
+     */
+    static std::uint64_t digest(const DaySummary& day);
+    /**
+     * @brief Writes the trace to a file, replacing any previous contents.
+     * @return Size of the file in bytes.
+     * @throws std::runtime_error When the file cannot be written.
+     */
+    std::size_t save(const std::string& path) const;
+    /**
+     * @brief Reads a trace written by @ref save.
+     * @throws std::runtime_error When the file cannot be read or is not a valid trace.
+     */
+    static RunTrace load(const std::string& path);
+};
+
+#endif
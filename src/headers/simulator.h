@@ -9,21 +9,39 @@
 #define SIMULATOR_H
 
 #include <cstddef>
+#include <functional>
+#include <iostream>
 #include <map>
+#include <memory>
 #include <random>
 #include <string>
 #include <vector>
 #include "Customer.h"
+#include "arrivals.h"
 #include "command.h"
+#include "demand.h"
 #include "employee.h"
+#include "eventEngine.h"
+#include "eventLog.h"
 #include "frontDesk.h"
 #include "greenhouseManager.h"
+#include "inventory.h"
+#include "inventoryJournal.h"
+#include "phaseProfile.h"
 #include "plantDatabase.h"
 #include "productRequest.h"
+#include "randomStream.h"
+#include "restockQueue.h"
+#include "snapshot.h"
 
 class GardenSection;
 class GardenComponent;
+class GreenhouseView;
 class RequestCommand;
+class SimulationCheckpoint;
+struct CheckpointState;
+struct CheckpointStats;
+struct RunTrace;
 
 /** @brief Represents expected business volume for a simulation day. */
 enum class BusinessLevel { LOW = 0, MEDIUM = 1, HIGH = 2 };
@@ -38,8 +56,64 @@ struct DaySummary {
     int ordersCompleted = 0;
     int queriesAnswered = 0;
     int maintenanceCommands = 0;
+    /** Supply units (soil, containers, cards, wrapping) deducted during the day. */
+    long long suppliesConsumed = 0;
+    /** Supply deductions refused because the shared stock ran out. */
+    long long supplyShortages = 0;
+    /** Restocks scheduled because a supply fell to its low-water mark. */
+    int restocksScheduled = 0;
+    /** Scheduled restocks delivered at the start of the day. */
+    int restocksDelivered = 0;
+    /** Mean minutes customers queued at the front desk; event-driven days only. */
+    double meanWaitMinutes = 0.0;
+    /** Longest front-desk queue during the day; event-driven days only. */
+    int peakQueueLength = 0;
+    /** Time and work per @ref DayPhase; zero unless @ref Simulation::profilePhases is enabled. */
+    PhaseStats phases[kDayPhaseCount];
 };
 
+/**
+ * @brief Shape of a day when customers are simulated as timed events.
+ */
+struct EventTiming {
+    /** Minute of the day the greenhouse opens; maintenance runs and arrivals start then. */
+    double openMinute = 9 * 60;
+    /** Minute of the day after which nobody arrives; dead plants are cleared then. */
+    double closeMinute = 17 * 60;
+    /** Mean front-desk service time in minutes, exponentially distributed; 0 serves instantly. */
+    double meanServiceMinutes = 4.0;
+    /** Customers the front desk serves at once. */
+    int servers = 1;
+    /** Spreads arrivals uniformly over opening hours; otherwise everyone arrives at opening. */
+    bool spreadArrivals = true;
+
+    /**
+     * @brief Timing under which the event engine reproduces the day loop exactly.
+     *
+     * Everyone arrives at opening and is served instantly, one at a time, so
+     * customers are handled in the same order and draw the same random numbers.
+     */
+    static EventTiming dayLoop();
+};
+
+/**
+ * @brief A greenhouse section created before any plant is placed.
+ *
+ * Plants go to the section named by their catalog entry, so declaring it
+ * ahead of time nests it where the layout says instead of under the root.
+ */
+struct SectionLayout {
+    /** Section name. */
+    std::string name;
+    /** Parent section; "root" or a section declared earlier in the layout. */
+    std::string parent;
+};
+
+/**
+ * @brief Receives each @ref DaySummary as soon as its day completes.
+ */
+using DaySummarySink = std::function<void(const DaySummary&)>;
+
 /**
  * @brief High-level controller running the greenhouse business simulation.
  */
@@ -48,8 +122,9 @@ public:
     /**
      * @brief Constructs a simulation for the specified number of days.
      * @param numDays Number of days to simulate.
+     * @param console Stream receiving the staff's console messages; must outlive the simulation.
      */
-    Simulation(int numDays = 1);
+    Simulation(int numDays = 1, std::ostream& console = std::cout);
     /**
      * @brief Releases resources owned by the simulation instance.
      */
@@ -60,8 +135,68 @@ public:
     void startSimulation();
     /**
      * @brief Adjusts the number of days in the simulation run.
+     *
+     * Runs are capped at 30 days unless summaries are streamed with
+     * @ref streamDaySummaries.
      */
     void setNumDays(int days);
+    /**
+     * @brief Streams daily summaries to a sink and bounds what the simulation retains.
+     *
+     * Lifts the 30-day cap. After each day, its summary is passed to @p sink
+     * and only the most recent @p retainedDays summaries, with their event log
+     * entries, are kept for @ref getDailySummaries and @ref getEventLog, so
+     * memory stays flat however long the run is.
+     * @param sink Callback invoked once per completed day; an empty sink restores the bounded mode.
+     * @param retainedDays Completed days kept in memory; at least 1.
+     * @throws std::invalid_argument When @p retainedDays is zero.
+     */
+    void streamDaySummaries(DaySummarySink sink, std::size_t retainedDays = 30);
+    /**
+     * @brief Runs each day through the discrete-event engine instead of the day loop.
+     *
+     * Maintenance happens at opening, customers arrive at timed events and
+     * queue at the front desk for a service time, and dead plants are cleared
+     * at closing. Each @ref DaySummary then also reports queueing figures.
+     * @param timing Opening hours, service times, and desk capacity.
+     * @throws std::invalid_argument For an empty or inverted opening window, a negative service time, or no servers.
+     */
+    void useEventEngine(const EventTiming& timing = EventTiming());
+    /**
+     * @brief Returns to the default day loop.
+     */
+    void useDayLoop();
+    /**
+     * @brief Replaces the clock the event engine advances, e.g. with a @ref PacedClock.
+     * @param clock Clock to use, not owned; nullptr restores the virtual clock.
+     */
+    void setEventClock(SimulationClock* clock);
+    /**
+     * @brief Draws each day's customers from the arrival profile its business level selects.
+     *
+     * A day's customer count becomes Poisson distributed around the profile's
+     * expected total; with the event engine, arrival times follow the hourly
+     * rates too. The default profiles keep the fixed model's means of 2, 5,
+     * and 8 customers spread over a typical day.
+     * @param enable False restores the fixed customer count per business level.
+     */
+    void useArrivalProfiles(bool enable);
+    /**
+     * @brief Replaces the profile a business level selects and enables profile-driven arrivals.
+     */
+    void setArrivalProfile(BusinessLevel level, const ArrivalProfile& profile);
+    /**
+     * @brief Returns the profile a business level selects.
+     */
+    const ArrivalProfile& getArrivalProfile(BusinessLevel level) const;
+    /**
+     * @brief Times each phase of every day and counts its plant visits, allocations, and commands.
+     *
+     * Results land in @ref DaySummary::phases. They measure the run rather
+     * than describe it, so traces, digests, and checkpoints leave them out.
+     * @param enable False stops profiling; phases then stay zero.
+     */
+    void profilePhases(bool enable);
     /**
      * @brief Supplies a pre-defined business level sequence.
      */
@@ -71,25 +206,146 @@ public:
      */
     void autoGenerateBusinessLevels(bool enable);
     /**
-     * @brief Configures the total number of employees to schedule.
+     * @brief Configures the total number of employees to schedule: one cashier, one manager, and caretakers.
      */
     void configureEmployees(int totalEmployees);
+    /**
+     * @brief Configures the staff by role.
+     *
+     * Cashiers hand requests they cannot serve to the managers in turn.
+     * @throws std::invalid_argument When a role has no employees.
+     */
+    void configureStaff(int cashiers, int managers, int caretakers);
+    /**
+     * @brief Cashiers configured.
+     */
+    int getCashierCount() const { return configuredCashiers; }
+    /**
+     * @brief Managers configured.
+     */
+    int getManagerCount() const { return configuredManagers; }
+    /**
+     * @brief Employees of every role configured.
+     */
+    int getEmployeeCount() const { return configuredEmployeeCount; }
+    /**
+     * @brief Declares sections to create, in order, before the greenhouse is stocked.
+     * @throws std::invalid_argument When a name is empty or repeated, or a parent is not declared before its child.
+     */
+    void configureSectionLayout(const std::vector<SectionLayout>& layout);
+    /**
+     * @brief Returns the declared section layout.
+     */
+    const std::vector<SectionLayout>& getSectionLayout() const { return sectionLayout; }
     /**
      * @brief Configures plants to stock for the simulation.
      */
     void configurePlantSelection(const std::map<std::string, int>& selection);
+    /**
+     * @brief Weights which species customers order and ask about, and how large their orders are.
+     *
+     * Alias tables for the profile are built once per run from the plant
+     * selection, so each customer draws in constant time.
+     * @throws std::invalid_argument When a weight is negative or not finite, or an order size list has no positive weight.
+     */
+    void configureDemand(const DemandProfile& profile);
+    /**
+     * @brief Returns the demand profile in effect.
+     */
+    const DemandProfile& getDemand() const { return demand; }
+    /**
+     * @brief Replaces the supply stock placed in the shared inventory when a run starts.
+     * @param stock Stock lines; non-plant categories only.
+     */
+    void configureSupplies(const std::vector<SupplyLine>& stock);
+    /**
+     * @brief Sets when and how much supply stock is reordered.
+     *
+     * Every supply line is watched with the same low-water mark. A line that
+     * falls to or below it during a day is scheduled for delivery, and the
+     * delivery is added to stock at the start of the next day.
+     * @param lowWaterMark Quantity at or below which a line is reordered; negative disables restocking.
+     * @param restockQuantity Units delivered per restock.
+     * @throws std::invalid_argument When restocking is enabled with a non-positive quantity.
+     */
+    void configureRestockPolicy(int lowWaterMark, int restockQuantity);
+    /**
+     * @brief Makes supply stock crash-safe with a write-ahead journal.
+     *
+     * On the next fresh run, stock is recovered from the journal files when
+     * they exist; otherwise the configured supplies are stocked and journaled.
+     * Runs continuing from a restored snapshot take their stock from the
+     * snapshot and are not journaled.
+     * @param basePath Path prefix of the journal and checkpoint files; empty disables journaling.
+     * @param commitBatch Mutations per group commit.
+     */
+    void setInventoryJournal(const std::string& basePath, std::size_t commitBatch = 64);
+    /**
+     * @brief Provides access to the shared supply inventory used by every order.
+     * @return Inventory of the prepared greenhouse, or nullptr before preparation.
+     */
+    Inventory* getInventory();
     /**
      * @brief Seeds the random number generator.
      */
     void setRandomSeed(unsigned int seed);
+    /**
+     * @brief Draws from stream @p stream of @p seed, so runs on distinct streams of one seed never overlap.
+     *
+     * Stream 0 is the same as @ref setRandomSeed with @p seed.
+     */
+    void setRandomStream(std::uint64_t seed, std::uint64_t stream);
+    /**
+     * @brief Draws from a copy of @p generator, e.g. one of @ref randomStreams.
+     */
+    void setRandomGenerator(const SimulationRandom& generator);
     /**
      * @brief Retrieves daily summary results after running the simulation.
+     *
+     * When streaming, only the most recently retained days are included.
      */
     const std::vector<DaySummary>& getDailySummaries() const;
     /**
      * @brief Returns chronological event log entries.
+     *
+     * Events are recorded as structured records; they are formatted to text
+     * here, on demand, and only records added since the previous call are
+     * formatted again. Once the log is full, the oldest entries are overwritten.
      */
     const std::vector<std::string>& getEventLog() const;
+    /**
+     * @brief Writes the retained event log to @p out, one entry per line, without caching the text.
+     * @return Number of entries written.
+     */
+    std::size_t writeEventLog(std::ostream& out) const;
+    /**
+     * @brief Structured records behind @ref getEventLog.
+     */
+    const EventLog& getEventRecords() const;
+    /**
+     * @brief Replaces the event log with an empty one holding at least @p records entries.
+     * @throws std::invalid_argument When @p records is zero.
+     */
+    void setEventLogCapacity(std::size_t records);
+    /**
+     * @brief Publishes an immutable greenhouse view at the end of every day for @ref getDayEndView.
+     *
+     * Views share the plant state of sections unchanged since the previous
+     * day, but routine watering and ageing mark every section with plants as
+     * changed, so in practice each day copies the whole greenhouse. Leave this
+     * off unless another thread reads the views.
+     * @param enable False stops publishing; the last view published stays available.
+     */
+    void publishDayEndViews(bool enable);
+    /**
+     * @brief Returns the immutable greenhouse view published at the end of the latest day.
+     *
+     * Safe to call from reporting threads while the simulation keeps running;
+     * the view stays consistent even as the next day mutates the greenhouse.
+     * @return Latest day-end view, or nullptr before the first day completes or
+     * when @ref publishDayEndViews is off.
+     */
+    std::shared_ptr<const GreenhouseView> getDayEndView() const;
     /**
      * @brief Provides access to the greenhouse manager.
      */
@@ -111,26 +367,134 @@ public:
      * @brief Adds a plant to a specified garden section.
      */
     void addPlant(Plant* plant, GardenSection* gardenSection);
+    /**
+     * @brief Writes the current greenhouse, supply stock, and RNG state to a binary snapshot.
+     * @param path Destination snapshot file.
+     * @return Counts of captured records.
+     * @throws std::logic_error When no greenhouse has been prepared yet.
+     */
+    SnapshotStats saveSnapshot(const std::string& path) const;
+    /**
+     * @brief Restores greenhouse, supply stock, and RNG state so the next run continues from it.
+     *
+     * The next call to @ref startSimulation reuses the restored plants instead
+     * of re-populating from the plant selection and supply configuration.
+     * @param path Snapshot file produced by @ref saveSnapshot.
+     * @return Counts of restored records.
+     */
+    SnapshotStats restoreSnapshot(const std::string& path);
+    /**
+     * @brief Records each following run to a binary trace for exact replay.
+     *
+     * Each run captures its generator state at the start, the configuration,
+     * the manually added customers, and a digest of every completed day. The
+     * file is rewritten when the run completes.
+     * @param path Trace file; empty stops recording.
+     * @note Runs continuing from a snapshot or journal take state from outside
+     * the trace; starting one while recording throws std::logic_error.
+     */
+    void recordTrace(const std::string& path);
+    /**
+     * @brief Configures the simulation from a trace so that the next run repeats the recorded one.
+     *
+     * Seeds, settings, and manual customers are replaced by the recorded ones.
+     * The next @ref startSimulation checks each completed day against its
+     * recorded digest and throws std::runtime_error at the first day that
+     * differs. Only that one run is checked.
+     * @param path Trace written by a run under @ref recordTrace.
+     * @param fastForward Skips the event log during the replay, for when only the outcome matters.
+     * @throws std::runtime_error When the trace cannot be read or was recorded with a different plant catalog.
+     */
+    void replayTrace(const std::string& path, bool fastForward = false);
+    /**
+     * @brief Checkpoints each following run at day boundaries so it can be resumed after a crash.
+     *
+     * The first checkpoint of a run writes the whole greenhouse; later ones
+     * append only the sections that changed since, plus generators, counters,
+     * stock, staff state, and the new day summaries.
+     * @param path Checkpoint file; empty stops checkpointing.
+     * @param everyDays Completed days between checkpoints.
+     * @throws std::invalid_argument When @p everyDays is below 1.
+     */
+    void checkpointEvery(const std::string& path, int everyDays = 1);
+    /**
+     * @brief Restores the latest intact checkpoint so the next run continues after its day.
+     *
+     * Configuration is not part of a checkpoint: apply the same settings and
+     * manual customers as the checkpointed run, then call @ref startSimulation.
+     * The continuation matches the uninterrupted run day for day. Retained day
+     * summaries are restored; the event log restarts with the resumed days.
+     * @param path Checkpoint file written under @ref checkpointEvery.
+     * @return Number of days already completed.
+     * @throws std::runtime_error When the file is missing, incompatible, or has no intact checkpoint.
+     */
+    int resumeFromCheckpoint(const std::string& path);
+    /**
+     * @brief Counters of the checkpoints written by the latest run.
+     */
+    CheckpointStats getCheckpointStats() const;
 
 private:
     /** Ensures resources are initialized before running. */
     void ensurePrepared();
+    /** Starts a fresh trace of the run about to begin. */
+    void beginTrace();
+    /** Records or checks the digest of a completed day. */
+    void traceDay(const DaySummary& summary);
+    /** Drops the loaded trace and the customers created from it. */
+    void releaseTrace();
+    /** Writes a checkpoint after the completed day @p day. */
+    void writeCheckpoint(int day);
+    /** Applies the staff, restock, and generator state of a restored checkpoint. */
+    void applyCheckpoint(const CheckpointState& state);
+    /** Creates an empty greenhouse root, its manager, and the shared inventory. */
+    void createGreenhouse();
     /** Creates employee instances according to configuration. */
     void initialiseEmployees();
+    /** Selects two plants of the first five catalog species when no plants were configured. */
+    void applyDefaultPlantSelection();
     /** Populates the greenhouse with initial plants. */
     void populateGreenhouse();
-    /** Builds the schedule of business levels per day. */
+    /** Places the configured supply stock in the shared inventory. */
+    void stockSupplies();
+    /** Subscribes every supply line to low-stock notifications. */
+    void armRestockAlerts();
+    /** Drains low-stock notifications into next-morning deliveries. */
+    void scheduleRestocks(DaySummary& summary);
+    /** Adds the scheduled deliveries to stock. */
+    void deliverRestocks(DaySummary& summary);
+    /** Discards stale levels when business levels are generated. */
     void buildBusinessSchedule();
+    /** Resolves the business level of a zero-based day, drawing generated levels as the day starts. */
+    BusinessLevel businessLevelForDay(int day);
+    /** Number of days the next run covers after the bounded-mode cap. */
+    int scheduledDays() const;
+    /** Hands a completed day to the sink and drops days beyond the retention bound. */
+    void publishDay(const DaySummary& summary, std::uint64_t logStart);
+    /** Stats a @ref PhaseTimer fills for a phase of the day; nullptr unless profiling. */
+    PhaseStats* phaseStats(DaySummary& summary, DayPhase phase) const;
     /** Schedules recurring maintenance tasks. */
     void scheduleMaintenance(DaySummary& summary);
     /** Runs all customers scheduled for a particular day. */
     void runCustomersForDay(int dayIndex, DaySummary& summary);
+    /** Runs maintenance, customers, and queries of a day as timed events. */
+    void runEventDay(int dayIndex, DaySummary& summary);
+    /** Number of customers (generated plus pending manual ones) due on a day; draws a count under arrival profiles. */
+    int customersDueToday(BusinessLevel level);
+    /** Number of manual customers not yet served. */
+    int manualCustomersRemaining() const;
+    /** Serves the next manual or generated customer. */
+    void serveNextCustomer(DaySummary& summary);
+    /** Builds the alias tables customers draw species and order sizes from. */
+    void buildDemandTables();
     /** Generates product requests for an order. */
     std::vector<ProductRequest> generateOrderRequests();
     /** Produces a random customer query command. */
     RequestCommand generateRandomQuery();
     /** Generates a random customer name. */
     std::string generateCustomerName();
+    /** Name given to the generated customer with the 1-based @p ordinal. */
+    std::string customerName(long long ordinal) const;
     /** Resolves number of customers for a business level. */
     int customersForLevel(BusinessLevel level) const;
     /** Creates a specific plant instance using database metadata. */
@@ -139,8 +503,11 @@ private:
     WaterLossStrategy* createWaterStrategy(WaterPreference preference);
     /** Instantiates sunlight strategy based on preference. */
     SunlightStrategy* createSunStrategy(SunlightPreference preference);
-    /** Records an event to the log. */
-    void log(const std::string& entry);
+    /** Records an event of day @p day to the log. */
+    void log(LogEvent type, int day, std::uint32_t subject = 0, std::int32_t value = 0, std::int32_t extra = 0,
+             std::uint32_t name = kNoName);
+    /** Formats one log record as text. */
+    std::string describe(const LogRecord& record) const;
     /** Converts business level to string. */
     std::string businessLevelToString(BusinessLevel level) const;
     /** Returns true when a mature plant of the given name exists. */
@@ -149,6 +516,10 @@ private:
     void cleanup();
     /** Clears all employees created for the simulation. */
     void clearEmployees();
+    /** Releases the front desk and staff but keeps the greenhouse. */
+    void releaseStaff();
+    /** Releases the greenhouse manager, composite tree, and shared inventory. */
+    void releaseGreenhouse();
     /** Recursively destroys a garden component tree. */
     void destroyGardenComponent(GardenComponent* component);
 
@@ -160,26 +531,96 @@ private:
     GardenSection* greenhouseRoot;
     /** Manager handling greenhouse sections and plants. */
     GreenHouseManager* greenhouseManager;
-    /** Number of days to simulate. */
+    /** Supply store shared by the cashier, builders, and products. */
+    Inventory* inventory;
+    /** Write-ahead journal for @ref inventory, when configured. */
+    InventoryJournal* inventoryJournal;
+    /** Low-stock notifications raised by @ref inventory. */
+    RestockQueue* restockQueue;
+    /** Requested number of days; bounded runs cover at most 30 of them. */
     int numDays;
+    /** Receives completed days in streaming mode; empty in bounded mode. */
+    DaySummarySink daySummarySink;
+    /** Completed days kept in memory while streaming. */
+    std::size_t retainedDays = 0;
+    /** Whether days run through the discrete-event engine. */
+    bool eventDriven = false;
+    /** Day shape used when @ref eventDriven is set. */
+    EventTiming eventTiming;
+    /** Clock for the event engine, not owned; nullptr uses the engine's virtual clock. */
+    SimulationClock* eventClock = nullptr;
+    /** Whether customers are drawn from @ref arrivalProfiles instead of fixed counts. */
+    bool profileArrivals = false;
+    /** Arrival profile selected by each business level. */
+    ArrivalProfile arrivalProfiles[3];
+    /** Whether days record @ref DaySummary::phases. */
+    bool phaseProfiling = false;
     /** Flag controlling automatic business schedule generation. */
     bool generateBusinessLevelsAutomatically = true;
-    /** Requested employee count. */
+    /** Requested employee count across every role. */
     int configuredEmployeeCount = 3;
-    /** Sequence of business levels per day. */
+    /** Requested cashiers. */
+    int configuredCashiers = 1;
+    /** Requested managers. */
+    int configuredManagers = 1;
+    /** Sections created before the greenhouse is stocked. */
+    std::vector<SectionLayout> sectionLayout;
+    /** Configured business levels per day; empty when levels are generated. */
     std::vector<BusinessLevel> businessSchedule;
     /** Plant configuration specifying quantities per name. */
     std::map<std::string, int> plantSelection;
+    /** Popularity of species and shape of orders. */
+    DemandProfile demand;
+    /** Selected species customers order, by @ref orderSpeciesTable index; keys of @ref plantSelection. */
+    std::vector<const std::string*> orderSpecies;
+    /** Draws an index into @ref orderSpecies by popularity. */
+    AliasTable orderSpeciesTable;
+    /** Care needs of the selected species listed in the catalog, asked about in advice queries. */
+    std::vector<AdviceCriteria> adviceTopics;
+    /** Draws an index into @ref adviceTopics by popularity. */
+    AliasTable adviceTopicTable;
+    /** Draws the number of products in an order, minus one. */
+    AliasTable productsPerOrderTable;
+    /** Draws the number of plants in a product, minus one. */
+    AliasTable plantsPerProductTable;
+    /** Supply stock placed in the inventory when a run starts. */
+    std::vector<SupplyLine> supplySelection;
+    /** Quantity at or below which a supply line is reordered; negative disables restocking. */
+    int restockLowWaterMark;
+    /** Units delivered per restock. */
+    int restockQuantity;
+    /** SKUs awaiting delivery at the start of the next day. */
+    std::vector<SkuId> pendingRestocks;
+    /** Journal path prefix; empty when journaling is disabled. */
+    std::string journalBasePath;
+    /** Mutations per journal group commit. */
+    std::size_t journalCommitBatch = 64;
     /** Random number generator. */
-    std::mt19937 rng;
+    SimulationRandom rng;
     /** Indicates whether RNG seed was explicitly set. */
     bool seedConfigured = false;
     /** Stored RNG seed when provided. */
     unsigned int configuredSeed = 0;
+    /** Indicates the greenhouse was restored from a snapshot and must be reused. */
+    bool greenhouseRestored = false;
     /** Accumulated summaries for each simulated day. */
     std::vector<DaySummary> dailySummaries;
-    /** Log entries capturing significant events. */
-    std::vector<std::string> eventLog;
+    /** Whether each day ends by publishing @ref dayEndView. */
+    bool dayEndViewsEnabled = false;
+    /** Destination of the staff's console messages, not owned. */
+    std::ostream* console;
+    /** Day-end view shared with reporting threads; accessed atomically. */
+    std::shared_ptr<const GreenhouseView> dayEndView;
+    /** Structured records of significant events. */
+    EventLog* eventLog;
+    /** Position in @ref eventLog where each retained day's entries begin, while streaming. */
+    std::vector<std::uint64_t> dayLogStarts;
+    /** Text of the log records in [@ref formattedBegin, @ref formattedEnd), filled by @ref getEventLog. */
+    mutable std::vector<std::string> formattedLog;
+    /** Position of the first record in @ref formattedLog. */
+    mutable std::uint64_t formattedBegin = 0;
+    /** Position one past the last record in @ref formattedLog. */
+    mutable std::uint64_t formattedEnd = 0;
     /** Available customer names for random generation. */
     std::vector<std::string> customerNamePool;
     /** Customers manually inserted into the simulation. */
@@ -188,6 +629,24 @@ private:
     std::size_t manualCustomerIndex = 0;
     /** Number of procedurally generated customers. */
     int generatedCustomerCount = 0;
+    /** Trace file rewritten after each run; empty when not recording. */
+    std::string tracePath;
+    /** Trace being recorded or replayed; owned. */
+    RunTrace* trace = nullptr;
+    /** Whether @ref trace is checked against rather than recorded into. */
+    bool replayingTrace = false;
+    /** Whether the event log is skipped during a replay. */
+    bool skipEventLog = false;
+    /** Manual customers created from a replayed trace; owned. */
+    std::vector<Customer*> tracedCustomers;
+    /** Checkpoint file written during runs; empty when not checkpointing. */
+    std::string checkpointPath;
+    /** Completed days between checkpoints. */
+    int checkpointInterval = 1;
+    /** Writer of the latest run's checkpoints; owned. */
+    SimulationCheckpoint* checkpointWriter = nullptr;
+    /** State restored by @ref resumeFromCheckpoint for the next run; owned. */
+    CheckpointState* resumeState = nullptr;
 };
 
 #endif
@@ -0,0 +1,70 @@
+/**
+ * @file snapshot.h
+ * @brief Declares the binary snapshot format used for fast greenhouse restarts.
+ *
+ * A snapshot captures the section tree, the condition of every plant, the
+ * inventory stock, and the simulation RNG state in one compact file. Restoring
+ * performs a single bulk read and rebuilds the composite from fixed-size
+ * records, so accumulated plant state survives a simulator restart.
+ */
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include <cstddef>
+#include <string>
+
+#include "randomStream.h"
+
+class GreenHouseManager;
+class Inventory;
+
+/**
+ * @brief Counts describing the contents of a saved or restored snapshot.
+ */
+struct SnapshotStats {
+    /** Number of sections, including the root. */
+    std::size_t sections = 0;
+    /** Number of plant records. */
+    std::size_t plants = 0;
+    /** Number of inventory stock lines. */
+    std::size_t inventoryItems = 0;
+    /** Size of the snapshot file in bytes. */
+    std::size_t bytes = 0;
+};
+
+/**
+ * @brief Saves and restores whole-greenhouse state in a compact binary file.
+ *
+ * Layout (host byte order, guarded by a byte-order marker): header, interned
+ * string table, section table (name id + parent index in pre-order), fixed
+ * 32-byte plant records, inventory lines in SKU id order, and the serialised
+ * RNG state.
+ */
+class GreenhouseSnapshot {
+  public:
+    /**
+     * @brief Writes the greenhouse, inventory, and RNG state to a file.
+     * @param path Destination file, overwritten when present.
+     * @param greenhouse Manager owning the section tree to capture.
+     * @param inventory Optional inventory whose stock lines are captured.
+     * @param rng Optional generator whose state is captured.
+     * @return Counts of captured records.
+     * @throws std::runtime_error When the file cannot be written.
+     */
+    static SnapshotStats save(const std::string& path, const GreenHouseManager& greenhouse,
+                              const Inventory* inventory, const SimulationRandom* rng);
+    /**
+     * @brief Rebuilds greenhouse state from a snapshot file.
+     * @param path Snapshot file produced by @ref save.
+     * @param greenhouse Manager with an empty root section to populate.
+     * @param inventory Optional inventory that receives the saved stock lines.
+     * @param rng Optional generator restored to the saved state.
+     * @return Counts of restored records.
+     * @throws std::runtime_error When the file is missing, truncated, or incompatible.
+     * @throws std::logic_error When the greenhouse root already has children.
+     */
+    static SnapshotStats restore(const std::string& path, GreenHouseManager& greenhouse,
+                                 Inventory* inventory, SimulationRandom* rng);
+};
+
+#endif
@@ -5,13 +5,36 @@
 // product_tests.cpp
 #define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
 #include "../headers/productBuilder.h"
+#include "../headers/arrivals.h"
+#include "../headers/batchRunner.h"
+#include "../headers/checkpoint.h"
 #include "../headers/garden.h"
 #include "../headers/plant.h"
 #include "../headers/doctest.h"
 #include "../headers/frontDesk.h"
+#include "../headers/greenhouseManager.h"
+#include "../headers/greenhouseView.h"
+#include "../headers/inventoryJournal.h"
+#include "../headers/iterator.h"
+#include "../headers/order.h"
+#include "../headers/plantDatabase.h"
+#include "../headers/plantStock.h"
+#include "../headers/restockQueue.h"
+#include "../headers/runTrace.h"
+#include "../headers/employee.h"
+#include "../headers/eventEngine.h"
+#include "../headers/eventLog.h"
+#include "../headers/simulator.h"
+#include "../headers/snapshot.h"
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <random>
+#include <sstream>
 #include <stdexcept>
 #include <cstdlib>
 #include <string>
+#include <thread>
 #include <vector>
 #include <memory>
 
@@ -174,3 +197,1449 @@ TEST_CASE("ProductBuilder creates correct Products using BasicBuilder and Bouque
     delete bouquet;
     delete greenhouse;
 }
+
+// Frees a composite tree built directly by a test.
+static void destroyTree(GardenComponent* component) {
+    if (!component->isLeaf()) {
+        for (GardenComponent* child : component->getChildren()) {
+            destroyTree(child);
+        }
+    }
+    delete component;
+}
+
+TEST_CASE("GreenhouseSnapshot round-trips sections, plant condition, and RNG state") {
+    const std::string path = "snapshot_roundtrip_test.bin";
+
+    GardenSection* root = new GardenSection();
+    GreenHouseManager greenhouse(root, "root");
+    GardenSection* herbs = greenhouse.addSection("herbs");
+    greenhouse.addSection("windowsill", "herbs");
+
+    Plant* basil = new Plant("basil", 12.5, new HighWaterLoss(), new HighSunlightStrategy(), new MatureState(nullptr));
+    basil->restoreCondition(0.42, 7, PlantLocation::OUTSIDE);
+    herbs->add(basil);
+    Plant* seedling = new Plant("mint", 9.0, new MedWaterLoss(), new LowSunlightStrategy(), new SeedlingState(nullptr));
+    greenhouse.getSection("windowsill")->add(seedling);
+    root->add(new Plant("cactus", 20.0, new LowWaterLoss(), new HighSunlightStrategy(), new DeadState(nullptr)));
+
+    SimulationRandom rng(1234);
+    rng.discard(17);
+    const SnapshotStats saved = GreenhouseSnapshot::save(path, greenhouse, nullptr, &rng);
+    CHECK(saved.sections == 3);
+    CHECK(saved.plants == 3);
+
+    GardenSection* restoredRoot = new GardenSection();
+    GreenHouseManager restored(restoredRoot, "root");
+    SimulationRandom restoredRng;
+    const SnapshotStats loaded = GreenhouseSnapshot::restore(path, restored, nullptr, &restoredRng);
+    std::remove(path.c_str());
+
+    CHECK(loaded.plants == 3);
+    CHECK(restoredRng() == rng());
+    REQUIRE(restored.getSection("windowsill") != nullptr);
+
+    Plant* restoredBasil = restored.find("basil");
+    REQUIRE(restoredBasil != nullptr);
+    CHECK(restoredBasil->getLifecycle() == PlantLifecycle::MATURE);
+    CHECK(restoredBasil->getWaterLevel() == doctest::Approx(0.42));
+    CHECK(restoredBasil->getAge() == 7);
+    CHECK(restoredBasil->getLocation() == PlantLocation::OUTSIDE);
+    CHECK(restoredBasil->getPrice() == doctest::Approx(12.5));
+    CHECK(restoredBasil->getWaterPreference() == WaterPreference::HIGH);
+    CHECK(restored.getSection("windowsill")->getChildren().size() == 1);
+    CHECK(restored.find("cactus")->isDead());
+    CHECK(restored.find("mint")->getLifecycle() == PlantLifecycle::SEEDLING);
+
+    // A lifecycle byte past the last stage is rejected instead of building a plant from it.
+    GardenSection* fernRoot = new GardenSection();
+    GreenHouseManager ferns(fernRoot, "root");
+    fernRoot->add(new Plant("fern", 5.0, new MedWaterLoss(), new LowSunlightStrategy(), new SeedlingState(nullptr)));
+    GreenhouseSnapshot::save(path, ferns, nullptr, nullptr);
+    {
+        // The lone plant record ends 8 bytes before the end; its lifecycle byte is the second-to-last field.
+        std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+        file.seekp(-10, std::ios::end);
+        file.put(static_cast<char>(0x7F));
+    }
+    GardenSection* corruptRoot = new GardenSection();
+    GreenHouseManager corrupt(corruptRoot, "root");
+    CHECK_THROWS_AS(GreenhouseSnapshot::restore(path, corrupt, nullptr, nullptr), std::runtime_error);
+    CHECK(corrupt.find("fern") == nullptr);
+    std::remove(path.c_str());
+
+    destroyTree(root);
+    destroyTree(restoredRoot);
+    destroyTree(fernRoot);
+    destroyTree(corruptRoot);
+}
+
+TEST_CASE("GreenHouseManager snapshots share unchanged sections and stay frozen") {
+    GardenSection* root = new GardenSection();
+    GreenHouseManager greenhouse(root, "root");
+    GardenSection* herbs = greenhouse.addSection("herbs");
+    GardenSection* succulents = greenhouse.addSection("succulents");
+    herbs->add(new Plant("basil", 10.0, new HighWaterLoss(), new HighSunlightStrategy(), new MatureState(nullptr)));
+    succulents->add(new Plant("cactus", 10.0, new LowWaterLoss(), new HighSunlightStrategy(), new MatureState(nullptr)));
+
+    std::shared_ptr<const GreenhouseView> first = greenhouse.snapshot(1);
+    CHECK(first->plantCount() == 2);
+
+    herbs->add(new Plant("mint", 8.0, new MedWaterLoss(), new MedSunlightStrategy(), new SeedlingState(nullptr)));
+    std::shared_ptr<const GreenhouseView> second = greenhouse.snapshot(2);
+
+    CHECK(first->plantCount() == 2);
+    CHECK(second->plantCount() == 3);
+    CHECK(second->stockBySection().at("herbs") == 2);
+    CHECK(first->stockBySection().at("herbs") == 1);
+
+    const auto& firstChildren = first->getRoot()->children;
+    const auto& secondChildren = second->getRoot()->children;
+    REQUIRE(firstChildren.size() == 2);
+    REQUIRE(secondChildren.size() == 2);
+    CHECK(firstChildren[0] != secondChildren[0]);
+    CHECK(firstChildren[1] == secondChildren[1]);
+    CHECK(greenhouse.snapshot(3)->getRoot() == second->getRoot());
+
+    std::vector<std::size_t> water = second->waterDistribution(2);
+    CHECK(water[1] == 3);
+
+    destroyTree(root);
+}
+
+TEST_CASE("Simulation publishes day-end views only when asked") {
+    Simulation quiet(2);
+    quiet.setRandomSeed(5);
+    quiet.configurePlantSelection({{"rose", 3}});
+    quiet.startSimulation();
+    CHECK(quiet.getDayEndView() == nullptr);
+
+    Simulation reporting(2);
+    reporting.setRandomSeed(5);
+    reporting.configurePlantSelection({{"rose", 3}});
+    reporting.publishDayEndViews(true);
+    reporting.startSimulation();
+    REQUIRE(reporting.getDayEndView() != nullptr);
+    CHECK(reporting.getDayEndView()->getDayIndex() == 2);
+}
+
+TEST_CASE("Simulation sends staff messages to its own console stream") {
+    std::ostringstream console;
+    Simulation simulation(2, console);
+    simulation.setRandomSeed(5);
+    simulation.configurePlantSelection({{"rose", 3}});
+    simulation.startSimulation();
+    CHECK(console.str().find("Cashier handling request") != std::string::npos);
+
+    std::ostream discard(nullptr);
+    Simulation quiet(2, discard);
+    quiet.setRandomSeed(5);
+    quiet.configurePlantSelection({{"rose", 3}});
+    quiet.startSimulation();
+    CHECK(quiet.getDailySummaries().back().customersServed == simulation.getDailySummaries().back().customersServed);
+}
+
+TEST_CASE("Inventory SKU table keeps string and id APIs consistent") {
+    Inventory inventory(nullptr);
+    CHECK(inventory.addStock(InventoryCategory::SOIL, "Basic Soil", 5));
+    CHECK(inventory.addStock(InventoryCategory::CONTAINER, "Basic Soil", 2));
+
+    const SkuId soil = inventory.findSku(InventoryCategory::SOIL, "Basic Soil");
+    const SkuId container = inventory.findSku(InventoryCategory::CONTAINER, "Basic Soil");
+    CHECK(soil == 0);
+    CHECK(container == 1);
+    CHECK(inventory.skuCount() == 2);
+    CHECK(inventory.skuCategory(container) == InventoryCategory::CONTAINER);
+    CHECK(inventory.findSku(InventoryCategory::CARD, "Basic Soil") == kInvalidSku);
+
+    CHECK(inventory.useItem(soil, 3));
+    CHECK(inventory.getQuantity(InventoryCategory::SOIL, "Basic Soil") == 2);
+    CHECK_FALSE(inventory.useItem(InventoryCategory::SOIL, "Basic Soil", 3));
+    CHECK(inventory.getQuantity(soil) == 2);
+    CHECK(inventory.getQuantity(InventoryCategory::CARD, "Missing") == -1);
+    CHECK_FALSE(inventory.useItem(kInvalidSku, 1));
+    CHECK(inventory.registerSku(InventoryCategory::SOIL, "Basic Soil") == soil);
+    CHECK_THROWS_AS(inventory.findSku(InventoryCategory::PLANT, "rose"), std::invalid_argument);
+}
+
+TEST_CASE("Builders and decorators deduct supplies from one shared Inventory") {
+    GardenComponent* greenhouse = new GardenSection();
+    Inventory supplies(greenhouse);
+    supplies.addStock(InventoryCategory::SOIL, "Basic Soil", 2);
+    supplies.addStock(InventoryCategory::CONTAINER, "Basic Container", 2);
+    supplies.addStock(InventoryCategory::CARD, "With love", 1);
+
+    std::vector<Plant*> plants = { new Plant("Aloe", 25.0, new LowWaterLoss(), new LowSunlightStrategy(), new SeedlingState(nullptr)) };
+    BasicBuilder builder(plants, greenhouse, &supplies);
+    Product* product = builder.getProduct();
+    CHECK(product->getInventory() == &supplies);
+    CHECK(supplies.getQuantity(InventoryCategory::SOIL, "Basic Soil") == 1);
+    CHECK(supplies.getQuantity(InventoryCategory::CONTAINER, "Basic Container") == 1);
+
+    Product* carded = new CardDecorator(product, "With love");
+    Product* wrapped = new WrappingPaperDecorator(carded, "Wrapping");
+    CHECK(wrapped->getInventory() == &supplies);
+    CHECK(supplies.getQuantity(InventoryCategory::CARD, "With love") == 0);
+    CHECK(supplies.getUnitsConsumed() == 3);
+    CHECK(supplies.getShortageCount() == 1); // no "Wrapping" stock line
+
+    delete wrapped;
+    delete greenhouse;
+}
+
+TEST_CASE("Concurrent Inventory never oversells a contended SKU") {
+    Inventory inventory(nullptr);
+    inventory.addStock(InventoryCategory::SOIL, "Basic Soil", 10000);
+    inventory.setConcurrent(true);
+    const SkuId soil = inventory.findSku(InventoryCategory::SOIL, "Basic Soil");
+    CHECK_THROWS_AS(inventory.registerSku(InventoryCategory::SOIL, "Premium Soil"), std::logic_error);
+    CHECK_FALSE(inventory.addStock(InventoryCategory::SOIL, "Premium Soil", 1));
+
+    std::vector<std::thread> cashiers;
+    for (int t = 0; t < 8; ++t) {
+        cashiers.emplace_back([&inventory, soil]() {
+            for (int i = 0; i < 2000; ++i) {
+                inventory.useItem(soil, 1);
+            }
+        });
+    }
+    for (std::thread& cashier : cashiers) {
+        cashier.join();
+    }
+
+    CHECK(inventory.getQuantity(soil) == 0);
+    CHECK(inventory.getUnitsConsumed() == 10000);
+    CHECK(inventory.getShortageCount() == 6000);
+}
+
+TEST_CASE("Supply reservations hold a whole order or nothing") {
+    Inventory inventory(nullptr);
+    inventory.addStock(InventoryCategory::SOIL, "Basic Soil", 3);
+    inventory.addStock(InventoryCategory::CONTAINER, "Basic Container", 1);
+
+    SupplyReservation reservation;
+    std::vector<SupplyLine> order = {{InventoryCategory::SOIL, "Basic Soil", 1},
+                                     {InventoryCategory::CONTAINER, "Basic Container", 1},
+                                     {InventoryCategory::SOIL, "Basic Soil", 1}};
+    REQUIRE(inventory.reserve(order, reservation));
+    CHECK(reservation.getHeld().size() == 2);
+    CHECK(inventory.getQuantity(InventoryCategory::SOIL, "Basic Soil") == 1);
+    CHECK(inventory.getUnitsConsumed() == 0);
+    inventory.release(reservation);
+    CHECK_FALSE(reservation.isActive());
+    CHECK(inventory.getQuantity(InventoryCategory::SOIL, "Basic Soil") == 3);
+
+    order.push_back(SupplyLine{InventoryCategory::CONTAINER, "Basic Container", 1});
+    CHECK_FALSE(inventory.reserve(order, reservation));
+    CHECK(inventory.getQuantity(InventoryCategory::SOIL, "Basic Soil") == 3);
+    CHECK(inventory.getQuantity(InventoryCategory::CONTAINER, "Basic Container") == 1);
+
+    order.pop_back();
+    REQUIRE(inventory.reserve(order, reservation));
+    inventory.commit(reservation);
+    CHECK(inventory.getUnitsConsumed() == 3);
+    {
+        SupplyReservation abandoned;
+        REQUIRE(inventory.reserve({{InventoryCategory::SOIL, "Basic Soil", 1}}, abandoned));
+        CHECK(inventory.getQuantity(InventoryCategory::SOIL, "Basic Soil") == 0);
+    }
+    CHECK(inventory.getQuantity(InventoryCategory::SOIL, "Basic Soil") == 1);
+}
+
+TEST_CASE("Orders are cancelled without deductions when supplies run short") {
+    GardenSection* greenhouse = new GardenSection();
+    Plant* aloe = new Plant("Aloe", 25.0, new LowWaterLoss(), new LowSunlightStrategy(), createPlantState(PlantLifecycle::MATURE));
+    greenhouse->add(aloe);
+    Inventory inventory(greenhouse);
+    inventory.addStock(InventoryCategory::SOIL, "Basic Soil", 1);
+    inventory.addStock(InventoryCategory::CONTAINER, "Basic Container", 1);
+    Cashier cashier;
+    cashier.setGreenhouse(greenhouse);
+    cashier.setInventory(&inventory);
+
+    ProductRequest wrapped;
+    wrapped.plantNames = {"Aloe"};
+    wrapped.wantsWrapping = true;
+    Order cancelled(&cashier, "Riley");
+    cancelled.addRequest(wrapped);
+    cancelled.finaliseOrder(greenhouse);
+    CHECK(cancelled.getStatus() == CANCELLED);
+    CHECK(cancelled.getProductCount() == 0);
+    CHECK(inventory.getQuantity(InventoryCategory::SOIL, "Basic Soil") == 1);
+    CHECK(greenhouse->getChildren().size() == 1);
+
+    ProductRequest plain;
+    plain.plantNames = {"Aloe"};
+    Order completed(&cashier, "Riley");
+    completed.addRequest(plain);
+    completed.finaliseOrder(greenhouse);
+    CHECK(completed.getStatus() == PROCESSING);
+    REQUIRE(completed.getProductCount() == 1);
+    CHECK(inventory.getQuantity(InventoryCategory::SOIL, "Basic Soil") == 0);
+    CHECK(inventory.getQuantity(InventoryCategory::CONTAINER, "Basic Container") == 0);
+    CHECK(inventory.getUnitsConsumed() == 2);
+
+    delete completed.getProduct();
+    destroyTree(greenhouse);
+}
+
+TEST_CASE("PLANT inventory reads per-species counters kept current by the greenhouse") {
+    GardenSection* root = new GardenSection();
+    GreenHouseManager greenhouse(root, "root");
+    GardenSection* beds = greenhouse.addSection("beds");
+    Plant* seedling = new Plant("rose", 12.0, new LowWaterLoss(), new LowSunlightStrategy(), createPlantState(PlantLifecycle::SEEDLING));
+    beds->add(seedling);
+    beds->add(new Plant("rose", 12.0, new LowWaterLoss(), new LowSunlightStrategy(), createPlantState(PlantLifecycle::MATURE)));
+    beds->add(new Plant("rose", 12.0, new LowWaterLoss(), new LowSunlightStrategy(), createPlantState(PlantLifecycle::MATURE)));
+    Inventory inventory(root);
+
+    CHECK(inventory.itemExists(InventoryCategory::PLANT, "rose"));
+    CHECK(inventory.getQuantity(InventoryCategory::PLANT, "rose") == 2);
+    CHECK(inventory.getQuantity(InventoryCategory::PLANT, "tulip") == -1);
+    CHECK_FALSE(inventory.addStock(InventoryCategory::PLANT, "rose", 1));
+
+    seedling->setState(createPlantState(PlantLifecycle::MATURE));
+    CHECK(greenhouse.countSellable("rose") == 3);
+    seedling->setState(createPlantState(PlantLifecycle::DEAD));
+    CHECK(greenhouse.getPlantStock().find("rose")->dead == 1);
+
+    CHECK_FALSE(inventory.useItem(InventoryCategory::PLANT, "rose", 3));
+    CHECK(inventory.useItem(InventoryCategory::PLANT, "rose", 2));
+    CHECK(inventory.getQuantity(InventoryCategory::PLANT, "rose") == 0);
+    CHECK(beds->getChildren().size() == 1);
+
+    root->remove(seedling);
+    CHECK(beds->getChildren().empty());
+    CHECK_FALSE(inventory.itemExists(InventoryCategory::PLANT, "rose"));
+    CHECK(greenhouse.getPlantStock().plantCount() == 0);
+
+    // Reads never build an index on a section no greenhouse has indexed.
+    GardenSection* loose = new GardenSection();
+    loose->add(new Plant("rose", 12.0, new LowWaterLoss(), new LowSunlightStrategy(), createPlantState(PlantLifecycle::MATURE)));
+    const Inventory unindexed(loose);
+    CHECK(unindexed.getQuantity(InventoryCategory::PLANT, "rose") == -1);
+    CHECK(loose->getStockIndex() == nullptr);
+
+    delete seedling;
+    destroyTree(root);
+    destroyTree(loose);
+}
+
+TEST_CASE("Inventory journal recovers stock from checkpoint plus replayed deltas") {
+    const std::string base = "inventory_journal_test";
+    std::remove((base + ".journal").c_str());
+    std::remove((base + ".checkpoint").c_str());
+    {
+        Inventory inventory(nullptr);
+        InventoryJournal journal(inventory, base, 4);
+        inventory.addStock(InventoryCategory::SOIL, "Basic Soil", 10);
+        inventory.addStock(InventoryCategory::CARD, "With love", 5);
+        journal.checkpoint();
+        CHECK(inventory.useItem(InventoryCategory::SOIL, "Basic Soil", 3));
+        inventory.addStock(InventoryCategory::WRAPPER, "Wrapping", 2);
+        SupplyReservation held;
+        REQUIRE(inventory.reserve({{InventoryCategory::CARD, "With love", 4}}, held));
+        CHECK(journal.getStats().commits == 1); // the checkpoint flushed the first two records
+    }
+    {
+        std::FILE* file = std::fopen((base + ".journal").c_str(), "ab");
+        std::fputs("torn", file);
+        std::fclose(file);
+    }
+    {
+        Inventory recovered(nullptr);
+        InventoryJournal journal(recovered, base, 4);
+        CHECK(journal.getStats().checkpointLines == 2);
+        CHECK(journal.getStats().replayedRecords == 2);
+        CHECK(recovered.getQuantity(InventoryCategory::SOIL, "Basic Soil") == 7);
+        CHECK(recovered.getQuantity(InventoryCategory::CARD, "With love") == 5);
+        CHECK(recovered.getQuantity(InventoryCategory::WRAPPER, "Wrapping") == 2);
+        recovered.useItem(InventoryCategory::WRAPPER, "Wrapping", 1);
+    }
+    Inventory again(nullptr);
+    InventoryJournal journal(again, base, 4);
+    CHECK(again.getQuantity(InventoryCategory::WRAPPER, "Wrapping") == 1);
+    CHECK_THROWS_AS(InventoryJournal(again, base, 4), std::logic_error);
+    std::remove((base + ".journal").c_str());
+    std::remove((base + ".checkpoint").c_str());
+
+    // Concurrent updates may journal a deduction before the addition it depended on.
+    {
+        Inventory inventory(nullptr);
+        InventoryJournal journal(inventory, base, 4);
+        inventory.addStock(InventoryCategory::SOIL, "Basic Soil", 2);
+        const SkuId soil = inventory.findSku(InventoryCategory::SOIL, "Basic Soil");
+        journal.recordDelta(soil, -5);
+        journal.recordDelta(soil, 5);
+    }
+    {
+        Inventory recovered(nullptr);
+        InventoryJournal journal(recovered, base, 4);
+        CHECK(journal.getStats().replayedRecords == 3);
+        CHECK(recovered.getQuantity(InventoryCategory::SOIL, "Basic Soil") == 2);
+        CHECK(recovered.getUnitsConsumed() == 0);
+        CHECK(recovered.getShortageCount() == 0);
+    }
+    std::remove((base + ".journal").c_str());
+}
+
+TEST_CASE("Inventory journal rejects corrupt checkpoints and supply categories") {
+    const std::string base = "inventory_journal_corrupt_test";
+    std::remove((base + ".journal").c_str());
+    std::remove((base + ".checkpoint").c_str());
+    {
+        Inventory inventory(nullptr);
+        InventoryJournal journal(inventory, base, 4);
+        inventory.addStock(InventoryCategory::SOIL, "Basic Soil", 10);
+        journal.checkpoint();
+    }
+    std::vector<char> image = readFileBytes(base + ".checkpoint");
+    image.back() ^= 0x01; // the last byte of the stored quantity
+    replaceFileDurably(base + ".checkpoint", image);
+    {
+        Inventory recovered(nullptr);
+        CHECK_THROWS_AS(InventoryJournal(recovered, base, 4), std::runtime_error);
+    }
+    std::remove((base + ".checkpoint").c_str());
+
+    // A frame with a valid checksum whose DEFINE_SKU names no supply category.
+    for (const std::uint8_t category : {std::uint8_t{0}, std::uint8_t{9}}) {
+        ByteWriter payload;
+        payload.put(std::uint8_t{1});
+        payload.put(std::int32_t{0});
+        payload.put(category);
+        payload.putString("Basic Soil");
+        ByteWriter file;
+        file.putBytes("GHJRNL01", 8);
+        file.put(kByteOrderMarker);
+        file.put(std::uint32_t{2});
+        file.put(std::uint64_t{0});
+        file.put(static_cast<std::uint32_t>(payload.size()));
+        file.put(frameChecksum(payload.bytes().data(), payload.size()));
+        file.putBytes(payload.bytes().data(), payload.size());
+        replaceFileDurably(base + ".journal", file.bytes());
+        Inventory recovered(nullptr);
+        CHECK_THROWS_AS(InventoryJournal(recovered, base, 4), std::runtime_error);
+    }
+    std::remove((base + ".journal").c_str());
+}
+
+TEST_CASE("Low-water marks queue one restock event per downward crossing") {
+    Inventory inventory(nullptr);
+    RestockQueue queue(2);
+    inventory.setRestockQueue(&queue);
+    inventory.addStock(InventoryCategory::WRAPPER, "Wrapping", 10);
+    inventory.addStock(InventoryCategory::SOIL, "Basic Soil", 10);
+    const SkuId wrapping = inventory.findSku(InventoryCategory::WRAPPER, "Wrapping");
+    CHECK(inventory.setLowWaterMark(InventoryCategory::WRAPPER, "Wrapping", 3));
+    CHECK_FALSE(inventory.setLowWaterMark(InventoryCategory::CARD, "With love", 3));
+    CHECK(inventory.getLowWaterMark(wrapping) == 3);
+
+    RestockEvent event;
+    CHECK(inventory.useItem(wrapping, 6));
+    CHECK_FALSE(queue.tryPop(event)); // 4 left, still above the mark
+    CHECK(inventory.useItem(wrapping, 2));
+    CHECK(inventory.useItem(wrapping, 1)); // already below, no second event
+    CHECK(inventory.useItem(InventoryCategory::SOIL, "Basic Soil", 10)); // unwatched
+    REQUIRE(queue.tryPop(event));
+    CHECK(event.sku == wrapping);
+    CHECK(event.quantity == 2);
+    CHECK(event.threshold == 3);
+    CHECK_FALSE(queue.tryPop(event));
+
+    inventory.addStock(wrapping, 10); // back above the mark re-arms the alert
+    // The soil line is short, so the wrapping hold that crossed the mark is rolled back without an event.
+    SupplyReservation rolledBack;
+    CHECK_FALSE(inventory.reserve({{InventoryCategory::WRAPPER, "Wrapping", 9},
+                                   {InventoryCategory::SOIL, "Basic Soil", 1}},
+                                  rolledBack));
+    CHECK(inventory.getQuantity(wrapping) == 11);
+    CHECK_FALSE(queue.tryPop(event));
+
+    SupplyReservation held;
+    REQUIRE(inventory.reserve({{InventoryCategory::WRAPPER, "Wrapping", 9}}, held));
+    CHECK_FALSE(queue.tryPop(event)); // a hold may still be released
+    inventory.commit(held);
+    REQUIRE(queue.tryPop(event));
+    CHECK(event.quantity == 2);
+
+    Simulation simulation(3);
+    simulation.setRandomSeed(7);
+    simulation.configurePlantSelection({{"cactus", 20}});
+    simulation.configureSupplies({{InventoryCategory::SOIL, "Basic Soil", 1},
+                                  {InventoryCategory::CONTAINER, "Basic Container", 1},
+                                  {InventoryCategory::CONTAINER, "Bouquet Container", 50},
+                                  {InventoryCategory::CARD, "With love", 50},
+                                  {InventoryCategory::WRAPPER, "Wrapping", 50}});
+    simulation.configureRestockPolicy(1, 30);
+    CHECK_THROWS_AS(simulation.configureRestockPolicy(1, 0), std::invalid_argument);
+    simulation.startSimulation();
+    // Soil and basic containers start at the mark, so they arrive on the first morning.
+    CHECK(simulation.getDailySummaries().front().restocksDelivered == 2);
+    const Inventory* supplies = simulation.getInventory();
+    CHECK(supplies->getQuantity(InventoryCategory::SOIL, "Basic Soil") > 1);
+    CHECK(simulation.getInventory()->getDroppedRestockEvents() == 0);
+}
+
+TEST_CASE("PlantDatabase loads a CSV catalog and falls back to the built-in table") {
+    const std::string path = "plant_catalog_test.csv";
+    {
+        std::FILE* file = std::fopen(path.c_str(), "wb");
+        std::fputs("name,section,sunlight,water\n"
+                   "# cultivars\n"
+                   "blue agave , succulent, HIGH, low\r\n"
+                   "\n"
+                   "fern,tropical,low,\n"
+                   "cactus,succulent,high,low", file);
+        std::fclose(file);
+    }
+    REQUIRE(PlantDatabase::isBuiltinCatalog());
+    CHECK(PlantDatabase::loadCatalog(path) == 3);
+    CHECK_FALSE(PlantDatabase::isBuiltinCatalog());
+    const auto& catalog = PlantDatabase::getAllPlants();
+    REQUIRE(catalog.count("blue agave") == 1);
+    CHECK(catalog.at("blue agave").section == "succulent");
+    CHECK(catalog.at("blue agave").sunlight == SunlightPreference::HIGH);
+    CHECK(catalog.at("fern").water == WaterPreference::UNKNOWN);
+    CHECK(catalog.count("rose") == 0);
+
+    {
+        std::FILE* file = std::fopen(path.c_str(), "wb");
+        std::fputs("rose,flowering,high,medium\nrose,flowering,high,medium\n", file);
+        std::fclose(file);
+    }
+    CHECK_THROWS_AS(PlantDatabase::loadCatalog(path), std::runtime_error);
+    {
+        std::FILE* file = std::fopen(path.c_str(), "wb");
+        std::fputs("rose,flowering,bright,medium\n", file);
+        std::fclose(file);
+    }
+    CHECK_THROWS_AS(PlantDatabase::loadCatalog(path), std::runtime_error);
+    CHECK(PlantDatabase::getAllPlants().count("fern") == 1); // failed loads keep the active catalog
+    CHECK_THROWS_AS(PlantDatabase::loadCatalog("missing_catalog.csv"), std::runtime_error);
+
+    PlantDatabase::useBuiltinCatalog();
+    CHECK(PlantDatabase::getAllPlants().count("rose") == 1);
+    std::remove(path.c_str());
+}
+
+TEST_CASE("Care index answers advice criteria with the same matches as a catalog scan") {
+    const SunlightPreference suns[] = {SunlightPreference::UNKNOWN, SunlightPreference::LOW,
+                                       SunlightPreference::MEDIUM, SunlightPreference::HIGH};
+    const WaterPreference waters[] = {WaterPreference::UNKNOWN, WaterPreference::LOW, WaterPreference::MEDIUM,
+                                      WaterPreference::HIGH};
+    for (SunlightPreference sun : suns) {
+        for (WaterPreference water : waters) {
+            std::vector<std::string> scanned;
+            for (const auto& entry : PlantDatabase::getAllPlants()) {
+                if ((sun == SunlightPreference::UNKNOWN || entry.second.sunlight == sun) &&
+                    (water == WaterPreference::UNKNOWN || entry.second.water == water)) {
+                    scanned.push_back(entry.first);
+                }
+            }
+            std::vector<std::string> indexed;
+            for (const char* name : PlantDatabase::findByCare(sun, water)) {
+                indexed.push_back(name);
+            }
+            CHECK(indexed == scanned);
+        }
+    }
+    CHECK(PlantDatabase::findByCare(SunlightPreference::UNKNOWN, WaterPreference::UNKNOWN).size() ==
+          PlantDatabase::getAllPlants().size());
+    CHECK(&PlantDatabase::findByCare(SunlightPreference::HIGH, WaterPreference::LOW) ==
+          &PlantDatabase::findByCare(SunlightPreference::HIGH, WaterPreference::LOW));
+
+    const std::string path = "care_index_test.csv";
+    {
+        std::FILE* file = std::fopen(path.c_str(), "wb");
+        std::fputs("fern,tropical,low,high\nmoss,tropical,,high\n", file);
+        std::fclose(file);
+    }
+    PlantDatabase::loadCatalog(path);
+    CHECK(PlantDatabase::findByCare(SunlightPreference::LOW, WaterPreference::HIGH).size() == 1);
+    CHECK(PlantDatabase::findByCare(SunlightPreference::UNKNOWN, WaterPreference::HIGH).size() == 2);
+    CHECK(PlantDatabase::findByCare(SunlightPreference::HIGH, WaterPreference::LOW).empty());
+    PlantDatabase::useBuiltinCatalog();
+    CHECK_FALSE(PlantDatabase::findByCare(SunlightPreference::HIGH, WaterPreference::LOW).empty());
+    std::remove(path.c_str());
+}
+
+TEST_CASE("Plant catalogs resolve every species by name through their hash tables") {
+    const BuiltinPlantCatalog builtin;
+    REQUIRE(builtin.size() == 20);
+    for (std::size_t i = 0; i < builtin.size(); ++i) {
+        const PlantRecord& record = builtin.record(i);
+        CHECK(builtin.find(record.name) == &record);
+        CHECK(builtin.asMap().at(record.name).section == record.section);
+        if (i > 0) {
+            CHECK(std::string(builtin.record(i - 1).name) < record.name);
+        }
+    }
+    CHECK(builtin.find("ros") == nullptr);
+    CHECK(builtin.find("") == nullptr);
+    CHECK_THROWS_AS(builtin.record(builtin.size()), std::out_of_range);
+
+    std::map<std::string, PlantInfo> species;
+    for (int i = 0; i < 500; ++i) {
+        species["cultivar " + std::to_string(i)] = PlantInfo{"herb", SunlightPreference::LOW, WaterPreference::HIGH};
+    }
+    PlantDatabase::useCatalog(std::unique_ptr<const PlantCatalog>(new RuntimePlantCatalog(species)));
+    CHECK_FALSE(PlantDatabase::isBuiltinCatalog());
+    for (int i = 0; i < 500; ++i) {
+        const PlantRecord* record = PlantDatabase::find("cultivar " + std::to_string(i));
+        REQUIRE(record != nullptr);
+        CHECK(std::string(record->section) == "herb");
+    }
+    CHECK(PlantDatabase::find("cactus") == nullptr);
+    CHECK(PlantDatabase::findByCare(SunlightPreference::LOW, WaterPreference::HIGH).size() == 500);
+    PlantDatabase::useBuiltinCatalog();
+    REQUIRE(PlantDatabase::find("cactus") != nullptr);
+    CHECK(PlantDatabase::find("cactus")->water == WaterPreference::LOW);
+}
+
+TEST_CASE("Trigram index ranks misspelt names and aliases") {
+    const std::vector<PlantMatch> monstera = PlantDatabase::searchByName("monstra");
+    REQUIRE_FALSE(monstera.empty());
+    CHECK(std::string(monstera.front().plant->name) == "monstera");
+    CHECK(monstera.front().score < 1.0);
+
+    const std::vector<PlantMatch> lily = PlantDatabase::searchByName("Peace Lilly!");
+    REQUIRE_FALSE(lily.empty());
+    CHECK(std::string(lily.front().plant->name) == "peace lily");
+
+    const std::vector<PlantMatch> alias = PlantDatabase::searchByName("devils ivy");
+    REQUIRE_FALSE(alias.empty());
+    CHECK(std::string(alias.front().plant->name) == "pothos");
+    CHECK(alias.front().term == "devil s ivy");
+    CHECK(PlantDatabase::searchByName("xyzzy").empty());
+    for (std::size_t i = 1; i < monstera.size(); ++i) {
+        CHECK(monstera[i - 1].score >= monstera[i].score);
+    }
+
+    GardenSection* root = new GardenSection();
+    GreenHouseManager greenhouse(root, "root");
+    Plant* plant = new Plant("monstera", 10.0, new LowWaterLoss(), new LowSunlightStrategy(), createPlantState(PlantLifecycle::MATURE));
+    greenhouse.addPlant(plant);
+    greenhouse.addPlant(new Plant("rose", 10.0, new LowWaterLoss(), new LowSunlightStrategy(), createPlantState(PlantLifecycle::MATURE)));
+    CHECK(greenhouse.findClosest("monstra") == plant);
+    CHECK(greenhouse.findClosest("swiss cheese plant") == plant);
+    CHECK(greenhouse.findClosest("rosemary") == nullptr); // listed species are never substituted
+    CHECK(greenhouse.find("monstra") == nullptr);
+    destroyTree(root);
+}
+
+TEST_CASE("Batch driver parses flags and reports a run as JSON and CSV") {
+    const char* argv[] = {"batch", "--days=2", "--seed", "11", "--schedule", "low, high", "--plants", "rose=3,basil=2",
+                          "--format=csv"};
+    const BatchConfig config = BatchConfig::fromArguments(9, const_cast<char**>(argv));
+    CHECK(config.days == 2);
+    CHECK(config.seeded);
+    CHECK(config.seed == 11u);
+    REQUIRE(config.schedule.size() == 2);
+    CHECK(config.schedule[1] == BusinessLevel::HIGH);
+    CHECK(config.plants.at("basil") == 2);
+    CHECK(config.format == "csv");
+    CHECK_FALSE(config.help);
+
+    const char* help[] = {"batch", "--days", "2", "--help", "--no-such-flag"};
+    CHECK(BatchConfig::fromArguments(5, const_cast<char**>(help)).help);
+    const char* shortHelp[] = {"batch", "-h"};
+    const BatchConfig shortConfig = BatchConfig::fromArguments(2, const_cast<char**>(shortHelp));
+    CHECK(shortConfig.help);
+    CHECK(shortConfig.scenarios.empty());
+
+    BatchConfig invalid;
+    CHECK_THROWS_AS(invalid.set("days", "0"), std::invalid_argument);
+    CHECK_THROWS_AS(invalid.set("seed", "12x"), std::invalid_argument);
+    CHECK_THROWS_AS(invalid.set("seed", "-1"), std::invalid_argument);
+    CHECK_THROWS_AS(invalid.set("seed", "18446744073709551616"), std::invalid_argument);
+    invalid.set("seed", "4294967296"); // 64-bit seeds are kept whole, not truncated to 0
+    CHECK(invalid.seed == 4294967296ull);
+    invalid.set("seed", "18446744073709551615");
+    CHECK(invalid.seed == 18446744073709551615ull);
+    CHECK_THROWS_AS(invalid.set("schedule", "busy"), std::invalid_argument);
+    CHECK_THROWS_AS(invalid.set("colour", "green"), std::invalid_argument);
+
+    const BatchRunner runner(config);
+    const BatchResult first = runner.run();
+    const BatchResult second = runner.run();
+    REQUIRE(first.days.size() == 2);
+    CHECK(first.days[0].businessLevel == BusinessLevel::LOW);
+    CHECK(first.days[1].customersServed == second.days[1].customersServed);
+    CHECK(first.runMs >= 0.0);
+
+    std::stringstream csv;
+    runner.writeReport(csv, first);
+    std::string header;
+    std::getline(csv, header);
+    CHECK(header.compare(0, 19, "day,business_level,") == 0);
+    std::string row;
+    std::getline(csv, row);
+    CHECK(row.compare(0, 6, "1,low,") == 0);
+
+    std::ostringstream json;
+    runner.writeJson(json, first);
+    CHECK(json.str().find("\"seed\": 11") != std::string::npos);
+    CHECK(json.str().find("\"businessLevel\": \"high\"") != std::string::npos);
+}
+
+TEST_CASE("Streamed simulations lift the day cap and retain a bounded window") {
+    Simulation bounded(45);
+    bounded.setRandomSeed(21);
+    bounded.configurePlantSelection({{"rose", 5}});
+    bounded.startSimulation();
+    REQUIRE(bounded.getDailySummaries().size() == 30);
+
+    Simulation streamed(45);
+    streamed.setRandomSeed(21);
+    streamed.configurePlantSelection({{"rose", 5}});
+    std::vector<DaySummary> received;
+    streamed.streamDaySummaries([&received](const DaySummary& day) { received.push_back(day); }, 5);
+    CHECK_THROWS_AS(streamed.streamDaySummaries([](const DaySummary&) {}, 0), std::invalid_argument);
+    streamed.startSimulation();
+
+    REQUIRE(received.size() == 45);
+    for (std::size_t i = 0; i < received.size(); ++i) {
+        CHECK(received[i].dayIndex == static_cast<int>(i) + 1);
+    }
+    // Streaming changes what is kept, not what happens: the first 30 days match the bounded run.
+    for (std::size_t i = 0; i < 30; ++i) {
+        CHECK(received[i].businessLevel == bounded.getDailySummaries()[i].businessLevel);
+        CHECK(received[i].customersServed == bounded.getDailySummaries()[i].customersServed);
+    }
+
+    const std::vector<DaySummary>& retained = streamed.getDailySummaries();
+    REQUIRE(retained.size() == 5);
+    CHECK(retained.front().dayIndex == 41);
+    CHECK(retained.back().dayIndex == 45);
+    const std::vector<std::string>& log = streamed.getEventLog();
+    REQUIRE_FALSE(log.empty());
+    CHECK(log.front().compare(0, 7, "Day 41 ") == 0);
+    CHECK(log.back() == "Day 45 completed.");
+}
+
+TEST_CASE("Monte Carlo runs are seeded per run and independent of the thread count") {
+    std::vector<double> samples = {5, 1, 4, 2, 3};
+    const Distribution spread = Distribution::of(samples);
+    CHECK(spread.mean == doctest::Approx(3.0));
+    CHECK(spread.stddev == doctest::Approx(1.5811).epsilon(0.001));
+    CHECK(spread.min == 1.0);
+    CHECK(spread.max == 5.0);
+    CHECK(spread.p50 == doctest::Approx(3.0));
+    CHECK(spread.p05 == doctest::Approx(1.2));
+    CHECK(spread.p95 == doctest::Approx(4.8));
+
+    BatchConfig scenario;
+    scenario.days = 4;
+    scenario.seeded = true;
+    scenario.seed = 500;
+    scenario.plants = {{"rose", 6}, {"basil", 4}};
+    scenario.runs = 12;
+    scenario.threads = 1;
+    const MonteCarloResult serial = MonteCarloRunner(scenario).run();
+    scenario.threads = 4;
+    const MonteCarloResult parallel = MonteCarloRunner(scenario).run();
+    CHECK(parallel.threads == 4u);
+
+    REQUIRE(serial.runs.size() == 12);
+    REQUIRE(parallel.runs.size() == 12);
+    CHECK(serial.seed == 500u);
+    CHECK(serial.firstStream == 0u);
+    for (std::size_t r = 0; r < serial.runs.size(); ++r) {
+        REQUIRE(serial.runs[r].size() == 4);
+        for (std::size_t d = 0; d < 4; ++d) {
+            CHECK(serial.runs[r][d].businessLevel == parallel.runs[r][d].businessLevel);
+            CHECK(serial.runs[r][d].customersServed == parallel.runs[r][d].customersServed);
+            CHECK(serial.runs[r][d].ordersCompleted == parallel.runs[r][d].ordersCompleted);
+        }
+    }
+    // A run on its own reproduces the same days as inside the batch.
+    BatchConfig single = scenario;
+    single.stream = 7;
+    single.runs = 1;
+    const BatchResult alone = BatchRunner(single).run();
+    REQUIRE(alone.days.size() == 4);
+    CHECK(alone.days[3].customersServed == serial.runs[7][3].customersServed);
+
+    REQUIRE(serial.days.size() == 4);
+    CHECK(serial.days[0].dayIndex == 1);
+    CHECK(serial.days[2].customersServed.mean == doctest::Approx(parallel.days[2].customersServed.mean));
+    CHECK(serial.days[2].customersServed.min <= serial.days[2].customersServed.p50);
+
+    BatchConfig invalid;
+    CHECK_THROWS_AS(invalid.set("runs", "0"), std::invalid_argument);
+    CHECK_THROWS_AS(invalid.set("threads", "-1"), std::invalid_argument);
+}
+
+TEST_CASE("Event engine orders events by time then scheduling order") {
+    EventEngine engine;
+    std::vector<std::uint32_t> seen;
+    engine.on(1, [&](const SimEvent& event) {
+        seen.push_back(event.payload);
+        if (event.payload == 0) {
+            engine.scheduleAfter(0.0, 1, 9); // same time, scheduled later: runs after the other ties
+        }
+    });
+    engine.schedule(5.0, 1, 2);
+    engine.schedule(1.0, 1, 0);
+    engine.schedule(1.0, 1, 1);
+    engine.schedule(8.0, 1, 3);
+    CHECK(engine.run(5.0) == 4);
+    CHECK(seen == std::vector<std::uint32_t>{0, 1, 9, 2});
+    CHECK(engine.now() == 5.0);
+    CHECK(engine.pending() == 1);
+    CHECK_THROWS_AS(engine.schedule(4.0, 1), std::invalid_argument);
+    engine.schedule(9.0, 7);
+    CHECK(engine.step());
+    CHECK_THROWS_AS(engine.run(), std::logic_error); // kind 7 has no handler
+    CHECK_THROWS_AS(PacedClock(0.0), std::invalid_argument);
+
+    // The event engine with day-loop timing replays the day loop exactly.
+    Simulation loop(6);
+    loop.setRandomSeed(33);
+    loop.configurePlantSelection({{"rose", 4}, {"mint", 4}});
+    loop.startSimulation();
+    Simulation events(6);
+    events.setRandomSeed(33);
+    events.configurePlantSelection({{"rose", 4}, {"mint", 4}});
+    events.useEventEngine(EventTiming::dayLoop());
+    events.startSimulation();
+    REQUIRE(events.getDailySummaries().size() == 6);
+    for (std::size_t d = 0; d < 6; ++d) {
+        const DaySummary& a = loop.getDailySummaries()[d];
+        const DaySummary& b = events.getDailySummaries()[d];
+        CHECK(a.businessLevel == b.businessLevel);
+        CHECK(a.customersServed == b.customersServed);
+        CHECK(a.ordersCompleted == b.ordersCompleted);
+        CHECK(a.queriesAnswered == b.queriesAnswered);
+        CHECK(a.maintenanceCommands == b.maintenanceCommands);
+        CHECK(b.meanWaitMinutes == 0.0); // everyone queues at opening but is served instantly
+    }
+
+    // A slow single desk makes customers queue.
+    EventTiming slow;
+    slow.meanServiceMinutes = 120.0;
+    Simulation queued(2);
+    queued.setRandomSeed(5);
+    queued.configureBusinessLevels({BusinessLevel::HIGH, BusinessLevel::HIGH});
+    queued.useEventEngine(slow);
+    queued.startSimulation();
+    CHECK(queued.getDailySummaries()[0].customersServed == 8);
+    CHECK(queued.getDailySummaries()[0].peakQueueLength > 0);
+    CHECK(queued.getDailySummaries()[0].meanWaitMinutes > 0.0);
+
+    EventTiming inverted;
+    inverted.openMinute = 600;
+    inverted.closeMinute = 500;
+    CHECK_THROWS_AS(queued.useEventEngine(inverted), std::invalid_argument);
+}
+
+TEST_CASE("Arrival profiles drive Poisson customer arrivals") {
+    const ArrivalProfile open = ArrivalProfile::uniform(30.0, 10, 12);
+    CHECK(open.expectedCustomers() == doctest::Approx(60.0));
+    CHECK(ArrivalProfile::typicalDay(5.0).expectedCustomers() == doctest::Approx(5.0));
+    CHECK(ArrivalProfile::typicalDay(5.0).customersPerHour[8] == 0.0);
+    CHECK_THROWS_AS(ArrivalProfile::uniform(1.0, 12, 10), std::invalid_argument);
+
+    SimulationRandom rng(17);
+    bool orderedWithinHours = true;
+    std::size_t arrivals = 0;
+    for (int day = 0; day < 200; ++day) {
+        ArrivalSampler sampler(open, day * 1440.0);
+        double minute = 0.0;
+        double previous = day * 1440.0;
+        while (sampler.next(rng, minute)) {
+            orderedWithinHours = orderedWithinHours && minute >= previous && minute >= day * 1440.0 + 600.0 &&
+                                 minute < day * 1440.0 + 720.0;
+            previous = minute;
+            ++arrivals;
+        }
+    }
+    CHECK(orderedWithinHours);
+    CHECK(arrivals / 200.0 == doctest::Approx(60.0).epsilon(0.05));
+    long long counted = 0;
+    for (int day = 0; day < 200; ++day) {
+        counted += ArrivalSampler::countDay(open, rng);
+    }
+    CHECK(counted / 200.0 == doctest::Approx(60.0).epsilon(0.05));
+    ArrivalSampler closed(ArrivalProfile(), 0.0);
+    double unused = 0.0;
+    CHECK_FALSE(closed.next(rng, unused));
+
+    Simulation busy(3);
+    busy.setRandomSeed(8);
+    busy.configureBusinessLevels({BusinessLevel::LOW, BusinessLevel::HIGH, BusinessLevel::HIGH});
+    busy.setArrivalProfile(BusinessLevel::HIGH, ArrivalProfile::uniform(20.0));
+    busy.setArrivalProfile(BusinessLevel::LOW, ArrivalProfile());
+    CHECK(busy.getArrivalProfile(BusinessLevel::MEDIUM).expectedCustomers() == doctest::Approx(5.0));
+    busy.startSimulation();
+    CHECK(busy.getDailySummaries()[0].customersServed == 0);
+    CHECK(busy.getDailySummaries()[1].customersServed > 100);
+    CHECK(busy.getDailySummaries()[1].customersServed < 220);
+
+    EventTiming timing;
+    timing.servers = 2;
+    busy.useEventEngine(timing);
+    busy.startSimulation();
+    CHECK(busy.getDailySummaries()[1].customersServed > 100);
+    CHECK(busy.getDailySummaries()[1].meanWaitMinutes > 0.0);
+}
+
+TEST_CASE("Event log keeps structured records and formats them only when read") {
+    CHECK_THROWS_AS(EventLog(0), std::invalid_argument);
+    EventLog ring(3);
+    REQUIRE(ring.capacity() == 3);
+    for (std::uint32_t day = 0; day < 5; ++day) {
+        LogRecord entry;
+        entry.type = LogEvent::DayCompleted;
+        entry.day = day;
+        ring.append(entry);
+    }
+    CHECK(ring.begin() == 2);
+    CHECK(ring.end() == 5);
+    CHECK(ring.overwritten() == 2);
+    LogRecord record;
+    CHECK_FALSE(ring.read(1, record));
+    REQUIRE(ring.read(2, record));
+    CHECK(record.day == 2);
+    ring.discardBefore(4);
+    CHECK(ring.begin() == 4);
+    CHECK_FALSE(ring.read(3, record));
+    CHECK(ring.intern("Basic Soil") == ring.intern("Basic Soil"));
+    CHECK(ring.name(ring.intern("Basic Soil")) == "Basic Soil");
+    CHECK_THROWS_AS(ring.name(99), std::out_of_range);
+    const std::string& soil = ring.name(ring.intern("Basic Soil"));
+    for (int i = 0; i < 100; ++i) { // spans several name segments
+        CHECK(ring.name(ring.intern("customer " + std::to_string(i))) == "customer " + std::to_string(i));
+    }
+    CHECK(&ring.name(ring.intern("Basic Soil")) == &soil); // names never move once interned
+
+    Customer visitor("Visitor", false);
+    Simulation simulation(3);
+    simulation.setRandomSeed(8);
+    simulation.configurePlantSelection({{"rose", 5}});
+    simulation.addCustomer(&visitor);
+    simulation.startSimulation();
+
+    const std::vector<std::string>& log = simulation.getEventLog();
+    REQUIRE(log.size() == simulation.getEventRecords().end());
+    CHECK(log.front() == "Simulation starting for 3 day(s).");
+    CHECK(log.back() == "Day 3 completed.");
+    CHECK(std::find(log.begin(), log.end(), "Advice request logged for Visitor") != log.end());
+    CHECK(std::find(log.begin(), log.end(), "Advice request logged for Alex #1") != log.end());
+    std::stringstream drained;
+    CHECK(simulation.writeEventLog(drained) == log.size());
+    std::string line;
+    std::getline(drained, line);
+    CHECK(line == log.front());
+
+    CHECK_THROWS_AS(simulation.setEventLogCapacity(0), std::invalid_argument);
+    simulation.setEventLogCapacity(3);
+    simulation.startSimulation();
+    const std::vector<std::string>& tail = simulation.getEventLog();
+    REQUIRE(tail.size() == 3);
+    CHECK(tail.back() == "Day 3 completed.");
+}
+
+TEST_CASE("Recorded runs replay bit for bit, also from parallel batches") {
+    const std::string path = "record_replay_test.trace";
+    Customer visitor("Visitor", true);
+    std::vector<DaySummary> recorded;
+    std::vector<std::string> recordedLog;
+    {
+        // Unseeded on purpose: the trace must capture the random_device seed.
+        Simulation original(6);
+        original.configurePlantSelection({{"rose", 4}, {"basil", 3}});
+        original.useArrivalProfiles(true);
+        original.addCustomer(&visitor);
+        original.recordTrace(path);
+        original.startSimulation();
+        recorded = original.getDailySummaries();
+        recordedLog = original.getEventLog();
+    }
+    REQUIRE(recorded.size() == 6);
+    const RunTrace trace = RunTrace::load(path);
+    CHECK(trace.days == 6);
+    CHECK(trace.dayDigests.size() == 6);
+    REQUIRE(trace.customers.size() == 1);
+    CHECK(trace.customers.front().name == "Visitor");
+
+    auto sameDays = [](const std::vector<DaySummary>& a, const std::vector<DaySummary>& b) {
+        if (a.size() != b.size()) {
+            return false;
+        }
+        for (std::size_t i = 0; i < a.size(); ++i) {
+            if (RunTrace::digest(a[i]) != RunTrace::digest(b[i])) {
+                return false;
+            }
+        }
+        return true;
+    };
+    Simulation replay;
+    replay.replayTrace(path);
+    replay.startSimulation();
+    CHECK(sameDays(replay.getDailySummaries(), recorded));
+    CHECK(replay.getEventLog() == recordedLog);
+
+    Simulation fastForward;
+    fastForward.replayTrace(path, true);
+    fastForward.startSimulation();
+    CHECK(sameDays(fastForward.getDailySummaries(), recorded));
+    CHECK(fastForward.getEventLog().empty());
+
+    RunTrace tampered = RunTrace::load(path);
+    tampered.dayDigests[3] ^= 1;
+    tampered.save(path);
+    Simulation diverging;
+    diverging.replayTrace(path);
+    CHECK_THROWS_WITH_AS(diverging.startSimulation(), "Replay diverged from the trace on day 4.", std::runtime_error);
+
+    BatchConfig scenario;
+    scenario.days = 5;
+    scenario.seeded = true;
+    scenario.seed = 90;
+    scenario.plants = {{"rose", 6}};
+    scenario.runs = 3;
+    scenario.threads = 3;
+    scenario.record = path;
+    const MonteCarloResult batch = MonteCarloRunner(scenario).run();
+    BatchConfig single;
+    single.replay = MonteCarloRunner::tracePathForRun(path, 2);
+    const BatchResult replayed = BatchRunner(single).run();
+    CHECK(sameDays(replayed.days, batch.runs[2]));
+    scenario.replay = single.replay;
+    CHECK_THROWS_AS(MonteCarloRunner{scenario}, std::invalid_argument);
+
+    CHECK_THROWS_AS(RunTrace::load("snapshot_roundtrip_test.missing"), std::runtime_error);
+    std::remove(path.c_str());
+    for (std::size_t run = 0; run < 3; ++run) {
+        std::remove(MonteCarloRunner::tracePathForRun(path, run).c_str());
+    }
+}
+
+TEST_CASE("Checkpointed runs resume to the same continuation") {
+    const std::string path = "resume_test.checkpoint";
+    auto configure = [](Simulation& simulation, int days) {
+        simulation.setNumDays(days);
+        simulation.setRandomSeed(2024);
+        simulation.configurePlantSelection({{"rose", 8}, {"basil", 5}, {"mint", 4}});
+        simulation.configureEmployees(5);
+    };
+    Simulation uninterrupted;
+    configure(uninterrupted, 12);
+    uninterrupted.startSimulation();
+    const std::vector<DaySummary> expected = uninterrupted.getDailySummaries();
+    REQUIRE(expected.size() == 12);
+
+    {
+        // Stands in for a run that crashed after day 7.
+        Simulation crashed;
+        configure(crashed, 7);
+        crashed.checkpointEvery(path);
+        crashed.startSimulation();
+        const CheckpointStats stats = crashed.getCheckpointStats();
+        CHECK(stats.fullFrames == 1);
+        CHECK(stats.deltaFrames == 6);
+        CHECK(stats.sectionsSkipped > 0);
+    }
+    // A frame torn by the crash is ignored.
+    std::FILE* torn = std::fopen(path.c_str(), "ab");
+    REQUIRE(torn != nullptr);
+    std::fputs("torn frame", torn);
+    std::fclose(torn);
+
+    Simulation resumed;
+    configure(resumed, 12);
+    CHECK(resumed.resumeFromCheckpoint(path) == 7);
+    CHECK(resumed.getDailySummaries().size() == 7);
+    resumed.checkpointEvery(path, 5);
+    resumed.startSimulation();
+    const std::vector<DaySummary>& continued = resumed.getDailySummaries();
+    REQUIRE(continued.size() == expected.size());
+    for (std::size_t i = 0; i < expected.size(); ++i) {
+        CHECK(RunTrace::digest(continued[i]) == RunTrace::digest(expected[i]));
+    }
+    CHECK(resumed.getCheckpointStats().fullFrames == 1);
+    CHECK(resumed.getCheckpointStats().deltaFrames == 0);
+
+    Simulation again;
+    configure(again, 12);
+    CHECK(again.resumeFromCheckpoint(path) == 10);
+    CHECK_THROWS_AS(again.checkpointEvery(path, 0), std::invalid_argument);
+    CHECK_THROWS_AS(again.resumeFromCheckpoint("resume_test.missing"), std::runtime_error);
+
+    // Deltas carry only sections whose contents changed.
+    GardenSection* root = new GardenSection();
+    GreenHouseManager greenhouse(root, "root");
+    GardenSection* herbs = greenhouse.addSection("herbs");
+    GardenSection* windowsill = greenhouse.addSection("windowsill", "herbs");
+    for (int i = 0; i < 300; ++i) {
+        herbs->add(new Plant("basil", 12.5, new HighWaterLoss(), new HighSunlightStrategy(), new MatureState(nullptr)));
+        windowsill->add(new Plant("mint", 9.0, new MedWaterLoss(), new LowSunlightStrategy(), new SeedlingState(nullptr)));
+    }
+    Inventory inventory(root);
+    inventory.addStock(InventoryCategory::SOIL, "Basic Soil", 40);
+    CheckpointState state;
+    state.day = 1;
+    SimulationCheckpoint writer(path);
+    writer.write(greenhouse, inventory, state, {});
+    const std::size_t fullBytes = writer.getStats().lastFrameBytes;
+
+    dynamic_cast<Plant*>(windowsill->getChild(0))->restoreCondition(0.25, 9, PlantLocation::OUTSIDE);
+    windowsill->markChanged();
+    herbs->markChanged();
+    state.day = 2;
+    writer.write(greenhouse, inventory, state, {});
+    CHECK(writer.getStats().deltaFrames == 1);
+    CHECK(writer.getStats().sectionsWritten == 4);
+    CHECK(writer.getStats().sectionsSkipped == 2);
+    CHECK(writer.getStats().lastFrameBytes < fullBytes * 2 / 3);
+
+    GardenSection* restoredRoot = new GardenSection();
+    GreenHouseManager restored(restoredRoot, "root");
+    Inventory restoredInventory(restoredRoot);
+    CHECK(SimulationCheckpoint::restore(path, restored, restoredInventory).day == 2);
+    REQUIRE(restored.getSection("windowsill") != nullptr);
+    CHECK(restored.getSection("herbs")->getChildren().size() == 301);
+    CHECK(restored.getSection("herbs")->getChildren().front() == restored.getSection("windowsill"));
+    const Plant* changed = dynamic_cast<Plant*>(restored.getSection("windowsill")->getChild(0));
+    REQUIRE(changed != nullptr);
+    CHECK(changed->getAge() == 9);
+    CHECK(changed->getLocation() == PlantLocation::OUTSIDE);
+    CHECK(restoredInventory.getQuantity(InventoryCategory::SOIL, "Basic Soil") == 40);
+    destroyTree(root);
+    destroyTree(restoredRoot);
+    std::remove(path.c_str());
+}
+
+TEST_CASE("Phase profiling times each phase and counts its work without changing the run") {
+    auto configure = [](Simulation& simulation, bool profiled) {
+        simulation.setNumDays(4);
+        simulation.setRandomSeed(77);
+        simulation.configurePlantSelection({{"rose", 6}, {"basil", 4}});
+        simulation.configureBusinessLevels({BusinessLevel::HIGH, BusinessLevel::LOW, BusinessLevel::MEDIUM,
+                                            BusinessLevel::HIGH});
+        simulation.profilePhases(profiled);
+    };
+    Simulation plain;
+    configure(plain, false);
+    plain.startSimulation();
+    Simulation profiled;
+    configure(profiled, true);
+    profiled.startSimulation();
+
+    const std::vector<DaySummary>& plainDays = plain.getDailySummaries();
+    const std::vector<DaySummary>& days = profiled.getDailySummaries();
+    REQUIRE(days.size() == plainDays.size());
+    for (std::size_t d = 0; d < days.size(); ++d) {
+        CHECK(RunTrace::digest(days[d]) == RunTrace::digest(plainDays[d]));
+        for (const PhaseStats& phase : plainDays[d].phases) {
+            CHECK(phase.elapsedMs == 0.0);
+            CHECK(phase.counters.allocations == 0);
+        }
+        const PhaseCounters& maintenance =
+            days[d].phases[static_cast<int>(DayPhase::MAINTENANCE_COMMANDS)].counters;
+        const PhaseCounters& requests = days[d].phases[static_cast<int>(DayPhase::CUSTOMER_COMMANDS)].counters;
+        CHECK(maintenance.commandsExecuted == days[d].maintenanceCommands);
+        CHECK(requests.commandsExecuted == days[d].queriesAnswered);
+        if (allocationCountingLinked) {
+            CHECK(days[d].phases[static_cast<int>(DayPhase::SCHEDULE_MAINTENANCE)].counters.allocations >=
+                  days[d].maintenanceCommands);
+            CHECK(days[d].phases[static_cast<int>(DayPhase::CUSTOMERS)].counters.allocations > 0);
+        }
+        for (const PhaseStats& phase : days[d].phases) {
+            CHECK(phase.elapsedMs >= 0.0);
+        }
+    }
+    // The root and each bed are maintained, so the 10 plants are watered and moved twice; the sweep visits each once.
+    CHECK(days[0].phases[static_cast<int>(DayPhase::MAINTENANCE_COMMANDS)].counters.plantsVisited == 40);
+    CHECK(days[0].phases[static_cast<int>(DayPhase::CLEAR_DEAD)].counters.plantsVisited == 10);
+
+    PhaseStats outer;
+    PhaseStats inner;
+    {
+        PhaseTimer outerTimer(&outer);
+        std::unique_ptr<int> first(new int(1));
+        {
+            PhaseTimer innerTimer(&inner);
+            std::unique_ptr<int> second(new int(2));
+            countPlantVisits(3);
+        }
+        countCommandExecuted();
+    }
+    // The test binary does not link the allocation hook, so allocations are only counted in bench and batch.
+    const long long expectedAllocations = allocationCountingLinked ? 1 : 0;
+    CHECK(outer.counters.allocations == expectedAllocations);
+    CHECK(outer.counters.commandsExecuted == 1);
+    CHECK(inner.counters.allocations == expectedAllocations);
+    CHECK(inner.counters.plantsVisited == 3);
+    CHECK(outer.counters.plantsVisited == 0);
+    CHECK(outer.elapsedMs >= inner.elapsedMs);
+    CHECK(std::string(dayPhaseName(DayPhase::CLEAR_DEAD)) == "clear_dead");
+
+    BatchConfig config;
+    config.set("days", "2");
+    config.set("seed", "5");
+    config.set("format", "csv");
+    config.set("profile_phases", "true");
+    std::ostringstream csv;
+    BatchRunner(config).stream(csv);
+    std::string header;
+    std::getline(std::istringstream(csv.str()), header);
+    CHECK(std::count(header.begin(), header.end(), ',') == 12 + 4 * kDayPhaseCount);
+    CHECK(header.find("customers_allocations") != std::string::npos);
+    config.set("format", "json");
+    std::ostringstream json;
+    BatchRunner(config).stream(json);
+    CHECK((json.str().find("\"allocations\": null") != std::string::npos) == !allocationCountingLinked);
+}
+
+TEST_CASE("Alias tables draw in proportion to their weights and drive weighted demand") {
+    const std::vector<double> weights = {5.0, 0.0, 1.0, 2.0, 0.5};
+    AliasTable table(weights);
+    REQUIRE(table.size() == weights.size());
+    SimulationRandom rng(99);
+    const int draws = 200000;
+    std::vector<int> counts(weights.size(), 0);
+    PhaseStats sampling;
+    {
+        PhaseTimer timer(&sampling);
+        for (int i = 0; i < draws; ++i) {
+            counts[table.sample(rng)]++;
+        }
+    }
+    CHECK(sampling.counters.allocations == 0);
+    CHECK(counts[1] == 0);
+    for (std::size_t i = 0; i < weights.size(); ++i) {
+        const double expected = draws * weights[i] / 8.5;
+        CHECK(std::abs(counts[i] - expected) <= 0.02 * draws);
+    }
+    CHECK(AliasTable({0.0, 3.0}).sample(rng) == 1);
+    CHECK_THROWS_AS(AliasTable({0.0, 0.0}), std::invalid_argument);
+    CHECK_THROWS_AS(AliasTable({1.0, -1.0}), std::invalid_argument);
+    CHECK_THROWS_AS(AliasTable(std::vector<double>()), std::invalid_argument);
+
+    DemandProfile demand;
+    demand.popularity["rose"] = 4.0;
+    demand.popularity["basil"] = 0.5;
+    demand.productsPerOrder = {0.0, 1.0};
+    CHECK(demand.weightOf("rose") == 4.0);
+    CHECK(demand.weightOf("mint") == 1.0);
+    Simulation rejected(1);
+    DemandProfile negative = demand;
+    negative.plantsPerProduct = {1.0, -2.0};
+    CHECK_THROWS_AS(rejected.configureDemand(negative), std::invalid_argument);
+    DemandProfile empty = demand;
+    empty.productsPerOrder.clear();
+    CHECK_THROWS_AS(rejected.configureDemand(empty), std::invalid_argument);
+    DemandProfile nobody;
+    nobody.popularity["rose"] = 0.0;
+    rejected.configurePlantSelection({{"rose", 2}});
+    rejected.configureDemand(nobody);
+    CHECK_THROWS_AS(rejected.startSimulation(), std::invalid_argument);
+
+    // The demand profile is part of the scenario a trace captures.
+    const std::string path = "alias_demand_test.trace";
+    std::vector<DaySummary> recorded;
+    {
+        Simulation original(5);
+        original.setRandomSeed(31);
+        original.configurePlantSelection({{"rose", 4}, {"basil", 3}, {"mint", 2}});
+        original.configureDemand(demand);
+        original.recordTrace(path);
+        original.startSimulation();
+        recorded = original.getDailySummaries();
+    }
+    CHECK(RunTrace::load(path).demand.popularity.at("rose") == 4.0);
+    Simulation replay;
+    replay.replayTrace(path);
+    replay.startSimulation();
+    CHECK(replay.getDemand().productsPerOrder == demand.productsPerOrder);
+    REQUIRE(replay.getDailySummaries().size() == recorded.size());
+    for (std::size_t d = 0; d < recorded.size(); ++d) {
+        CHECK(RunTrace::digest(replay.getDailySummaries()[d]) == RunTrace::digest(recorded[d]));
+    }
+    std::remove(path.c_str());
+}
+
+TEST_CASE("Random streams reproduce the reference generator and never share a sequence") {
+    // Reference outputs of xoshiro256** from the state {1, 2, 3, 4}.
+    Xoshiro256StarStar reference;
+    std::istringstream state("1 2 3 4");
+    state >> reference;
+    REQUIRE(state);
+    CHECK(reference() == 11520u);
+    CHECK(reference() == 0u);
+    CHECK(reference() == 1509978240u);
+    CHECK(reference() == 1215971899390074240u);
+    // Seeding expands through splitmix64, whose first output for 0 is known.
+    CHECK(generatorWords(Xoshiro256StarStar(0)).front() == 0xe220a8397b1dcdafull);
+    std::istringstream zero("0 0 0 0");
+    zero >> reference;
+    CHECK(zero.fail());
+
+    // Stream k is the seeded generator jumped k times, however it is reached.
+    Xoshiro256StarStar jumped(42);
+    jumped.jump();
+    jumped.jump();
+    Xoshiro256StarStar again(42);
+    again.jump();
+    CHECK(again != Xoshiro256StarStar(42));
+    again.jump();
+    CHECK(again == jumped);
+    again.longJump();
+    CHECK(again != jumped);
+    const std::vector<SimulationRandom> streams = randomStreams(42, 1, 4);
+    REQUIRE(streams.size() == 4);
+    CHECK(streams[1] == randomStream(42, 2));
+    CHECK(streams[3] == randomStream(42, 4));
+    CHECK(randomStream(42, 0) == SimulationRandom(42));
+    SimulationRandom first = streams[0];
+    SimulationRandom second = streams[1];
+    int equalDraws = 0;
+    for (int i = 0; i < 1000; ++i) {
+        equalDraws += first() == second() ? 1 : 0;
+    }
+    CHECK(equalDraws == 0);
+
+    // State survives the binary round trip used by traces and checkpoints.
+    SimulationRandom saved = streams[2];
+    saved.discard(17);
+    SimulationRandom restored = generatorFromWords<SimulationRandom>(generatorWords(saved));
+    CHECK(restored == saved);
+    CHECK(restored() == saved());
+    CHECK_THROWS_AS(generatorFromWords<SimulationRandom>(std::vector<std::uint64_t>{1, 2}), std::runtime_error);
+    std::vector<std::uint64_t> extra = generatorWords(saved);
+    extra.push_back(1);
+    CHECK_THROWS_AS(generatorFromWords<SimulationRandom>(extra), std::runtime_error);
+
+    // A simulation on a stream matches one given that stream's generator directly.
+    Simulation byIndex(3);
+    byIndex.setRandomStream(77, 5);
+    byIndex.configurePlantSelection({{"rose", 4}, {"basil", 3}});
+    byIndex.startSimulation();
+    Simulation byGenerator(3);
+    byGenerator.setRandomGenerator(randomStreams(77, 0, 6).back());
+    byGenerator.configurePlantSelection({{"rose", 4}, {"basil", 3}});
+    byGenerator.startSimulation();
+    REQUIRE(byIndex.getDailySummaries().size() == 3);
+    for (std::size_t d = 0; d < 3; ++d) {
+        CHECK(RunTrace::digest(byIndex.getDailySummaries()[d]) ==
+              RunTrace::digest(byGenerator.getDailySummaries()[d]));
+    }
+
+    BatchConfig config;
+    config.set("stream", "9");
+    CHECK(config.stream == 9u);
+    CHECK_THROWS_AS(config.set("stream", "-1"), std::invalid_argument);
+    CHECK_THROWS_AS(BatchRunner(config).run(), std::invalid_argument);
+}
+
+TEST_CASE("Scenario files configure staff, arrivals, and sections and can be swept") {
+    std::istringstream text("# spring weekend\n"
+                            "days = 3\n"
+                            "seed = 8\n"
+                            "[employees]\n"
+                            "cashiers = 2\n"
+                            "managers = 2\n"
+                            "caretakers = 3\n"
+                            "[plants]\n"
+                            "rose = 6\n"
+                            "basil = 4\n"
+                            "[popularity]\n"
+                            "rose = 3\n"
+                            "[arrivals]\n"
+                            "low = typical 12\n"
+                            "high = uniform 5 10 16\n"
+                            "[sections]\n"
+                            "; flowering species go under the glasshouse\n"
+                            "Glasshouse = root\n"
+                            "flowering = Glasshouse\n");
+    BatchConfig config;
+    config.load(text, "spring.ini");
+    CHECK(config.days == 3);
+    CHECK(config.seed == 8u);
+    CHECK(config.cashiers == 2);
+    CHECK(config.managers == 2);
+    CHECK(config.employees == 7);
+    CHECK(config.plants.at("rose") == 6);
+    CHECK(config.demand.popularity.at("rose") == 3.0);
+    CHECK(config.arrivals.at(BusinessLevel::LOW).expectedCustomers() == doctest::Approx(12.0));
+    CHECK(config.arrivals.at(BusinessLevel::HIGH).customersPerHour[10] == 5.0);
+    CHECK(config.arrivals.at(BusinessLevel::HIGH).customersPerHour[16] == 0.0);
+    REQUIRE(config.sections.size() == 2);
+    CHECK(config.sections[1].parent == "Glasshouse");
+
+    // Errors name the source and line.
+    BatchConfig broken;
+    std::istringstream badSection("days = 2\n[greenhouse]\n");
+    CHECK_THROWS_WITH_AS(broken.load(badSection, "bad.ini"), "bad.ini:2: unknown section [greenhouse]",
+                         std::invalid_argument);
+    std::istringstream badProfile("[arrivals]\nmedium = 1,2,3\n");
+    CHECK_THROWS_AS(broken.load(badProfile, "bad.ini"), std::invalid_argument);
+    std::istringstream badRole("[employees]\ngardeners = 2\n");
+    CHECK_THROWS_AS(broken.load(badRole, "bad.ini"), std::invalid_argument);
+    CHECK_THROWS_AS(broken.set("cashiers", "0"), std::invalid_argument);
+
+    // The layout nests catalog sections before plants are placed, and traces keep staff and layout.
+    const std::string tracePath = "scenario_test.trace";
+    {
+        Simulation simulation(2);
+        simulation.configureStaff(2, 2, 3);
+        simulation.configurePlantSelection({{"rose", 4}, {"basil", 2}});
+        simulation.configureSectionLayout({{"Glasshouse", "root"}, {"flowering", "Glasshouse"}});
+        simulation.recordTrace(tracePath);
+        simulation.startSimulation();
+        GreenHouseManager* manager = simulation.getGreenHouseManager();
+        REQUIRE(manager != nullptr);
+        // Root holds the glasshouse, created first, and the herb section created for basil.
+        const std::vector<GardenComponent*> top = manager->getRoot()->getChildren();
+        REQUIRE(top.size() == 2);
+        const std::vector<GardenComponent*> nested = top[0]->getChildren();
+        REQUIRE(nested.size() == 1);
+        CHECK_FALSE(nested[0]->isLeaf());
+        CHECK(manager->addSection("flowering", "Glasshouse") == nested[0]);
+    }
+    const RunTrace trace = RunTrace::load(tracePath);
+    CHECK(trace.cashiers == 2);
+    CHECK(trace.managers == 2);
+    CHECK(trace.employees == 7);
+    REQUIRE(trace.sections.size() == 2);
+    CHECK(trace.sections[1].name == "flowering");
+    std::remove(tracePath.c_str());
+    Simulation rejected(1);
+    CHECK_THROWS_AS(rejected.configureStaff(1, 0, 2), std::invalid_argument);
+    CHECK_THROWS_AS(rejected.configureSectionLayout({{"beds", "missing"}}), std::invalid_argument);
+    CHECK_THROWS_AS(rejected.configureSectionLayout({{"beds", "root"}, {"beds", "root"}}), std::invalid_argument);
+
+    // A sweep runs every file over the base settings, reports failures per file, and matches single runs.
+    const std::vector<std::string> paths = {"sweep_a.ini", "sweep_b.ini", "sweep_bad.ini"};
+    {
+        std::ofstream a(paths[0]);
+        a << text.str();
+        std::ofstream b(paths[1]);
+        b << "[plants]\nbasil = 5\n";
+        std::ofstream bad(paths[2]);
+        bad << "days = zero\n";
+    }
+    BatchConfig base;
+    base.set("days", "4");
+    base.set("seed", "3");
+    base.set("threads", "2");
+    const SweepResult sweep = ScenarioSweep(base, paths).run();
+    REQUIRE(sweep.scenarios.size() == 3);
+    CHECK(sweep.failed == 1);
+    CHECK(sweep.scenarios[0].error.empty());
+    CHECK(sweep.scenarios[0].result.daysRun == 3);
+    CHECK(sweep.scenarios[1].result.daysRun == 4);
+    CHECK(sweep.scenarios[2].error.find("sweep_bad.ini:1:") == 0);
+    BatchConfig alone = base;
+    alone.loadFile(paths[0]);
+    CHECK(BatchRunner(alone).run().totals.customersServed == sweep.scenarios[0].result.totals.customersServed);
+    std::ostringstream csv;
+    ScenarioSweep(base, paths).writeCsv(csv, sweep);
+    CHECK(csv.str().find("sweep_b.ini,4,") != std::string::npos);
+    for (const std::string& path : paths) {
+        std::remove(path.c_str());
+    }
+}